@@ -0,0 +1,98 @@
+// Uploading LED mappings to the walls. A mapping is a blob generated by
+// zorg/tools/generate_led_mapping.py --blob, see
+// zorg/include/wall/mapping_blob.h. It is sent in chunks, since each message
+// is forwarded to the wall in one ESP-NOW packet.
+
+// Must match UploadMappingChunkCommand::kMaxChunkSize.
+const kMaxChunkSize = 64;
+
+// Must match MappingUploadStatus::State.
+const kAccepted = 0;
+const kOutOfOrder = 1;
+const kComplete = 2;
+const kFailed = 3;
+
+// Time to wait for the wall to answer a chunk before sending it again. Writing
+// a chunk can take a flash sector erase.
+const kChunkTimeoutMillis = 2000;
+// Chunks sent in a row without the upload moving forward before giving up.
+const kMaxAttempts = 5;
+
+// Returns the params of the uploadMappingChunk message sending the chunk of
+// the blob at offset.
+function mappingChunk(blob, offset) {
+  const data = Array.from(blob.subarray(offset, offset + kMaxChunkSize))
+    .map((byte) => byte.toString(16).padStart(2, '0'))
+    .join('');
+  return { 'offset': offset, 'totalSize': blob.length, 'data': data };
+}
+
+// Uploads a blob to a wall, one chunk at a time. The wall answers every chunk
+// with a mappingUploadStatus message, forwarded by the master, see onStatus().
+// The next chunk is sent from the offset the wall expects, so chunks that were
+// lost or dropped are sent again.
+export class MappingUpload {
+  // sendChunk(params) sends an uploadMappingChunk message,
+  // onProgress(fraction) is called as the wall accepts chunks.
+  constructor(blob, sendChunk, onProgress) {
+    this.blob = blob;
+    this.sendChunk = sendChunk;
+    this.onProgress = onProgress;
+    // Resolves the wait for the status of the chunk last sent.
+    this.resolveStatus = null;
+    this.pendingOffset = -1;
+  }
+
+  // Called with the params of the mappingUploadStatus messages of the wall.
+  onStatus(params) {
+    // Late answers to chunks sent before are ignored.
+    if (params.offset !== this.pendingOffset || !this.resolveStatus) return;
+    this.resolveStatus(params);
+    this.resolveStatus = null;
+  }
+
+  // Sends the chunk at offset, and returns the wall's status, or null if it
+  // didn't answer in time.
+  async sendChunkAndWait(offset) {
+    this.pendingOffset = offset;
+    const status = new Promise((resolve) => {
+      this.resolveStatus = resolve;
+      setTimeout(() => resolve(null), kChunkTimeoutMillis);
+    });
+    await this.sendChunk(mappingChunk(this.blob, offset));
+    return await status;
+  }
+
+  // Uploads the blob. Throws an Error saying why if the upload failed.
+  async run() {
+    let offset = 0;
+    let attempts = 0;
+    for (;;) {
+      const status = await this.sendChunkAndWait(offset);
+      if (status === null) {
+        if (++attempts >= kMaxAttempts) {
+          throw new Error(`no answer from the wall at offset ${offset}`);
+        }
+        continue;
+      }
+      switch (status.state) {
+        case kComplete:
+          this.onProgress(1);
+          return;
+        case kFailed:
+          throw new Error(`the wall dropped the upload at offset ${offset}`);
+        case kAccepted:
+        case kOutOfOrder:
+          break;
+      }
+      if (status.nextOffset > offset) {
+        attempts = 0;
+      } else if (++attempts >= kMaxAttempts) {
+        throw new Error(
+          `the wall keeps dropping the chunk at offset ${offset}`);
+      }
+      offset = status.nextOffset;
+      this.onProgress(offset / this.blob.length);
+    }
+  }
+}
@@ -0,0 +1,66 @@
+// Assembler for the wall pattern programs, see zorg/include/wall/program.h.
+//
+// A program has one instruction per line, `name = op arg [arg]`, where the
+// arguments are inputs (x, y, angle, radius, t, speed), names defined on
+// earlier lines, or numbers from 0 to 255. The intensity of each LED is the
+// value of the last line. Anything after a # is a comment. For example, the
+// spiral pattern, sin8(2 * radius + 4 * angle - t), is:
+//
+//   r = mul radius 2
+//   a = mul angle 4
+//   phase = add r a
+//   wave = sub phase t
+//   out = sin8 wave
+
+const kVersion = 1;
+const kMaxInstructions = 16;
+const kInputs = ['x', 'y', 'angle', 'radius', 't', 'speed'];
+const kConstOp = 0;
+const kOps = {
+  add: 1, sub: 2, mul: 3, scale8: 4, qadd8: 5, qsub8: 6, sin8: 7, cos8: 8,
+};
+const kUnaryOps = new Set(['sin8', 'cos8']);
+
+// Assembles the program, and returns its bytecode as a hex string. Throws an
+// Error if the program is invalid.
+export function assembleProgram(source) {
+  const registers = new Map(kInputs.map((name, i) => [name, i]));
+  const instructions = [];
+  const emit = (op, a, b) => {
+    instructions.push([op, a, b]);
+    return kInputs.length + instructions.length - 1;
+  };
+
+  source.split('\n').forEach((line, index) => {
+    const error = (message) => new Error(`Line ${index + 1}: ${message}`);
+    line = line.replace(/#.*/, '').trim();
+    if (line === '') return;
+    const match = line.match(/^(\w+)\s*=\s*(\w+)\s+(\w+)(?:\s+(\w+))?$/);
+    if (!match) throw error('expected "name = op arg [arg]"');
+    const [, name, op, ...args] = match;
+    if (!(op in kOps)) throw error(`unknown op ${op}`);
+    const numArgs = kUnaryOps.has(op) ? 1 : 2;
+    if (args.filter((arg) => arg !== undefined).length !== numArgs) {
+      throw error(`${op} takes ${numArgs} argument(s)`);
+    }
+    if (registers.has(name)) throw error(`${name} is already defined`);
+    const operands = args.slice(0, numArgs).map((arg) => {
+      if (registers.has(arg)) return registers.get(arg);
+      if (!/^\d+$/.test(arg) || Number(arg) > 255) {
+        throw error(`${arg} is not defined, or not a number from 0 to 255`);
+      }
+      return emit(kConstOp, Number(arg), 0);
+    });
+    registers.set(name, emit(kOps[op], operands[0], operands[1] ?? 0));
+  });
+
+  if (instructions.length === 0) throw new Error('The program is empty.');
+  if (instructions.length > kMaxInstructions) {
+    throw new Error(
+      `The program has ${instructions.length} instructions, including ` +
+      `constants, the maximum is ${kMaxInstructions}.`);
+  }
+  return [kVersion, ...instructions.flat()]
+    .map((byte) => byte.toString(16).padStart(2, '0'))
+    .join('');
+}
@@ -1,5 +1,7 @@
 import './Tone.js';
 import { SerialHandler } from './serial.js';
+import { assembleProgram } from './program.js';
+import { MappingUpload } from './mapping.js';
 import { AmbientSound } from './sound/ambient.js';
 import { PressedSound } from './sound/pressed.js';
 import { GlitchSound } from './sound/glitch.js';
@@ -10,6 +12,8 @@ class CubeApp {
   numWalls = 4;
 
   serialHandler = new SerialHandler();
+  // The mapping upload running on each wall, if any.
+  mappingUploads = [];
   connectButton = document.getElementById('connect-button');
 
   masterStatusIndicator = document.getElementById('master-status');
@@ -45,6 +49,10 @@ class CubeApp {
       document.getElementById(`restart-wall${i}-button`)
         .addEventListener('pointerdown', () => this.sendRestartWallMessage(i));
       document.getElementById(`set-threshold-wall${i}`).addEventListener('pointerdown', () => this.sendSetTouchThresholdMessage(i));
+      document.getElementById(`set-variant-wall${i}`)
+        .addEventListener('pointerdown', () => this.sendSetWallVariantMessage(i));
+      document.getElementById(`upload-mapping-wall${i}`)
+        .addEventListener('pointerdown', () => this.sendUploadMappingMessages(i));
       this.setWallStatus(i, { lastDeliveryStatus: "unknown" });
     }
     this.connectButton.addEventListener('pointerdown', this.connect);
@@ -60,6 +68,10 @@ class CubeApp {
       .addEventListener('pointerdown', () => this.sendSetCubeModeMessage('manBurn'));
     document.getElementById('set-temple-burn')
       .addEventListener('pointerdown', () => this.sendSetCubeModeMessage('templeBurn'));
+    document.getElementById('set-program')
+      .addEventListener('pointerdown', () => this.sendSetCubeModeMessage('program'));
+    document.getElementById('upload-program')
+      .addEventListener('pointerdown', this.sendUploadProgramMessage);
 
     this.serialHandler.messageCallback = this.onMessage;
 
@@ -173,6 +185,9 @@ class CubeApp {
       case 'updateStatus':
         this.updateStatus(msg.params);
         break;
+      case 'mappingUploadStatus':
+        this.mappingUploads[msg.params.wallId]?.onStatus(msg.params);
+        break;
       default:
         console.error('unknown method: ', msg.method);
     }
@@ -233,10 +248,55 @@ class CubeApp {
       'setTouchThreshold', { 'wallId': wallId, 'touchThreshold': touchThreshold });
   }
 
+  sendSetWallVariantMessage = async (wallId) => {
+    const wallVariant = document.getElementById(`variant-wall${wallId}-input`).value;
+    await this.serialHandler.send(
+      'setWallVariant', { 'wallId': wallId, 'wallVariant': wallVariant });
+  }
+
   sendSetCubeModeMessage = async (cubeMode) => {
     await this.serialHandler.send('setCubeMode', { 'cubeMode': cubeMode });
   }
 
+  sendUploadProgramMessage = async () => {
+    const errorIndicator = document.getElementById('program-error');
+    let program;
+    try {
+      program = assembleProgram(document.getElementById('program-source').value);
+    } catch (error) {
+      errorIndicator.textContent = error.message;
+      return;
+    }
+    errorIndicator.textContent = '';
+    await this.serialHandler.send('uploadProgram', { 'program': program });
+  }
+
+  sendUploadMappingMessages = async (wallId) => {
+    const file = document.getElementById(`mapping-wall${wallId}-input`).files[0];
+    const progress = document.getElementById(`mapping-wall${wallId}-progress`);
+    if (!file) {
+      progress.textContent = 'Choose a mapping file first.';
+      return;
+    }
+    if (this.mappingUploads[wallId]) {
+      progress.textContent = 'An upload is already running.';
+      return;
+    }
+    const upload = new MappingUpload(
+      new Uint8Array(await file.arrayBuffer()),
+      (chunk) => this.serialHandler.send('uploadMappingChunk', { 'wallId': wallId, ...chunk }),
+      (fraction) => progress.textContent = `${Math.round(100 * fraction)}%`);
+    this.mappingUploads[wallId] = upload;
+    try {
+      await upload.run();
+      progress.textContent = 'Done, the wall restarts.';
+    } catch (error) {
+      progress.textContent = `Upload failed: ${error.message}.`;
+    } finally {
+      this.mappingUploads[wallId] = null;
+    }
+  }
+
   sendSetLedsEnabledMessage = async (enabled) => {
     await this.serialHandler.send('setLedsEnabled', { 'enabled': enabled });
     this.ledsEnabled = enabled;
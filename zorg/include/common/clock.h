@@ -0,0 +1,51 @@
+#ifndef INCLUDE_COMMON_CLOCK_H_
+#define INCLUDE_COMMON_CLOCK_H_
+
+#include <cstdint>
+
+// Where the firmwares and the animation library get the time from, instead of
+// calling millis(). Code is given a clock, so that host builds can give it a
+// VirtualClock and play hours of the installation in seconds, with the same
+// frames on every run.
+class Clock {
+ public:
+  virtual ~Clock() = default;
+
+  // Time since the clock started, in microseconds. Never wraps around.
+  virtual uint64_t NowMicros() const = 0;
+
+  uint64_t NowMillis() const { return NowMicros() / 1000; }
+};
+
+// The time since the MCU booted, or since some arbitrary point on the host.
+class SystemClock final : public Clock {
+ public:
+  uint64_t NowMicros() const override;
+};
+
+// The system clock, for code that isn't given another clock.
+const Clock& DefaultClock();
+
+// A clock that only moves when told to, by a fixed step at a time: typically
+// one frame per step.
+class VirtualClock final : public Clock {
+ public:
+  explicit VirtualClock(uint64_t step_micros, uint64_t start_micros = 0)
+      : step_micros_(step_micros), now_micros_(start_micros) {}
+
+  uint64_t NowMicros() const override { return now_micros_; }
+
+  // Moves the clock forward by one step.
+  void Step() { now_micros_ += step_micros_; }
+
+  // Moves the clock forward by the given time.
+  void Advance(uint64_t micros) { now_micros_ += micros; }
+
+  uint64_t step_micros() const { return step_micros_; }
+
+ private:
+  uint64_t step_micros_;
+  uint64_t now_micros_;
+};
+
+#endif  // INCLUDE_COMMON_CLOCK_H_
@@ -3,6 +3,10 @@
 
 #include <ArduinoJson.hpp>
 #include <cstdint>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 // Top level keys for the JSON messages.
 inline constexpr char kMethod[] = "method";
@@ -15,11 +19,17 @@ inline constexpr char kRestartMethod[] = "restart";
 inline constexpr char kSetTouchThresholdMethod[] = "setTouchThreshold";
 inline constexpr char kTouchThresholdParam[] = "touchThreshold";
 
+// Sets which wall a wall controller drives, by the name of its LED Mapper
+// export, e.g. "actual_wall_flipped". The wall restarts to use it.
+inline constexpr char kSetWallVariantMethod[] = "setWallVariant";
+inline constexpr char kWallVariantParam[] = "wallVariant";
+
 inline constexpr char kSetCubeModeMethod[] = "setCubeMode";
 inline constexpr char kCubeModeParam[] = "cubeMode";
 inline constexpr char kNormalMode[] = "normal";
 inline constexpr char kManBurnMode[] = "manBurn";
 inline constexpr char kTempleBurnMode[] = "templeBurn";
+inline constexpr char kProgramMode[] = "program";
 
 inline constexpr char kSetHandStateMethod[] = "setHandState";
 inline constexpr char kHandStateParam[] = "handState";
@@ -60,9 +70,48 @@ enum PatternId : uint8_t {
   kRecovery,
   kManBurn,
   kTempleBurn,
+  // Plays the program uploaded with UploadProgramCommand.
+  kProgram,
+  // Patterns spreading over the LED neighbor graph.
+  kDiffusion,
+  kRipple,
+  // Particle patterns.
+  kSparks,
+  kEmbers,
+  kSwarm,
   kNumPatternIds,
 };
 
+// Binary payloads are sent as hex strings.
+inline std::string BytesToHex(const std::vector<uint8_t>& bytes) {
+  static constexpr char kDigits[] = "0123456789abcdef";
+  std::string hex;
+  hex.reserve(2 * bytes.size());
+  for (uint8_t byte : bytes) {
+    hex.push_back(kDigits[byte >> 4]);
+    hex.push_back(kDigits[byte & 0xf]);
+  }
+  return hex;
+}
+
+// Returns the bytes encoded in hex, or nothing if it isn't valid hex.
+inline std::optional<std::vector<uint8_t>> HexToBytes(const char* hex) {
+  auto digit = [](char c) -> int {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+  };
+  std::vector<uint8_t> bytes;
+  for (; hex[0] != '\0'; hex += 2) {
+    int high = digit(hex[0]);
+    int low = high < 0 ? -1 : digit(hex[1]);
+    if (low < 0) return std::nullopt;
+    bytes.push_back(high << 4 | low);
+  }
+  return bytes;
+}
+
 struct SetPatternCommand {
   static constexpr char kMethodName[] = "setPattern";
 
@@ -90,4 +139,296 @@ struct SetPatternCommand {
   int transition_duration_millis;
 };
 
+// Uploads a pattern program (see wall/program.h) to a wall, which plays it as
+// PatternId::kProgram. The program is validated by the wall.
+struct UploadProgramCommand {
+  static constexpr char kMethodName[] = "uploadProgram";
+
+  static UploadProgramCommand FromJsonCommand(
+      const ArduinoJson::JsonDocument& doc) {
+    UploadProgramCommand command;
+    const char* hex = doc[kParams]["program"] | "";
+    command.program = HexToBytes(hex).value_or(std::vector<uint8_t>());
+    return command;
+  }
+
+  ArduinoJson::JsonDocument ToJsonCommand() const {
+    ArduinoJson::JsonDocument doc;
+    doc[kMethod] = kMethodName;
+    doc[kParams]["program"] = BytesToHex(program);
+    return doc;
+  }
+
+  // The program bytecode. Empty if the message had no valid program.
+  std::vector<uint8_t> program;
+};
+
+// Uploads a chunk of an LED mapping blob (see wall/mapping_blob.h) to a wall.
+// Blobs are too large for one ESP-NOW packet, so they are sent in chunks, in
+// order. The chunk at offset 0 starts a new upload. The wall answers every
+// chunk with a MappingUploadStatus. Once it has the last chunk, the wall checks
+// the blob and restarts to use the new mapping.
+struct UploadMappingChunkCommand {
+  static constexpr char kMethodName[] = "uploadMappingChunk";
+  // Largest chunk, so that the message fits in an ESP-NOW packet.
+  static constexpr int kMaxChunkSize = 64;
+
+  static UploadMappingChunkCommand FromJsonCommand(
+      const ArduinoJson::JsonDocument& doc) {
+    UploadMappingChunkCommand command;
+    const auto& params = doc[kParams];
+    command.offset = params["offset"];
+    command.total_size = params["totalSize"];
+    const char* hex = params["data"] | "";
+    command.data = HexToBytes(hex).value_or(std::vector<uint8_t>());
+    return command;
+  }
+
+  ArduinoJson::JsonDocument ToJsonCommand() const {
+    ArduinoJson::JsonDocument doc;
+    doc[kMethod] = kMethodName;
+    doc[kParams]["offset"] = offset;
+    doc[kParams]["totalSize"] = total_size;
+    doc[kParams]["data"] = BytesToHex(data);
+    return doc;
+  }
+
+  // Offset of the chunk in the blob.
+  uint32_t offset;
+  // Size of the whole blob.
+  uint32_t total_size;
+  // Empty if the message had no valid data.
+  std::vector<uint8_t> data;
+};
+
+// Sent by a wall for every chunk of a mapping upload, and forwarded by the
+// master to the PC with the wall's id. The PC sends the chunk at next_offset
+// next, so chunks that were lost or dropped are sent again.
+struct MappingUploadStatus {
+  static constexpr char kMethodName[] = "mappingUploadStatus";
+
+  enum class State : uint8_t {
+    // The chunk was written.
+    kAccepted,
+    // The chunk didn't follow the last one written, and was dropped.
+    kOutOfOrder,
+    // That was the last chunk, and the mapping is valid. The wall restarts to
+    // use it.
+    kComplete,
+    // The flash couldn't be written, or the mapping is invalid. The upload was
+    // dropped.
+    kFailed,
+  };
+
+  static MappingUploadStatus FromJsonCommand(
+      const ArduinoJson::JsonDocument& doc) {
+    MappingUploadStatus status;
+    const auto& params = doc[kParams];
+    status.offset = params["offset"];
+    status.next_offset = params["nextOffset"];
+    status.state = State(params["state"].as<uint8_t>());
+    return status;
+  }
+
+  ArduinoJson::JsonDocument ToJsonCommand() const {
+    ArduinoJson::JsonDocument doc;
+    doc[kMethod] = kMethodName;
+    doc[kParams]["offset"] = offset;
+    doc[kParams]["nextOffset"] = next_offset;
+    doc[kParams]["state"] = uint8_t(state);
+    return doc;
+  }
+
+  // Offset of the chunk the status is for.
+  uint32_t offset;
+  // Offset of the chunk the wall expects next.
+  uint32_t next_offset;
+  State state;
+};
+
+// Parameters of the wall patterns. Patterns only use some of them, see
+// wall/animation.h.
+struct PatternParams {
+  // Number of rings of the rose patterns.
+  uint8_t zoom = 1;
+  // How much the petals of the rose patterns bend the rings.
+  uint8_t shape = 1;
+  // Number of petals of the rose patterns.
+  uint8_t petals = 3;
+  // How tightly the spiral winds.
+  uint8_t twist = 2;
+  // Number of arms of the spiral.
+  uint8_t strands = 4;
+  // Number of waves from the center to the edge, times 2.
+  uint8_t scale = 2;
+  // 1 for waves moving in, -1 for waves moving out.
+  int8_t direction = 1;
+  uint8_t hue = 212;
+  // How much the hue shifts from the center to the edge, 128 shifts it by 128
+  // over the whole radius.
+  uint8_t hue_spread = 0;
+  // Overall brightness, 255 is full brightness.
+  uint8_t intensity = 255;
+  // Point the angles and radii of the LEDs are measured from, in LED
+  // coordinates. The walls start from the center of their LED mapping, which
+  // is close to (128, 128).
+  uint8_t origin_x = 128;
+  uint8_t origin_y = 128;
+};
+
+// Changes some of the parameters of the pattern playing on a wall. The wall
+// morphs the pattern to the new parameters over the transition duration.
+// Parameters missing from the command keep their value.
+struct SetPatternParamsCommand {
+  static constexpr char kMethodName[] = "setPatternParams";
+
+  static SetPatternParamsCommand FromJsonCommand(
+      const ArduinoJson::JsonDocument& doc) {
+    SetPatternParamsCommand command;
+    const auto& params = doc[kParams];
+    ForEachParam([&](const char* key, auto member, auto field) {
+      using T = std::remove_reference_t<decltype(PatternParams().*field)>;
+      if (params[key].is<T>()) {
+        command.*member = params[key].as<T>();
+      }
+    });
+    command.transition_duration_millis = params["transitionDurationMillis"];
+    return command;
+  }
+
+  ArduinoJson::JsonDocument ToJsonCommand() const {
+    ArduinoJson::JsonDocument doc;
+    doc[kMethod] = kMethodName;
+    ForEachParam([&](const char* key, auto member, auto field) {
+      if ((this->*member).has_value()) doc[kParams][key] = *(this->*member);
+    });
+    doc[kParams]["transitionDurationMillis"] = transition_duration_millis;
+    return doc;
+  }
+
+  // Returns params with the parameters of the command applied.
+  PatternParams ApplyTo(PatternParams params) const {
+    ForEachParam([&](const char* key, auto member, auto field) {
+      if ((this->*member).has_value()) params.*field = *(this->*member);
+    });
+    return params;
+  }
+
+  // Adds the parameters of a later command to this one.
+  void MergeFrom(const SetPatternParamsCommand& later) {
+    ForEachParam([&](const char* key, auto member, auto field) {
+      if ((later.*member).has_value()) this->*member = later.*member;
+    });
+    transition_duration_millis = later.transition_duration_millis;
+  }
+
+  std::optional<uint8_t> zoom;
+  std::optional<uint8_t> shape;
+  std::optional<uint8_t> petals;
+  std::optional<uint8_t> twist;
+  std::optional<uint8_t> strands;
+  std::optional<uint8_t> scale;
+  std::optional<int8_t> direction;
+  std::optional<uint8_t> hue;
+  std::optional<uint8_t> hue_spread;
+  std::optional<uint8_t> intensity;
+  std::optional<uint8_t> origin_x;
+  std::optional<uint8_t> origin_y;
+  int transition_duration_millis = 0;
+
+ private:
+  // Calls fn(key, member, field) for every parameter, with its JSON key, the
+  // command member holding it, and the matching PatternParams field.
+  template <typename Fn>
+  static void ForEachParam(Fn fn) {
+    using C = SetPatternParamsCommand;
+    fn("zoom", &C::zoom, &PatternParams::zoom);
+    fn("shape", &C::shape, &PatternParams::shape);
+    fn("petals", &C::petals, &PatternParams::petals);
+    fn("twist", &C::twist, &PatternParams::twist);
+    fn("strands", &C::strands, &PatternParams::strands);
+    fn("scale", &C::scale, &PatternParams::scale);
+    fn("direction", &C::direction, &PatternParams::direction);
+    fn("hue", &C::hue, &PatternParams::hue);
+    fn("hueSpread", &C::hue_spread, &PatternParams::hue_spread);
+    fn("intensity", &C::intensity, &PatternParams::intensity);
+    fn("originX", &C::origin_x, &PatternParams::origin_x);
+    fn("originY", &C::origin_y, &PatternParams::origin_y);
+  }
+};
+
+// How a layer is combined with the layers below it, channel by channel. a is the
+// channel below the layer and b the layer's, both between 0 and 255.
+enum class BlendMode : uint8_t {
+  // a + b, saturating.
+  kAdd,
+  // 255 - (255 - a) * (255 - b) / 255: lightens like add, without saturating.
+  kScreen,
+  // a * b / 255: the layer darkens what is below it.
+  kMultiply,
+  // max(a, b).
+  kMax,
+  // b: the layer hides what is below it, as much as its opacity.
+  kNormal,
+  kNumBlendModes,
+};
+
+// A part of a wall that a layer can be limited to. Regions are defined by the
+// LED coordinates, in LED Mapper's units.
+enum class Region : uint8_t {
+  // All the LEDs.
+  kWall,
+  // Radius below 128, around the hand.
+  kHandZone,
+  // Radius 128 and above.
+  kOutsideHandZone,
+  // The top quarter of the wall, y below 64.
+  kTopBand,
+  // The bottom quarter of the wall, y 192 and above.
+  kBottomBand,
+  kNumRegions,
+};
+
+// Sets one of the layers drawn over the pattern playing on a wall. Layers are
+// drawn in order, each blended over the pattern and the layers before it. A
+// layer playing PatternId::kNone is off. A layer limited to a region only
+// renders and covers the LEDs of that region.
+struct SetLayerCommand {
+  static constexpr char kMethodName[] = "setLayer";
+  static constexpr int kMaxLayers = 3;
+
+  static SetLayerCommand FromJsonCommand(const ArduinoJson::JsonDocument& doc) {
+    SetLayerCommand command;
+    const auto& params = doc[kParams];
+    command.layer = params["layer"];
+    command.pattern_id = params["patternId"];
+    command.pattern_speed = params["patternSpeed"];
+    command.opacity = params["opacity"] | 255;
+    command.blend_mode = BlendMode(params["blendMode"].as<uint8_t>());
+    command.region = Region(params["region"].as<uint8_t>());
+    return command;
+  }
+
+  ArduinoJson::JsonDocument ToJsonCommand() const {
+    ArduinoJson::JsonDocument doc;
+    doc[kMethod] = kMethodName;
+    doc[kParams]["layer"] = layer;
+    doc[kParams]["patternId"] = pattern_id;
+    doc[kParams]["patternSpeed"] = pattern_speed;
+    doc[kParams]["opacity"] = opacity;
+    doc[kParams]["blendMode"] = uint8_t(blend_mode);
+    doc[kParams]["region"] = uint8_t(region);
+    return doc;
+  }
+
+  // Between 0 and kMaxLayers - 1.
+  int layer = 0;
+  PatternId pattern_id = PatternId::kNone;
+  uint8_t pattern_speed = 60;
+  // How much the layer shows, 255 is fully.
+  uint8_t opacity = 255;
+  BlendMode blend_mode = BlendMode::kAdd;
+  Region region = Region::kWall;
+};
+
 #endif  // INCLUDE_COMMON_MESSAGES_H_
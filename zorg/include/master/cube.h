@@ -5,6 +5,7 @@
 #include <mutex>
 #include <vector>
 
+#include "common/clock.h"
 #include "master/wall.h"
 
 enum class CubeState : uint8_t {
@@ -18,11 +19,20 @@ enum class CubeState : uint8_t {
   // Special modes, set by PC.
   kManBurn,
   kTempleBurn,
+  // Plays the uploaded program.
+  kProgram,
 };
 
 // This class manages the state of the cube.
+//
+// All the timeouts are measured on the cube's clock.
 class Cube {
  public:
+  // Times the cube with the system clock.
+  Cube() : Cube(&DefaultClock()) {}
+  // The clock must outlive the cube.
+  explicit Cube(const Clock* clock) : clock_(clock) {}
+
   // How long each ambient pattern plays for.
   static constexpr int kAmbientCycleMillis = 120 * 1000;
 
@@ -30,6 +40,11 @@ class Cube {
   static constexpr int kAmbientTransitionMillis = 1 * 1000;
   static constexpr uint8_t kAmbientSpeed = 60;
 
+  // Intensity of the patterns while hands are pressed, with no hands pressed.
+  // The patterns get brighter with each hand pressed, up to full intensity
+  // with all of them.
+  static constexpr uint8_t kMinTouchedIntensity = 96;
+
   // How long until the cube enters glitch mode.
   static constexpr int kGlitchTimeoutMillis = 15 * 1000;
   // How long the cube stays in glitch mode.
@@ -54,6 +69,10 @@ class Cube {
   // wall with that MAC address.
   Wall* GetWall(MacAddress address);
 
+  // Returns the ID of the wall with the given MAC address, or -1 if there is no
+  // wall with that MAC address.
+  int GetWallId(const MacAddress& address) const;
+
   const std::vector<Wall>& walls() const { return walls_; }
 
   // Connects to all the wall MCUs.
@@ -70,12 +89,18 @@ class Cube {
   void SetNormalMode();
   void SetManBurnMode();
   void SetTempleBurnMode();
+  void SetProgramMode();
 
   void SetLedsEnabled(bool enabled);
 
+  // Sends the program to all the walls.
+  void UploadProgram(const UploadProgramCommand& command);
+
  private:
   void SetState(CubeState state);
 
+  const Clock* clock_;
+
   // Protects members from concurrent access.
   std::mutex mu_;
   std::vector<Wall> walls_;
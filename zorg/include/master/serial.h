@@ -6,6 +6,7 @@
 #include <ArduinoJson.hpp>
 #include <mutex>
 
+#include "common/messages.h"
 #include "master/cube.h"
 
 namespace serial {
@@ -39,6 +40,9 @@ void PlayDullSound();
 
 void UpdateStatus(const Cube& cube);
 
+// Forward the status of a mapping upload from a wall.
+void SendMappingUploadStatus(int wall_id, const MappingUploadStatus& status);
+
 }  // namespace serial
 
 #endif  // INCLUDE_MASTER_SERIAL_H_
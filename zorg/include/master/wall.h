@@ -3,6 +3,7 @@
 
 #include <ArduinoJson.hpp>
 #include <cstdint>
+#include <string>
 
 #include "common/common.h"
 #include "common/messages.h"
@@ -38,21 +39,35 @@ class Wall {
     return last_interaction_time_millis_;
   }
 
-  // Handler for the hand pressed signal coming from the wall MCU.
-  void OnHandPressed();
+  // Handler for the hand pressed signal coming from the wall MCU, received at
+  // the given time.
+  void OnHandPressed(uint64_t now_millis);
 
-  // Handler for the hand released signal coming from the wall MCU.
-  void OnHandReleased();
+  // Handler for the hand released signal coming from the wall MCU, received at
+  // the given time.
+  void OnHandReleased(uint64_t now_millis);
 
+  // Sets the pattern of the wall, and its intensity. The pattern fades in and
+  // morphs to the intensity over the transition. The intensity is sent with
+  // every pattern, so a pattern dimmed earlier plays at the intensity it is
+  // given when it comes back.
   void SetPattern(PatternId pattern_id, uint8_t pattern_speed,
-                  int transition_duration_millis);
+                  int transition_duration_millis,
+                  uint8_t intensity = PatternParams().intensity);
 
   // Send a command to the wall MCU.
   void SendSetPatternCommand(const SetPatternCommand& command) const;
+  void SendSetPatternParamsCommand(
+      const SetPatternParamsCommand& command) const;
+  void SendSetLayerCommand(const SetLayerCommand& command) const;
   void SendRestartCommand() const;
   void SendSetTouchThresholdCommand(uint16_t touch_threshold) const;
+  void SendSetWallVariantCommand(const std::string& variant) const;
 
   void SendSetLedsEnabledCommand(bool enabled) const;
+  void SendUploadProgramCommand(const UploadProgramCommand& command) const;
+  void SendUploadMappingChunkCommand(
+      const UploadMappingChunkCommand& command) const;
 
  private:
   void Send(const ArduinoJson::JsonDocument& doc) const;
@@ -3,199 +3,716 @@
 
 #include <FastLED.h>
 
-#include <memory>
+#include <algorithm>
+#include <array>
 #include <mutex>
+#include <optional>
+#include <type_traits>
+#include <variant>
 #include <vector>
 
+#include "common/clock.h"
 #include "common/messages.h"
+#include "wall/frame_governor.h"
+#include "wall/led_mapper_data.h"
+#include "wall/particles.h"
+#include "wall/polar.h"
+#include "wall/program.h"
+#include "wall/random.h"
+#include "wall/regions.h"
+#include "wall/stencil.h"
+#include "wall/swar.h"
 
-// A single LED light. Use x(), y(), angle() and radius() to get a value between
-// 0 and 255.
-class LED {
+// One of the LED coordinates.
+enum class Domain : uint8_t { kX, kY, kAngle, kRadius };
+
+// Positions of the LEDs, as exported by LED Mapper. Use x(), y(), angle() and
+// radius() to get one array per coordinate, with values between 0 and 255.
+// The geometry never changes once the LEDs are initialized, so a single
+// instance is shared by all the LED buffers. It doesn't copy the arrays of the
+// mapping, which stay in flash.
+class LEDGeometry {
  public:
-  LED(CRGB& data, uint8_t x, uint8_t y, uint8_t angle, uint8_t radius)
-      : data_(data), x_(x), y_(y), angle_(angle), radius_(radius) {}
-  CRGB& color() { return data_; }
-  uint8_t x() const { return x_; }
-  uint8_t y() const { return y_; }
-  uint8_t angle() const { return angle_; }
-  uint8_t radius() const { return radius_; }
+  LEDGeometry() = default;
+  explicit LEDGeometry(const LEDMapping& mapping) : mapping_(mapping) {}
+
+  // The mapping, with the indexes derived from the positions.
+  const LEDMapping& mapping() const { return mapping_; }
+
+  int num_leds() const { return mapping_.num_leds; }
+  const uint8_t* x() const { return mapping_.x; }
+  const uint8_t* y() const { return mapping_.y; }
+  const uint8_t* angle() const { return mapping_.angle; }
+  const uint8_t* radius() const { return mapping_.radius; }
+  const uint8_t* coordinate(Domain domain) const {
+    switch (domain) {
+      case Domain::kX:
+        return x();
+      case Domain::kY:
+        return y();
+      case Domain::kAngle:
+        return angle();
+      case Domain::kRadius:
+        break;
+    }
+    return radius();
+  }
 
  private:
-  CRGB& data_;
-  uint8_t x_;
-  uint8_t y_;
-  uint8_t angle_;
-  uint8_t radius_;
+  LEDMapping mapping_ = {};
 };
 
-// Buffer of LED data.
+// Maps an 8-bit intensity (or palette index) to a color.
+using Palette = std::array<CRGB, 256>;
+
+// Returns the palette going from black to the given hue and saturation, at the
+// given intensity: palette[v] is CHSV(hue, sat, scale8(v, intensity)).
+Palette HuePalette(uint8_t hue, uint8_t sat = 255, uint8_t intensity = 255);
+
+// Returns FastLED's heat palette, going from black through red and yellow to
+// white: palette[v] is HeatColor(v).
+Palette HeatPalette();
+
+// Maps a byte to another byte.
+using ByteTable = std::array<uint8_t, 256>;
+
+// Fills table[v] with sin8(v + offset) for all 256 values of v. Patterns whose
+// per-LED formula is sin8 of a cached phase plus a per-frame offset look the
+// sine up in this table instead of computing it for every LED.
+inline void FillSinTable(uint8_t offset, ByteTable& table) {
+  for (int v = 0; v < 256; ++v) {
+    table[v] = sin8(v + offset);
+  }
+}
+
+// Buffer of LED data. The color of LED i is led_data()[i], and its position is
+// at index i of the geometry arrays.
+//
+// Patterns that only vary in intensity write one byte per LED to
+// index_data() instead, then expand it to colors with ApplyPalette().
 class LEDBuffer {
  public:
-  void Init(int size) { led_data_.assign(size, CRGB::Black); }
-  void AddLED(uint8_t x, uint8_t y, uint8_t angle, uint8_t radius) {
-    leds_.push_back(LED(led_data_[leds_.size()], x, y, angle, radius));
+  void Init(const LEDGeometry* geometry) {
+    geometry_ = geometry;
+    led_data_.assign(geometry->num_leds(), CRGB::Black);
+    index_data_.assign(geometry->num_leds(), 0);
   }
-  std::vector<LED>& leds() { return leds_; }
+  const LEDGeometry& geometry() const { return *geometry_; }
   std::vector<CRGB>& led_data() { return led_data_; }
   CRGB* raw_led_data() { return led_data_.data(); }
-  int num_leds() { return led_data_.size(); }
+  uint8_t* raw_index_data() { return index_data_.data(); }
+  int num_leds() const { return led_data_.size(); }
+
+  // Sets the color of every LED to palette[index].
+  void ApplyPalette(const Palette& palette) {
+    for (int i = 0; i < num_leds(); ++i) {
+      led_data_[i] = palette[index_data_[i]];
+    }
+  }
 
  private:
-  std::vector<LED> leds_;
+  // Not owned.
+  const LEDGeometry* geometry_ = nullptr;
   std::vector<CRGB> led_data_;
+  std::vector<uint8_t> index_data_;
+};
+
+// Per-LED values that only depend on the LED positions and on a pattern's
+// parameters. They are computed on the first frame after a Reset() or a
+// parameter change, instead of on every frame.
+class PhaseCache {
+ public:
+  // Returns one value per LED, calling fn(i) for every LED i if the cached
+  // values are stale.
+  template <typename Fn>
+  const uint8_t* Get(const LEDGeometry& geometry, Fn fn) {
+    return Get(geometry, key_, fn);
+  }
+
+  // Same, but the values are also stale if they were computed for another key.
+  // The key identifies the parameters fn uses.
+  template <typename Fn>
+  const uint8_t* Get(const LEDGeometry& geometry, uint64_t key, Fn fn) {
+    if (geometry_ != &geometry || key_ != key) {
+      values_.resize(geometry.num_leds());
+      for (int i = 0; i < geometry.num_leds(); ++i) {
+        values_[i] = fn(i);
+      }
+      geometry_ = &geometry;
+      key_ = key;
+    }
+    return values_.data();
+  }
+
+  // Call when the parameters used to compute the values change.
+  void Invalidate() { geometry_ = nullptr; }
+
+ private:
+  // Geometry the values were computed for, or null if stale. Not owned.
+  const LEDGeometry* geometry_ = nullptr;
+  uint64_t key_ = 0;
+  std::vector<uint8_t> values_;
 };
 
+// Patterns of the same family share a formula and only differ by their
+// parameters.
+enum class PatternFamily : uint8_t { kNone, kSpiral, kWave, kRose };
+
 // Base class for all the patterns.
+//
+// Patterns render with a set of PatternParams. A pattern can morph from other
+// parameters to its own: it then renders with parameters part of the way
+// between the two, interpolated in 8.8 fixed point so that the morph is
+// smooth even for small integer parameters. Phase caches are keyed by the
+// parameters they use, so they are only recomputed when those change.
+//
+// The angles and radii of the LEDs are measured from the origin parameters, see
+// Coordinate(). Moving the origin moves the radial patterns with it.
+//
+// Patterns that need random numbers draw them from their own stream, see
+// NextRandomFrame(), rather than from FastLED's or Arduino's generators.
+// Likewise, they read the time of the frame they render, see set_frame_time(),
+// rather than millis().
 class Pattern {
  public:
+  Pattern() = default;
+  explicit Pattern(const PatternParams& params)
+      : params_(params), morph_from_(params) {}
+  virtual ~Pattern() = default;
   virtual void Update(LEDBuffer& buffer, uint8_t speed) = 0;
   virtual void Reset() {};
+
+  // Patterns of the same family can morph into each other instead of being
+  // blended, see LEDController.
+  virtual PatternFamily family() const { return PatternFamily::kNone; }
+
+  // Whether the pattern's frames depend on the frames it rendered before, and
+  // not only on the time of the frame and its parameters: its state takes a
+  // step every Update(). Rendered less often, such a pattern would play slower
+  // and jerkily, so LEDController freezes it once it fades out instead.
+  virtual bool stateful() const { return false; }
+
+  // Parameters the pattern renders with once done morphing.
+  const PatternParams& params() const { return params_; }
+  void SetParams(const PatternParams& params) {
+    params_ = params;
+    morph_amount_ = 255;
+  }
+
+  // Parameters the pattern renders with at this point of the morph, rounded.
+  PatternParams CurrentParams() const;
+
+  // Starts morphing from the given parameters to params(). The pattern renders
+  // with `from` until set_morph_amount() moves it along.
+  void StartMorph(const PatternParams& from) {
+    morph_from_ = from;
+    morph_amount_ = 0;
+  }
+
+  // How far the morph is, from 0 (rendering with the parameters it started
+  // from) to 255 (rendering with params()).
+  void set_morph_amount(fract8 amount) { morph_amount_ = amount; }
+
+  // Sets the time of the frames rendered and of the resets until the next
+  // call, in microseconds. LEDController samples its clock once per frame.
+  void set_frame_time(uint64_t now_micros) { now_micros_ = now_micros; }
+
+ protected:
+  uint64_t now_micros() const { return now_micros_; }
+
+  // Time of the frame in milliseconds, wrapping around like Arduino's
+  // millis().
+  uint32_t now_millis() const { return now_micros_ / 1000; }
+
+  // FastLED's beat8(), at the time of the frame.
+  uint8_t Beat8(uint16_t beats_per_minute) const {
+    // As in beat16(), low rates are in whole beats per minute, high rates in
+    // 8.8 fixed point.
+    uint32_t beats_per_minute_88 =
+        beats_per_minute < 256 ? beats_per_minute << 8 : beats_per_minute;
+    return uint16_t((now_millis() * beats_per_minute_88 * 280) >> 16) >> 8;
+  }
+
+  // FastLED's beatsin8(), at the time of the frame.
+  uint8_t BeatSin8(uint16_t beats_per_minute, uint8_t lowest = 0,
+                   uint8_t highest = 255) const {
+    return lowest + scale8(sin8(Beat8(beats_per_minute)), highest - lowest);
+  }
+
+  // Returns the value of a parameter at this point of the morph, in 8.8 fixed
+  // point.
+  template <typename T>
+  int Param88(T PatternParams::*param) const {
+    int from = morph_from_.*param;
+    int to = params_.*param;
+    return from * 256 + (to - from) * 256 * morph_amount_ / 255;
+  }
+
+  // Returns the value of a parameter at this point of the morph, rounded down.
+  template <typename T>
+  T Param(T PatternParams::*param) const {
+    return Param88(param) >> 8;
+  }
+
+  // Returns a coordinate of every LED, with the angles and radii measured from
+  // the origin at this point of the morph. Around the mapping's origin, they
+  // are LED Mapper's. Around any other origin, they are recomputed whenever it
+  // moves, see wall/polar.h.
+  const uint8_t* Coordinate(const LEDGeometry& geometry, Domain domain) {
+    uint8_t origin_x = Param(&PatternParams::origin_x);
+    uint8_t origin_y = Param(&PatternParams::origin_y);
+    if (domain == Domain::kX || domain == Domain::kY ||
+        (origin_x == geometry.mapping().origin_x &&
+         origin_y == geometry.mapping().origin_y)) {
+      return geometry.coordinate(domain);
+    }
+    polar_.Update(geometry.num_leds(), geometry.x(), geometry.y(), origin_x,
+                  origin_y);
+    return domain == Domain::kAngle ? polar_.angle() : polar_.radius();
+  }
+
+  // Identifies the origin of the angles and radii returned by Coordinate(), for
+  // the keys of the phase caches computed from them.
+  uint64_t OriginKey() const {
+    return uint64_t(Param(&PatternParams::origin_x)) << 40 |
+           uint64_t(Param(&PatternParams::origin_y)) << 32;
+  }
+
+  // Restarts the pattern's random numbers from a new seed.
+  void ReseedRandom(uint32_t seed) {
+    random_.set_seed(seed);
+    random_frame_ = 0;
+  }
+
+  // Returns the random numbers of the pattern's next frame. They only depend on
+  // the seed and on the number of frames drawn since it was set.
+  RandomFrame NextRandomFrame() { return random_.Frame(random_frame_++); }
+
+ private:
+  PatternParams params_;
+  PatternParams morph_from_;
+  fract8 morph_amount_ = 255;
+  uint64_t now_micros_ = 0;
+  RandomStream random_;
+  uint32_t random_frame_ = 0;
+  // Angles and radii around an origin other than the mapping's.
+  PolarCoordinates polar_;
 };
 
-// All LEDs off.
-class NonePattern : public Pattern {
+// Base class for patterns that only vary in intensity. The pattern writes one
+// byte per LED, which is then expanded to colors through the pattern's
+// palette. Changing the palette recolors the whole pattern at no per-LED cost.
+//
+// Unless the pattern is given a palette, the palette follows the hue and
+// intensity parameters.
+class PalettePattern : public Pattern {
  public:
+  explicit PalettePattern(const PatternParams& params = {})
+      : Pattern(params),
+        palette_(HuePalette(params.hue, 255, params.intensity)),
+        palette_hue_(params.hue),
+        palette_intensity_(params.intensity) {}
+  explicit PalettePattern(const Palette& palette)
+      : palette_(palette), fixed_palette_(true) {}
+
   void Update(LEDBuffer& buffer, uint8_t speed) override {
-    fill_solid(buffer.raw_led_data(), buffer.num_leds(), CRGB::Black);
+    Render(buffer.geometry(), buffer.raw_index_data(), speed);
+    buffer.ApplyPalette(palette());
   }
+
+  // Returns the palette, rebuilding it if the hue or intensity changed.
+  const Palette& palette() {
+    if (fixed_palette_) return palette_;
+    uint8_t hue = Param(&PatternParams::hue);
+    uint8_t intensity = Param(&PatternParams::intensity);
+    if (hue != palette_hue_ || intensity != palette_intensity_) {
+      palette_ = HuePalette(hue, 255, intensity);
+      palette_hue_ = hue;
+      palette_intensity_ = intensity;
+    }
+    return palette_;
+  }
+  void set_palette(const Palette& palette) {
+    palette_ = palette;
+    fixed_palette_ = true;
+  }
+
+  // Writes the palette index of each LED to indices, for LEDController to
+  // expand them to colors as it composites the pattern over others.
+  void RenderIndices(const LEDGeometry& geometry, uint8_t* indices,
+                     uint8_t speed) {
+    Render(geometry, indices, speed);
+  }
+
+ protected:
+  // Writes the intensity of each LED to indices.
+  virtual void Render(const LEDGeometry& geometry, uint8_t* indices,
+                      uint8_t speed) = 0;
+
+ private:
+  Palette palette_;
+  // Parameters palette_ was built for, unless fixed_palette_.
+  uint8_t palette_hue_ = 0;
+  uint8_t palette_intensity_ = 0;
+  bool fixed_palette_ = false;
 };
 
-class SpiralPattern : public Pattern {
+// Base class for patterns where the intensity of an LED only depends on one of
+// its coordinates. The pattern is evaluated once for each of the 256 possible
+// coordinate values, then every LED looks its color up in that table. With
+// more LEDs than coordinate values, this does much less math per frame.
+class DomainPattern : public PalettePattern {
  public:
-  void Update(LEDBuffer& buffer, uint8_t speed) override {
-    uint8_t rotation = beat8(speed);
-    for (LED& led : buffer.leds()) {
-      uint8_t brightness =
-          sin8(twist_ * led.radius() + strands_ * led.angle() - rotation);
-      led.color().setHSV(212, 255, brightness);
+  explicit DomainPattern(Domain domain, const PatternParams& params = {})
+      : PalettePattern(params), domain_(domain) {}
+
+  void Update(LEDBuffer& buffer, uint8_t speed) final {
+    Evaluate(table_.data(), speed);
+    // Apply the palette to the table rather than to every LED.
+    const Palette& colors = palette();
+    for (int v = 0; v < 256; ++v) {
+      colors_[v] = colors[table_[v]];
+    }
+    const uint8_t* coordinate = Coordinate(buffer.geometry(), domain_);
+    CRGB* leds = buffer.raw_led_data();
+    for (int i = 0; i < buffer.num_leds(); ++i) {
+      leds[i] = colors_[coordinate[i]];
+    }
+  }
+
+ protected:
+  // Fills table[v] with the intensity of the LEDs whose coordinate is v, for
+  // all 256 values of v.
+  virtual void Evaluate(uint8_t* table, uint8_t speed) = 0;
+
+  void Render(const LEDGeometry& geometry, uint8_t* indices,
+              uint8_t speed) final {
+    Evaluate(table_.data(), speed);
+    const uint8_t* coordinate = Coordinate(geometry, domain_);
+    for (int i = 0; i < geometry.num_leds(); ++i) {
+      indices[i] = table_[coordinate[i]];
     }
   }
 
  private:
-  uint8_t twist_ = 2;
-  uint8_t strands_ = 4;
+  Domain domain_;
+  ByteTable table_;
+  Palette colors_;
 };
 
-class WavePattern : public Pattern {
+// All LEDs off.
+class NonePattern final : public Pattern {
  public:
-  enum class Direction { kIn, kOut };
+  void Update(LEDBuffer& buffer, uint8_t speed) override {
+    fill_solid(buffer.raw_led_data(), buffer.num_leds(), CRGB::Black);
+  }
+};
 
-  WavePattern(Direction direction) { SetDirection(direction); }
+// Uses the twist, strands, hue, intensity and origin parameters.
+class SpiralPattern final : public PalettePattern {
+ public:
+  PatternFamily family() const override { return PatternFamily::kSpiral; }
 
-  void Update(LEDBuffer& buffer, uint8_t speed) override {
-    // Divide speed by 2, otherwise wave looks faster.
-    uint8_t wave_phase = (direction_ * beat8(speed)) / 2;
+  void Reset() override { phase_.Invalidate(); }
 
-    for (LED& led : buffer.leds()) {
-      uint8_t brightness = sin8(scale_ * (led.radius() + wave_phase));
-      led.color().setHSV(212, 255, brightness);
+ private:
+  void Render(const LEDGeometry& geometry, uint8_t* indices,
+              uint8_t speed) override {
+    uint8_t rotation = Beat8(speed);
+    int twist = Param88(&PatternParams::twist);
+    int strands = Param88(&PatternParams::strands);
+    const uint8_t* radius = Coordinate(geometry, Domain::kRadius);
+    const uint8_t* angle = Coordinate(geometry, Domain::kAngle);
+    uint64_t key = OriginKey() | uint32_t(twist) << 16 | strands;
+    const uint8_t* phase = phase_.Get(geometry, key, [&](int i) -> uint8_t {
+      return (twist * radius[i] + strands * angle[i]) >> 8;
+    });
+    FillSinTable(-rotation, wave_);
+    for (int i = 0; i < geometry.num_leds(); ++i) {
+      indices[i] = wave_[phase[i]];
     }
   }
 
-  void SetDirection(Direction direction) {
-    direction_ = direction == Direction::kIn ? 1 : -1;
-  }
+  // twist * radius + strands * angle.
+  PhaseCache phase_;
+  // sin8(v - rotation).
+  ByteTable wave_;
+};
+
+// Uses the scale, direction, hue, intensity and origin parameters.
+class WavePattern final : public DomainPattern {
+ public:
+  enum class Direction { kIn, kOut };
+
+  explicit WavePattern(Direction direction)
+      : DomainPattern(Domain::kRadius, WaveParams(direction)) {}
+
+  PatternFamily family() const override { return PatternFamily::kWave; }
 
  private:
-  uint8_t scale_ = 2;
-  int8_t direction_ = 1;
+  static PatternParams WaveParams(Direction direction) {
+    PatternParams params;
+    params.direction = direction == Direction::kIn ? 1 : -1;
+    return params;
+  }
+
+  void Evaluate(uint8_t* table, uint8_t speed) override {
+    // Divide speed by 2, otherwise wave looks faster.
+    uint8_t wave_phase =
+        (Param88(&PatternParams::direction) * Beat8(speed)) / 512;
+    int scale = Param88(&PatternParams::scale);
+    for (int radius = 0; radius < 256; ++radius) {
+      table[radius] = sin8((scale * (radius + wave_phase)) >> 8);
+    }
+  }
 };
 
-class RosePattern : public Pattern {
+// Uses the zoom, shape, petals, hue, hue_spread, intensity and origin
+// parameters. With
+// a hue spread, the hue changes with the distance to the center for a more
+// psychedelic effect, which is the man burn pattern.
+class RosePattern final : public PalettePattern {
  public:
+  explicit RosePattern(const PatternParams& params = {})
+      : PalettePattern(params) {}
+
+  PatternFamily family() const override { return PatternFamily::kRose; }
+
   void Update(LEDBuffer& buffer, uint8_t speed) override {
-    uint8_t rotation = beat8(speed);
-    uint8_t ripple = beat8(speed);
-    for (LED& led : buffer.leds()) {
-      uint8_t brightness =
-          sin8(zoom_ * led.radius() +
-               shape_ * sin8(petals_ * led.angle() + rotation) + ripple);
-      led.color().setHSV(212, 255, brightness);
+    int hue_spread = Param88(&PatternParams::hue_spread);
+    if (hue_spread == 0) {
+      PalettePattern::Update(buffer, speed);
+      return;
+    }
+    const LEDGeometry& geometry = buffer.geometry();
+    uint8_t* brightness = buffer.raw_index_data();
+    Render(geometry, brightness, speed);
+    int base_hue = Param88(&PatternParams::hue);
+    const uint8_t* radius = Coordinate(geometry, Domain::kRadius);
+    uint64_t key = OriginKey() | uint32_t(base_hue) << 16 | hue_spread;
+    const uint8_t* hue = hue_.Get(geometry, key, [&](int i) -> uint8_t {
+      return (base_hue + ((hue_spread * radius[i]) >> 8)) >> 8;
+    });
+    uint8_t intensity = Param(&PatternParams::intensity);
+    CRGB* leds = buffer.raw_led_data();
+    for (int i = 0; i < buffer.num_leds(); ++i) {
+      leds[i].setHSV(hue[i], 255, scale8(brightness[i], intensity));
     }
   }
 
+  void Reset() override {
+    radial_.Invalidate();
+    petal_.Invalidate();
+  }
+
  private:
-  uint8_t zoom_ = 1;
-  uint8_t shape_ = 1;
-  uint8_t petals_ = 3;
+  void Render(const LEDGeometry& geometry, uint8_t* indices,
+              uint8_t speed) override {
+    uint8_t rotation = Beat8(speed);
+    uint8_t ripple = Beat8(speed);
+    int zoom = Param88(&PatternParams::zoom);
+    int petals = Param88(&PatternParams::petals);
+    int shape = Param88(&PatternParams::shape);
+    const uint8_t* radius = Coordinate(geometry, Domain::kRadius);
+    const uint8_t* angle = Coordinate(geometry, Domain::kAngle);
+    const uint8_t* radial =
+        radial_.Get(geometry, OriginKey() | zoom, [&](int i) -> uint8_t {
+          return (zoom * radius[i]) >> 8;
+        });
+    const uint8_t* petal =
+        petal_.Get(geometry, OriginKey() | petals, [&](int i) -> uint8_t {
+          return (petals * angle[i]) >> 8;
+        });
+    FillSinTable(rotation, bend_);
+    for (int v = 0; v < 256; ++v) {
+      bend_[v] = (shape * bend_[v]) >> 8;
+    }
+    FillSinTable(ripple, ring_);
+    for (int i = 0; i < geometry.num_leds(); ++i) {
+      indices[i] = ring_[uint8_t(radial[i] + bend_[petal[i]])];
+    }
+  }
+
+  // zoom * radius.
+  PhaseCache radial_;
+  // petals * angle.
+  PhaseCache petal_;
+  // shape * sin8(v + rotation).
+  ByteTable bend_;
+  // sin8(v + ripple).
+  ByteTable ring_;
+  // hue + hue_spread * radius / 256.
+  PhaseCache hue_;
 };
 
-class CirclesPattern : public Pattern {
+class CirclesPattern final : public PalettePattern {
  public:
-  void Update(LEDBuffer& buffer, uint8_t speed) override {
-    uint8_t x_translation = 0;
-    uint8_t y_translation = 0;
-    uint8_t warp = beat8(speed);
+  void Reset() override { field_.Invalidate(); }
 
-    for (LED& led : buffer.leds()) {
-      uint8_t brightness = sin8(sin8(scale_ * led.x() + x_translation) +
-                                sin8(scale_ * led.y() + y_translation) + warp);
-      led.color().setHSV(212, 255, brightness);
+ private:
+  void Render(const LEDGeometry& geometry, uint8_t* indices,
+              uint8_t speed) override {
+    uint8_t warp = Beat8(speed);
+    const uint8_t* field = field_.Get(geometry, [&](int i) -> uint8_t {
+      return sin8(kScale * geometry.x()[i] + kXTranslation) +
+             sin8(kScale * geometry.y()[i] + kYTranslation);
+    });
+    FillSinTable(warp, wave_);
+    for (int i = 0; i < geometry.num_leds(); ++i) {
+      indices[i] = wave_[field[i]];
     }
   }
 
- private:
-  uint8_t scale_ = 1;
+  static constexpr uint8_t kScale = 1;
+  static constexpr uint8_t kXTranslation = 0;
+  static constexpr uint8_t kYTranslation = 0;
+  // sin8(kScale * x + kXTranslation) + sin8(kScale * y + kYTranslation).
+  PhaseCache field_;
+  // sin8(v + warp).
+  ByteTable wave_;
 };
 
-class AwaitTouchPattern : public Pattern {
+class AwaitTouchPattern final : public DomainPattern {
  public:
-  void Update(LEDBuffer& buffer, uint8_t speed) override {
-    uint8_t wave_phase = beatsin8(speed, 32, 64);
+  AwaitTouchPattern() : DomainPattern(Domain::kRadius) {}
 
-    for (LED& led : buffer.leds()) {
-      if (led.radius() < 128) {
-        uint8_t r = 2 * (led.radius() + wave_phase);
-        uint8_t brightness = cos8(r);
-        led.color().setHSV(212, 255, brightness);
+ private:
+  void Evaluate(uint8_t* table, uint8_t speed) override {
+    uint8_t wave_phase = BeatSin8(speed, 32, 64);
+    for (int radius = 0; radius < 256; ++radius) {
+      if (radius < 128) {
+        uint8_t r = 2 * (radius + wave_phase);
+        table[radius] = cos8(r);
       } else {
-        led.color() = CRGB::Black;
+        table[radius] = 0;
       }
     }
   }
-
- private:
-  uint8_t scale_ = 1;
 };
 
-class GlitchPattern : public Pattern {
+// Mostly blue, with black and white pixels and segments that change at random
+// intervals, of up to 4 seconds at the highest speed.
+//
+// Each glitch is generated once, as a list of runs of LEDs, and every frame
+// until the next glitch is drawn from the runs: a fill with blue, then the few
+// LEDs of the runs.
+class GlitchPattern final : public PalettePattern {
  public:
-  void Update(LEDBuffer& buffer, uint8_t speed) override {
-    if (millis() > next_glitch_time_millis_) {
-      randSeed_ = millis();
+  GlitchPattern() : PalettePattern(GlitchPalette()) {}
+
+  void Reset() override { ReseedRandom(now_millis()); }
+
+  bool stateful() const override { return true; }
+
+ private:
+  // Palette indices of the colors.
+  static constexpr uint8_t kBlack = 0;
+  static constexpr uint8_t kBlue = 1;
+  static constexpr uint8_t kWhite = 2;
+
+  // LEDs start to start + length - 1, black or white. The LED at start + j is
+  // white if bit j of white is set.
+  struct Run {
+    uint16_t start;
+    uint8_t length;
+    uint32_t white;
+  };
+
+  static Palette GlitchPalette() {
+    Palette palette;
+    palette.fill(CRGB::Black);
+    palette[kBlue] = CRGB::Blue;
+    palette[kWhite] = CRGB::White;
+    return palette;
+  }
+
+  void Render(const LEDGeometry& geometry, uint8_t* indices,
+              uint8_t speed) override {
+    int num_leds = geometry.num_leds();
+    uint64_t now = now_micros() / 1000;
+    if (now > next_glitch_time_millis_ || num_leds != num_leds_) {
+      RandomFrame random = NextRandomFrame();
+      Generate(num_leds, random);
       next_glitch_time_millis_ =
-          millis() + random(100, lerp16by8(100, 4000, speed));
+          now + 100 +
+          random.Below(3 * num_leds, lerp16by8(100, 4000, speed) - 100);
     }
-    randomSeed(randSeed_);
-    // Create a mostly static pattern with blue
-    for (int i = 0; i < buffer.num_leds(); ++i) {
-      int randVal = random(100);
-      buffer.led_data()[i] = CRGB::Blue;
-      if (randVal > 98) {
-        // Large glitch segments
-        int glitchLength = random(5, 30);
-        for (int j = 0; j < glitchLength && (i + j) < buffer.num_leds(); j++) {
-          buffer.led_data()[i + j] = random(2) == 0 ? CRGB::Black : CRGB::White;
-        }
-        i += glitchLength;  // Skip over the glitch segment
-      } else if (randVal > 90) {
-        // Small glitch pixels
-        buffer.led_data()[i] = random(2) == 0 ? CRGB::Black : CRGB::White;
+    std::fill_n(indices, num_leds, kBlue);
+    for (const Run& run : runs_) {
+      uint8_t* leds = indices + run.start;
+      for (int j = 0; j < run.length; ++j) {
+        leds[j] = (run.white >> j) & 1 ? kWhite : kBlack;
+      }
+    }
+  }
+
+  // Generates the runs of a new glitch. The numbers drawn for LED i are at
+  // indexes 3 * i to 3 * i + 2 of the frame.
+  void Generate(int num_leds, const RandomFrame& random) {
+    runs_.clear();
+    num_leds_ = num_leds;
+    for (int i = 0; i < num_leds; ++i) {
+      int roll = random.Below(3 * i, 100);
+      uint32_t white = random.Get(3 * i + 2);
+      if (roll > 98) {
+        // Large glitch segments. The LED after a segment is always blue.
+        int length = std::min(5 + random.Below(3 * i + 1, 25), num_leds - i);
+        runs_.push_back({.start = uint16_t(i),
+                         .length = uint8_t(length),
+                         .white = white & ((1u << length) - 1)});
+        i += length;
+      } else if (roll > 90) {
+        // Small glitch pixels.
+        runs_.push_back(
+            {.start = uint16_t(i), .length = 1, .white = white >> 31});
       }
     }
   }
 
- private:
-  int randSeed_ = 0;
   uint64_t next_glitch_time_millis_ = 0;
+  // The current glitch, and the number of LEDs it was generated for.
+  std::vector<Run> runs_;
+  int num_leds_ = 0;
 };
 
-class ClimaxPattern : public Pattern {
+// The LEDs of ClimaxPattern, which light up one by one as the fill progresses,
+// and keep brightening once lit until they are fully bright.
+//
+// Each LED is given a threshold, drawn at random: it lights up once the fill
+// progress is above its threshold. The LEDs are kept sorted by threshold, so
+// that a frame only lights the LEDs whose threshold it crossed, and only
+// brightens the lit LEDs that aren't fully bright yet, instead of testing
+// every LED. The threshold of LED i is random.Get8(i), for the random numbers
+// given to Init().
+class ClimaxFill {
+ public:
+  // Turns all the LEDs off, and draws their thresholds.
+  void Init(int num_leds, const RandomFrame& random);
+
+  int num_leds() const { return glow_.size(); }
+
+  // Lights the LEDs whose threshold is below fill_progress, which must not
+  // decrease between calls, brightens the lit LEDs and writes the colors of
+  // all the LEDs to leds.
+  void Advance(uint8_t fill_progress, CRGB* leds);
+
+ private:
+  // The LEDs, by increasing threshold, then by index. The first num_lit_ are
+  // lit, and the first num_full_ of them no longer brighten. LEDs lit earlier
+  // are at least as bright, so both are prefixes.
+  std::vector<uint16_t> order_;
+  // Threshold of order_[k].
+  std::vector<uint8_t> thresholds_;
+  // Color of each LED.
+  std::vector<CRGB> glow_;
+  int num_lit_ = 0;
+  int num_full_ = 0;
+};
+
+class ClimaxPattern final : public Pattern {
  public:
   void Update(LEDBuffer& buffer, uint8_t speed) override {
-    rand16seed = rand_seed_;
-    uint32_t current_time = millis();
+    uint32_t current_time = now_millis();
     uint32_t elapsed_time = current_time - start_time_;
 
     // Calculate the appropriate fill_progress_ based on the elapsed time
@@ -205,144 +722,702 @@ class ClimaxPattern : public Pattern {
       fill_progress_ = 255;
     }
 
-    for (LED& led : buffer.leds()) {
-      // Randomly decide if this LED should start brightening
-      if (random8() < fill_progress_) {
-        led.color() += CHSV(10, 10, 1);
-      } else {
-        // Keep the LED off (black) until it's chosen to brighten
-        led.color().setHSV(0, 0, 0);
-      }
+    // The LED buffers alternate between frames, so the glow accumulates in
+    // fill_ rather than in the buffer.
+    if (fill_.num_leds() != buffer.num_leds()) {
+      fill_.Init(buffer.num_leds(), NextRandomFrame());
     }
+    fill_.Advance(fill_progress_, buffer.raw_led_data());
   }
 
   void Reset() override {
-    rand_seed_ = millis();
+    ReseedRandom(now_millis());
     fill_progress_ = 0;
-    start_time_ = millis();  // Reset the start time
+    start_time_ = now_millis();  // Reset the start time
+    // The thresholds are drawn again on the next frame.
+    fill_.Init(0, RandomFrame(0));
   }
 
+  bool stateful() const override { return true; }
+
  private:
-  uint16_t rand_seed_ = 0;
   uint8_t fill_progress_ = 0;
   uint32_t start_time_ = 0;
   uint32_t duration_ = 20'000;  // Default duration (in milliseconds)
   uint8_t scale_ = 2;
+  ClimaxFill fill_;
 };
 
-class RecoveryPattern : public Pattern {
+class RecoveryPattern final : public DomainPattern {
  public:
-  void Update(LEDBuffer& buffer, uint8_t speed) override {
-    uint8_t offset = beatsin8(speed / 2);
-    uint8_t pulse = beatsin8(speed / 2, 128, 255);
-    for (LED& led : buffer.leds()) {
-      uint8_t a = qadd8(led.y(), offset);
+  RecoveryPattern() : DomainPattern(Domain::kY) {}
+
+ private:
+  void Evaluate(uint8_t* table, uint8_t speed) override {
+    uint8_t offset = BeatSin8(speed / 2);
+    uint8_t pulse = BeatSin8(speed / 2, 128, 255);
+    for (int y = 0; y < 256; ++y) {
+      uint8_t a = qadd8(y, offset);
       if (a < 128) a = 128;
       uint8_t brightness = cos8(a);
-      brightness = scale8_video(brightness, pulse);
-      led.color().setHSV(212, 255, brightness);
+      table[y] = scale8_video(brightness, pulse);
     }
   }
 };
 
-class ManBurnPattern : public Pattern {
+class TempleBurnPattern final : public PalettePattern {
  public:
-  void Update(LEDBuffer& buffer, uint8_t speed) override {
-    uint8_t rotation = beat8(speed);
-    uint8_t ripple = beat8(speed);
-    for (LED& led : buffer.leds()) {
-      uint8_t brightness =
-          sin8(zoom_ * led.radius() +
-               shape_ * sin8(petals_ * led.angle() + rotation) + ripple);
-      // Change the hue slightly based on the distance for a more psychedelic
-      // effect
-      uint8_t hue = 212 + (led.radius() / 2);
+  TempleBurnPattern() : PalettePattern(HuePalette(0, 0)) {}
+
+  void Reset() override { field_.Invalidate(); }
 
-      led.color().setHSV(hue, 255, brightness);
+ private:
+  void Render(const LEDGeometry& geometry, uint8_t* indices,
+              uint8_t speed) override {
+    uint8_t offset = Beat8(speed);
+    const uint8_t* x = geometry.x();
+    const uint8_t* y = geometry.y();
+    const uint8_t* field = field_.Get(geometry, [&](int i) -> uint8_t {
+      return scale8(255 - x[i], y[i]) + scale8(255 - y[i], x[i]);
+    });
+    FillSinTable(offset, wave_);
+    for (int i = 0; i < geometry.num_leds(); ++i) {
+      indices[i] = wave_[field[i]];
     }
   }
 
+  // scale8(255 - x, y) + scale8(255 - y, x).
+  PhaseCache field_;
+  // sin8(v + offset).
+  ByteTable wave_;
+};
+
+// Heat spreading across the wall from hot spots that flare up at random, more
+// often with a higher speed.
+class DiffusionPattern final : public PalettePattern {
+ public:
+  DiffusionPattern() : PalettePattern(HeatPalette()) {}
+
+  void Reset() override {
+    stencil_.Clear();
+    ReseedRandom(now_millis());
+  }
+
+  bool stateful() const override { return true; }
+
  private:
-  uint8_t zoom_ = 1;
-  uint8_t shape_ = 1;
-  uint8_t petals_ = 3;
-  uint8_t scale_ = 1;
+  using Cell = CellStencil::Cell;
+
+  // Share of the heat difference with each neighbor that flows per frame, out
+  // of 256. Above 256 / kNumNeighbors, the heat would oscillate.
+  static constexpr int kDiffusion = 32;
+  // Each LED loses 1 / 2^kCoolingShift of its heat per frame.
+  static constexpr int kCoolingShift = 5;
+
+  void Render(const LEDGeometry& geometry, uint8_t* indices,
+              uint8_t speed) override {
+    stencil_.Init(geometry.mapping());
+    RandomFrame random = NextRandomFrame();
+    if (random.Get8(0) < speed) {
+      // Heat up a random LED and its neighbors.
+      int led = random.Below(1, stencil_.num_leds());
+      Cell* cells = stencil_.cells();
+      cells[led] = CellStencil::kMax;
+      const uint16_t* neighbors = stencil_.neighbors(led);
+      for (int k = 0; k < CellStencil::kNumNeighbors; ++k) {
+        cells[neighbors[k]] = CellStencil::kMax;
+      }
+    }
+    stencil_.Step([](int cell, int neighbor_sum, int previous) {
+      int flow = ((neighbor_sum - CellStencil::kNumNeighbors * cell) *
+                  kDiffusion) >>
+                 8;
+      return std::max(0, cell + flow - (cell >> kCoolingShift));
+    });
+    const Cell* cells = stencil_.cells();
+    for (int i = 0; i < geometry.num_leds(); ++i) {
+      indices[i] = std::min(cells[i] >> CellStencil::kFractionBits, 255);
+    }
+  }
+
+  // Heat of each LED.
+  CellStencil stencil_;
 };
 
-class TempleBurnPattern : public Pattern {
+// Ripples from drops falling on the wall at random, more often with a higher
+// speed. The surface follows the wave equation over the LEDs. Uses the hue and
+// intensity parameters.
+class RipplePattern final : public PalettePattern {
  public:
-  void Update(LEDBuffer& buffer, uint8_t speed) override {
-    uint8_t offset = beat8(speed);
-    for (LED& led : buffer.leds()) {
-      uint8_t brightness = sin8(scale8(255 - led.x(), led.y()) +
-                                scale8(255 - led.y(), led.x()) + offset);
-      led.color().setHSV(0, 0, brightness);
+  void Reset() override {
+    stencil_.Clear();
+    ReseedRandom(now_millis());
+  }
+
+  bool stateful() const override { return true; }
+
+ private:
+  using Cell = CellStencil::Cell;
+
+  // Squared speed of the waves, out of 256. Above 256 / kNumNeighbors, waves
+  // would grow instead of spreading.
+  static constexpr int kWaveSpeed = 40;
+  // The waves lose 1 / 2^kDampingShift of their height per frame.
+  static constexpr int kDampingShift = 4;
+  static constexpr Cell kDropHeight = CellStencil::kMax;
+  static constexpr int kGain = 4;
+
+  void Render(const LEDGeometry& geometry, uint8_t* indices,
+              uint8_t speed) override {
+    stencil_.Init(geometry.mapping());
+    RandomFrame random = NextRandomFrame();
+    if (random.Get8(0) < speed / 4) {
+      // A drop raises a random LED and its neighbors.
+      int led = random.Below(1, stencil_.num_leds());
+      Cell* cells = stencil_.cells();
+      cells[led] = kDropHeight;
+      const uint16_t* neighbors = stencil_.neighbors(led);
+      for (int k = 0; k < CellStencil::kNumNeighbors; ++k) {
+        cells[neighbors[k]] = kDropHeight;
+      }
+    }
+    stencil_.Step([](int cell, int neighbor_sum, int previous) {
+      int laplacian = neighbor_sum - CellStencil::kNumNeighbors * cell;
+      int next = 2 * cell - previous + ((laplacian * kWaveSpeed) >> 8);
+      return next - (next >> kDampingShift);
+    });
+    // Crests and troughs are both bright. The waves flatten as they spread, so
+    // heights are scaled up by kGain, saturating near the drops.
+    const Cell* cells = stencil_.cells();
+    for (int i = 0; i < geometry.num_leds(); ++i) {
+      int height = cells[i] < 0 ? -cells[i] : cells[i];
+      indices[i] = std::min((height * kGain) >> CellStencil::kFractionBits, 255);
+    }
+  }
+
+  // Height of the surface at each LED.
+  CellStencil stencil_;
+};
+
+// Bursts of sparks thrown from the hand zone, in the middle of the wall, that
+// fall back and cool down. Bursts come more often with a higher speed.
+class SparksPattern final : public PalettePattern {
+ public:
+  SparksPattern() : PalettePattern(HeatPalette()) {}
+
+  void Reset() override {
+    pool_.Clear();
+    ReseedRandom(now_millis());
+  }
+
+  bool stateful() const override { return true; }
+
+ private:
+  static constexpr int kCapacity = 1024;
+  static constexpr int kSparksPerBurst = 64;
+  // Added to the downward velocity every frame.
+  static constexpr int kGravity = 4;
+  static constexpr uint8_t kDecay = 3;
+
+  void Render(const LEDGeometry& geometry, uint8_t* indices,
+              uint8_t speed) override {
+    const LEDMapping& mapping = geometry.mapping();
+    pool_.Init(kCapacity);
+    RandomFrame random = NextRandomFrame();
+    if (random.Get8(0) < speed / 4) {
+      // The LED closest to the center, see LEDMapping::radius_bucket_leds.
+      int center = mapping.radius_bucket_leds[0];
+      for (int k = 0; k < kSparksPerBurst; ++k) {
+        uint8_t direction = random.Get8(3 * k + 1);
+        // Between 0.5 and 1.5 coordinate units per frame.
+        int velocity = 128 + random.Get8(3 * k + 2);
+        pool_.Emit({.x = uint16_t(mapping.x[center] << 8),
+                    .y = uint16_t(mapping.y[center] << 8),
+                    .vx = int16_t((cos8(direction) - 128) * velocity / 128),
+                    .vy = int16_t((sin8(direction) - 128) * velocity / 128),
+                    .life = 255,
+                    .brightness = uint8_t(192 + random.Below(3 * k + 3, 64))});
+      }
+    }
+    pool_.Step(kDecay, [](Particle& spark) { spark.vy += kGravity; });
+    std::fill_n(indices, geometry.num_leds(), 0);
+    pool_.Splat(mapping, indices);
+  }
+
+  ParticlePool pool_;
+};
+
+// Embers drifting down from the top of the wall, flickering as they fall. More
+// embers fall with a higher speed.
+class EmbersPattern final : public PalettePattern {
+ public:
+  EmbersPattern() : PalettePattern(HeatPalette()) {}
+
+  void Reset() override {
+    pool_.Clear();
+    ReseedRandom(now_millis());
+  }
+
+  bool stateful() const override { return true; }
+
+ private:
+  static constexpr int kCapacity = 2048;
+  static constexpr int kGravity = 4;
+  // Fastest fall, in 8.8 coordinate units per frame. The embers that live the
+  // longest make it to the bottom of the wall.
+  static constexpr int kMaxFallSpeed = 320;
+  static constexpr int kMaxDrift = 96;
+  static constexpr uint8_t kDecay = 1;
+
+  void Render(const LEDGeometry& geometry, uint8_t* indices,
+              uint8_t speed) override {
+    pool_.Init(kCapacity);
+    RandomFrame random = NextRandomFrame();
+    int num_embers = random.Below(0, speed / 8 + 1);
+    for (int k = 0; k < num_embers; ++k) {
+      pool_.Emit({.x = random.Get16(3 * k + 1),
+                  .y = uint16_t(random.Below(3 * k + 2, 8) << 8),
+                  .vx = 0,
+                  .vy = 0,
+                  .life = uint8_t(128 + random.Below(3 * k + 3, 128)),
+                  .brightness = 255});
+    }
+    // The embers draw the numbers after the new embers', in turn.
+    uint32_t draw = 3 * num_embers + 1;
+    pool_.Step(kDecay, [&](Particle& ember) {
+      ember.vx = std::clamp(ember.vx + random.Below(draw++, 17) - 8,
+                            -kMaxDrift, kMaxDrift);
+      ember.vy = std::min(ember.vy + kGravity, kMaxFallSpeed);
+      ember.brightness = 160 + random.Below(draw++, 96);
+    });
+    std::fill_n(indices, geometry.num_leds(), 0);
+    pool_.Splat(geometry.mapping(), indices);
+  }
+
+  ParticlePool pool_;
+};
+
+// A swarm of particles chasing a point that wanders over the wall, faster with a
+// higher speed. Uses the hue and intensity parameters.
+class SwarmPattern final : public PalettePattern {
+ public:
+  void Reset() override {
+    pool_.Clear();
+    ReseedRandom(now_millis());
+  }
+
+  bool stateful() const override { return true; }
+
+ private:
+  static constexpr int kSwarmSize = 768;
+  // The pull towards the point is the distance to it divided by 2^kPullShift.
+  static constexpr int kPullShift = 12;
+  // The particles lose 1 / 2^kDragShift of their velocity per frame.
+  static constexpr int kDragShift = 5;
+  static constexpr uint8_t kBrightness = 96;
+
+  void Render(const LEDGeometry& geometry, uint8_t* indices,
+              uint8_t speed) override {
+    pool_.Init(kSwarmSize);
+    RandomFrame random = NextRandomFrame();
+    uint32_t draw = 0;
+    while (pool_.size() < kSwarmSize) {
+      pool_.Emit({.x = random.Get16(draw++),
+                  .y = random.Get16(draw++),
+                  .vx = 0,
+                  .vy = 0,
+                  .life = 255,
+                  .brightness = kBrightness});
     }
+    // The point follows a Lissajous curve.
+    int target_x = BeatSin8(speed / 4 + 1, 32, 224) << 8;
+    int target_y = BeatSin8(speed / 3 + 1, 32, 224) << 8;
+    pool_.Step(0, [&](Particle& particle) {
+      particle.vx += ((target_x - particle.x) >> kPullShift) -
+                     (particle.vx >> kDragShift) + random.Below(draw++, 33) -
+                     16;
+      particle.vy += ((target_y - particle.y) >> kPullShift) -
+                     (particle.vy >> kDragShift) + random.Below(draw++, 33) -
+                     16;
+    });
+    std::fill_n(indices, geometry.num_leds(), 0);
+    pool_.Splat(geometry.mapping(), indices);
   }
+
+  ParticlePool pool_;
+};
+
+// Plays the program set with SetProgram(), see wall/program.h. All the LEDs are
+// off until a program is set.
+class ProgramPattern final : public PalettePattern {
+ public:
+  void SetProgram(const PatternProgram& program) {
+    runner_.SetProgram(program);
+  }
+
+ private:
+  void Render(const LEDGeometry& geometry, uint8_t* indices,
+              uint8_t speed) override {
+    if (geometry_ != &geometry || origin_key_ != OriginKey()) {
+      runner_.SetLEDs(geometry.num_leds(), geometry.x(), geometry.y(),
+                      Coordinate(geometry, Domain::kAngle),
+                      Coordinate(geometry, Domain::kRadius));
+      geometry_ = &geometry;
+      origin_key_ = OriginKey();
+    }
+    runner_.Run(Beat8(speed), speed, indices);
+  }
+
+  ProgramRunner runner_;
+  // Geometry and origin given to the runner. Not owned.
+  const LEDGeometry* geometry_ = nullptr;
+  uint64_t origin_key_ = 0;
+};
+
+// Holds any of the patterns. The pattern table stores the patterns by value in
+// these, and calls them through std::visit: the call is a switch on the pattern
+// type rather than a virtual call, so the pattern's code can be inlined and
+// specialized for its exact type.
+using AnyPattern =
+    std::variant<NonePattern, SpiralPattern, WavePattern, RosePattern,
+                 CirclesPattern, AwaitTouchPattern, GlitchPattern,
+                 ClimaxPattern, RecoveryPattern, TempleBurnPattern,
+                 ProgramPattern, DiffusionPattern, RipplePattern,
+                 SparksPattern, EmbersPattern, SwarmPattern>;
+
+// Returns channel b of a layer blended over channel a below it, see BlendMode.
+inline uint8_t BlendChannel(BlendMode mode, uint8_t a, uint8_t b) {
+  switch (mode) {
+    case BlendMode::kAdd:
+      return qadd8(a, b);
+    case BlendMode::kScreen:
+      return 255 - scale8(255 - a, 255 - b);
+    case BlendMode::kMultiply:
+      return scale8(a, b);
+    case BlendMode::kNormal:
+      return b;
+    case BlendMode::kMax:
+    case BlendMode::kNumBlendModes:
+      break;
+  }
+  return std::max(a, b);
+}
+
+// Returns how far the given time is into the period that starts at
+// start_millis and lasts duration_millis, eased, from 0 to 255.
+inline fract8 EasedProgress(uint64_t now_millis, uint64_t start_millis,
+                            uint64_t duration_millis) {
+  uint64_t elapsed = now_millis - start_millis;
+  if (elapsed >= duration_millis) return 255;
+  float ratio = float(elapsed) / float(duration_millis);
+  return ease8InOutCubic(ratio * 255);
+}
+
+// A pattern playing on the LED matrix, how it fades in over the patterns that
+// were playing before it, and how it morphs from the parameters it had before.
+struct PatternLayer {
+  // Returns how much the layer covers the layers below it at the given time,
+  // from 0 (not at all) to 255 (fully).
+  fract8 Opacity(uint64_t now_millis) const {
+    return EasedProgress(now_millis, fade_start_millis, fade_duration_millis);
+  }
+
+  // Returns how far the pattern has morphed to its parameters at the given
+  // time, see Pattern::set_morph_amount().
+  fract8 MorphAmount(uint64_t now_millis) const {
+    return EasedProgress(now_millis, morph_start_millis, morph_duration_millis);
+  }
+
+  PatternId pattern_id = PatternId::kNone;
+  uint8_t speed = 60;
+  uint64_t fade_start_millis = 0;
+  uint64_t fade_duration_millis = 0;
+  uint64_t morph_start_millis = 0;
+  uint64_t morph_duration_millis = 0;
+  // A frozen layer is never re-rendered, it keeps showing its last frame.
+  bool frozen = false;
+};
+
+// A pattern drawn over the pattern playing on the LED matrix, see
+// SetLayerCommand.
+struct OverlayLayer {
+  PatternId pattern_id = PatternId::kNone;
+  uint8_t speed = 60;
+  fract8 opacity = 255;
+  BlendMode blend_mode = BlendMode::kAdd;
+  Region region = Region::kWall;
+  // Whether the palette indices of the layer were rendered since it was set.
+  bool rendered = false;
 };
 
 // Controls the LED matrix.
+//
+// Frames are double buffered: Update() renders into the back buffer while the
+// front buffer is being sent to the LEDs, then SwapBuffers() exchanges them.
+// Update() and SwapBuffers() must be called from the same task (the render
+// task); the other methods can be called from any task.
+//
+// When the pattern changes, the previous pattern becomes an outgoing layer that
+// the new pattern fades in over. Outgoing layers keep their last frame and are
+// only re-rendered every kOutgoingRefreshFrames frames, so a transition costs
+// little more than rendering the current pattern. Stateful patterns (see
+// Pattern::stateful()) would play in slow motion at that rate, so they are
+// frozen instead, and fade out from their last frame. Several transitions can
+// be in flight at once: each new pattern fades in over all the outgoing
+// layers.
+//
+// Transitions between patterns of the same family don't blend two patterns:
+// the new pattern morphs from the parameters of the previous one to its own,
+// and is the only one rendered.
+//
+// Up to SetLayerCommand::kMaxLayers overlay layers are drawn over the pattern,
+// each with its own opacity and blend mode. Only patterns that vary in
+// intensity (PalettePatterns) can be overlays: they render one palette index
+// per LED, and the colors are only looked up as the layers are blended. Layers
+// are blended one after the other, 4 color channels at a time where the blend
+// allows (see wall/swar.h). A pattern can't play in two places at once, so an
+// overlay playing the current pattern is hidden.
+//
+// An overlay limited to a region renders its pattern onto the region's own
+// mapping (see wall/regions.h), so it only computes the LEDs of the region.
+// Regions are built from the mapping the first time an overlay uses them.
+//
+// Given a frame budget, the controller times each frame and renders less of
+// the following frames while they take too long (see wall/frame_governor.h),
+// rather than slowing down.
+//
+// Frames are timed by the controller's clock, sampled once at the start of
+// each frame: the commands picked up and all the layers of the frame see the
+// same time. Given a VirtualClock, the controller plays the same frames on
+// every run. The time Update() takes is always measured on the system clock.
 class LEDController {
  public:
   LEDController();
 
-  // Initialize the LEDs with data from LED Mapper.
-  void InitLEDs(int num_leds, const std::vector<uint8_t> coordsX,
-                const std::vector<uint8_t> coordsY,
-                const std::vector<uint8_t> angles,
-                const std::vector<uint8_t> radii);
+  // Initializes the LEDs with data from LED Mapper, and moves the origin of
+  // every pattern to the mapping's. The arrays of the mapping are not copied,
+  // they must outlive the controller.
+  void InitLEDs(const LEDMapping& mapping);
 
   // Sets the current pattern to show on the LED matrix. The transition duration
-  // determines how long the pattern will blend with the previous pattern.
+  // determines how long the pattern will blend with the previous pattern. The
+  // pattern changes on the next call to Update().
   // Locks excluded: mu_.
   void SetCurrentPattern(PatternId pattern_id, uint8_t pattern_speed,
                          int transition_duration_millis);
 
-  // Call from loop().
+  // Changes some parameters of the current pattern, which morphs to them over
+  // the command's transition duration. The parameters change on the next call
+  // to Update().
+  // Locks excluded: mu_.
+  void SetPatternParams(const SetPatternParamsCommand& command);
+
+  // Sets the program played by PatternId::kProgram, from the next call to
+  // Update().
+  // Locks excluded: mu_.
+  void SetProgram(const PatternProgram& program);
+
+  // Sets one of the overlay layers, from the next call to Update().
+  // Locks excluded: mu_.
+  void SetLayer(const SetLayerCommand& command);
+
+  // Renders the next frame into the back buffer. mu_ is only held while
+  // picking up the latest pattern command, not while rendering.
   // Locks excluded: mu_.
   void Update();
 
-  // Buffer for FastLED data.
-  std::vector<CRGB>& led_data() { return led_buffer_.led_data(); }
+  // Sets the clock the frames are timed by, which must outlive the controller.
+  // Defaults to DefaultClock(). Only call from the render task.
+  void set_clock(const Clock* clock) { clock_ = clock; }
+
+  // Sets the time Update() should take, at most. 0, the default, renders
+  // everything however long it takes. Only call from the render task.
+  void set_frame_budget_micros(uint32_t budget_micros) {
+    governor_.set_budget_micros(budget_micros);
+  }
+
+  // The render quality picked for each frame, and the time spent at each. Only
+  // call from the render task.
+  const FrameGovernor& governor() const { return governor_; }
+
+  // Makes the frame rendered by the last Update() the front buffer, and returns
+  // it. The previous front buffer must no longer be in use.
+  CRGB* SwapBuffers() {
+    back_buffer_ = 1 - back_buffer_;
+    return front_buffer();
+  }
+
+  // Frame to send to the LEDs.
+  CRGB* front_buffer() { return led_buffers_[1 - back_buffer_].raw_led_data(); }
+
+  int num_leds() const { return geometry_.num_leds(); }
 
-  PatternId current_pattern_id() const { return current_pattern_id_; }
+  // Whether the pattern is frozen rather than re-rendered while it fades out,
+  // see Pattern::stateful().
+  bool IsStateful(PatternId pattern_id) {
+    return pattern(pattern_id).stateful();
+  }
 
+  // The current pattern, from the Update() that switched to it. Invalid
+  // pattern ids are ignored.
+  // Locks excluded: mu_.
+  PatternId current_pattern_id() {
+    std::lock_guard<std::mutex> lock(mu_);
+    return current_pattern_id_;
+  }
+
+  // When disabled, the LEDs are set to black.
+  // Locks excluded: mu_.
   void set_enabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(mu_);
     enabled_ = enabled;
-    // Set LED buffer to black if we want them to be off.
-    if (!enabled_) {
-      for (LED& led : led_buffer_.leds()) {
-        led.color() = CRGB::Black;
-      }
-    }
   }
 
  private:
-  void InitBuffers(int num_leds);
+  // Maximum number of outgoing layers.
+  static constexpr int kMaxOutgoingLayers = 3;
+  // Outgoing layers are re-rendered once every this many frames, one layer at a
+  // time. In between, their last frame is reused.
+  static constexpr int kOutgoingRefreshFrames = 4;
+
+  // Renders the next frame into the back buffer, at the governor's quality.
+  void RenderFrame();
+
+  // Gives all the patterns the time of the frame, see Pattern::set_frame_time.
+  void SetFrameTime(uint64_t now_micros);
+
+  // Switches to the given pattern. Only called from Update().
+  void ApplyCommand(const SetPatternCommand& command);
+
+  // Morphs the current pattern to the given pattern of the same family.
+  void MorphTo(const SetPatternCommand& command);
+
+  // Changes the parameters of the current pattern. Only called from Update().
+  void ApplyParamsCommand(const SetPatternParamsCommand& command);
+
+  // Renders the given layer into the buffer, as it is at the given time.
+  void Render(const PatternLayer& layer, uint64_t now_millis,
+              LEDBuffer& buffer);
+
+  // Removes the outgoing layers that are fully covered at the given time, and
+  // returns the opacity of the current layer.
+  fract8 DropHiddenLayers(uint64_t now_millis);
+
+  // Changes an overlay layer. Only called from Update().
+  void ApplyLayerCommand(const SetLayerCommand& command);
+
+  // Whether one of the overlays plays the pattern.
+  bool IsOverlayPattern(PatternId pattern_id) const {
+    if (pattern_id == PatternId::kNone) return false;
+    for (const OverlayLayer& overlay : overlays_) {
+      if (overlay.pattern_id == pattern_id) return true;
+    }
+    return false;
+  }
+
+  // An overlay layer, rendered for the current frame. indices[j] is the
+  // palette index of LED leds[j], or of LED j if leds is null (the whole wall).
+  struct RenderedOverlay {
+    const Palette* palette;
+    const uint8_t* indices;
+    const uint16_t* leds;
+    int num_leds;
+    fract8 opacity;
+    BlendMode blend_mode;
+  };
+
+  // Returns the geometry of the LEDs in the region, building it if needed.
+  const LEDGeometry& RegionGeometry(Region region);
+
+  // Returns the LEDs of the region, or null for the whole wall.
+  const uint16_t* RegionLEDs(Region region) const {
+    if (region == Region::kWall) return nullptr;
+    return regions_[int(region)]->region.leds();
+  }
+
+  // Renders the visible overlay layers, and returns how many there are. At
+  // RenderQuality::kHalfRateOverlays, each layer is only rendered every other
+  // frame, and keeps its palette indices in between.
+  int RenderOverlays(RenderedOverlay* overlays);
+
+  // Blends the outgoing layers under the current pattern's frame, which is in
+  // buffer, and the overlays over it, each over the LEDs of its region.
+  void Composite(uint64_t now_millis, fract8 current_opacity,
+                 const RenderedOverlay* overlays, int num_overlays,
+                 LEDBuffer& buffer);
 
   // Protects members from concurrent access.
   std::mutex mu_;
 
+  // Guarded by mu_.
   bool enabled_ = true;
+  // Latest command received since the last frame. Guarded by mu_.
+  std::optional<SetPatternCommand> pending_command_;
+  // Parameter changes received since the last frame, merged. Guarded by mu_.
+  std::optional<SetPatternParamsCommand> pending_params_command_;
+  // Latest program received since the last frame. Guarded by mu_.
+  std::optional<PatternProgram> pending_program_;
+  // Latest command for each overlay layer since the last frame. Guarded by
+  // mu_.
+  std::optional<SetLayerCommand>
+      pending_layer_commands_[SetLayerCommand::kMaxLayers];
+  // Mirrors the current pattern for current_pattern_id(), once ApplyCommand()
+  // accepted it. Guarded by mu_.
+  PatternId current_pattern_id_ = PatternId::kRecovery;
 
-  std::vector<std::unique_ptr<Pattern>> patterns_;
+  // The members below are only accessed by the render task.
 
-  // The buffer that FastLED points to.
-  LEDBuffer led_buffer_;
-  // This buffer isn't connected to FastLED. It is used to blend the previous
-  // animation into the current one.
-  LEDBuffer previous_buffer_;
+  const Clock* clock_ = &DefaultClock();
+  // Time of the frame being rendered, from clock_, in milliseconds.
+  uint64_t now_millis_ = 0;
 
-  // Time at which the current pattern started playing.
-  uint64_t transition_start_millis_ = 0;
-  // Duration of the pattern transition.
-  uint64_t transition_duration_millis_ = 0;
+  // Returns the pattern playing the given id.
+  Pattern& pattern(PatternId pattern_id) {
+    return std::visit([](Pattern& pattern) -> Pattern& { return pattern; },
+                      patterns_[pattern_id]);
+  }
 
-  // TODO: create a struct for that crap.
-  PatternId previous_pattern_id_ = PatternId::kNone;
-  uint8_t previous_pattern_speed_ = 60;
-  PatternId current_pattern_id_ = PatternId::kRecovery;
-  uint8_t current_pattern_speed_ = 60;
+  // One pattern per PatternId.
+  std::array<AnyPattern, PatternId::kNumPatternIds> patterns_;
+
+  // Position of each LED, shared by all the buffers.
+  LEDGeometry geometry_;
+
+  // A region, and the geometry of its LEDs, which patterns render onto.
+  struct RegionLayout {
+    LEDRegion region;
+    LEDGeometry geometry;
+  };
+  // The regions used by overlays so far, by Region. The whole wall is
+  // geometry_.
+  std::optional<RegionLayout> regions_[int(Region::kNumRegions)];
+
+  // Front and back buffers. FastLED shows the front buffer.
+  LEDBuffer led_buffers_[2];
+  // Index of the back buffer in led_buffers_.
+  int back_buffer_ = 0;
+
+  PatternLayer current_layer_{.pattern_id = PatternId::kRecovery};
+  // Patterns being faded out, oldest first. The last frame of
+  // outgoing_layers_[i] is in outgoing_buffers_[i].
+  PatternLayer outgoing_layers_[kMaxOutgoingLayers];
+  LEDBuffer outgoing_buffers_[kMaxOutgoingLayers];
+  int num_outgoing_layers_ = 0;
+
+  // The overlays, bottom first. overlay_indices_[i] holds the palette indices
+  // of the LEDs in the region of overlays_[i], allocated once the layer is
+  // first used.
+  OverlayLayer overlays_[SetLayerCommand::kMaxLayers];
+  std::vector<uint8_t> overlay_indices_[SetLayerCommand::kMaxLayers];
+
+  // One color per LED, for Composite() to blend layers from.
+  std::vector<CRGB> composite_scratch_;
+
+  // Number of frames rendered, used to schedule outgoing layer refreshes.
+  uint32_t frame_count_ = 0;
+
+  // Picks how much of each frame to render.
+  FrameGovernor governor_;
 };
 
 #endif  // INCLUDE_WALL_ANIMATION_H_
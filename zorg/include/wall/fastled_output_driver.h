@@ -0,0 +1,30 @@
+#ifndef INCLUDE_WALL_FASTLED_OUTPUT_DRIVER_H_
+#define INCLUDE_WALL_FASTLED_OUTPUT_DRIVER_H_
+
+#include <FastLED.h>
+
+#include <vector>
+
+#include "wall/led_mapper_data.h"
+#include "wall/output_driver.h"
+
+// Sends frames with FastLED, one FastLED controller per segment. On the ESP32,
+// FastLED's clockless driver sends to all its controllers at once through the
+// RMT peripheral, which has kMaxSegments channels.
+class FastLEDOutputDriver : public OutputDriver {
+ public:
+  static constexpr int kMaxSegments = 8;
+
+  // Adds a FastLED controller of the chipset for each segment. Returns false,
+  // and adds none, if there are too many segments or a segment's pin can't
+  // drive LEDs.
+  bool Init(const std::vector<LEDSegment>& segments, LEDChipset chipset);
+
+  void Show(const CRGB* leds) override;
+
+ private:
+  std::vector<LEDSegment> segments_;
+  std::vector<CLEDController*> controllers_;
+};
+
+#endif  // INCLUDE_WALL_FASTLED_OUTPUT_DRIVER_H_
@@ -0,0 +1,72 @@
+#ifndef INCLUDE_WALL_FRAME_GOVERNOR_H_
+#define INCLUDE_WALL_FRAME_GOVERNOR_H_
+
+#include <cstdint>
+
+// How much of each frame LEDController renders, from the most to the least.
+// Each quality also makes the savings of the ones above it.
+enum class RenderQuality : uint8_t {
+  // Everything, every frame.
+  kFull,
+  // Outgoing layers are re-rendered half as often.
+  kHalfRateOutgoing,
+  // Overlays are re-rendered every other frame, and keep their palette indices
+  // in between. They are still blended every frame.
+  kHalfRateOverlays,
+  // Outgoing layers aren't re-rendered at all: they fade out from their last
+  // frame, and pick up again once the quality steps back up.
+  kFrozenOutgoing,
+  kNumQualities,
+};
+
+// Keeps the time it takes to render a frame within a budget: lowers the render
+// quality while frames take too long, and raises it back once they take well
+// under the budget.
+//
+// Decisions are made on a running average of the frame times, and only once
+// frames have been rendered long enough at the current quality for the average
+// to show its cost: a few frames to step down, so a slow patch is cut short,
+// and many more to step back up, so the quality doesn't flip back and forth.
+class FrameGovernor {
+ public:
+  static constexpr int kNumQualities = int(RenderQuality::kNumQualities);
+
+  struct Stats {
+    // Times the quality was lowered, and raised.
+    uint32_t steps_down = 0;
+    uint32_t steps_up = 0;
+    // Frames rendered, and time spent rendering them, at each quality.
+    uint32_t frames[kNumQualities] = {};
+    uint64_t micros[kNumQualities] = {};
+  };
+
+  // 0, the default, keeps the quality at kFull.
+  void set_budget_micros(uint32_t budget_micros);
+  uint32_t budget_micros() const { return budget_micros_; }
+
+  // Quality to render the next frame at.
+  RenderQuality quality() const { return quality_; }
+
+  // Records the time the last frame took to render, at quality(), and picks
+  // the quality of the next frame.
+  void Record(uint32_t frame_micros);
+
+  const Stats& stats() const { return stats_; }
+
+ private:
+  // Frames to render at a quality before stepping down, and up, from it.
+  static constexpr int kStepDownFrames = 8;
+  static constexpr int kStepUpFrames = 60;
+  // The quality steps up once the average is under this many 16ths of the
+  // budget.
+  static constexpr int kHeadroomSixteenths = 12;
+
+  uint32_t budget_micros_ = 0;
+  RenderQuality quality_ = RenderQuality::kFull;
+  // Running average of the frame times, in 16ths of a microsecond.
+  int32_t average_ = 0;
+  int frames_at_quality_ = 0;
+  Stats stats_;
+};
+
+#endif  // INCLUDE_WALL_FRAME_GOVERNOR_H_
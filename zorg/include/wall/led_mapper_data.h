@@ -1,22 +1,103 @@
-// This file contains the LED Mapper data.
-// To use the actual wall data, set the ACTUAL_WALL preprocessor variable when
-// building the binary (-DACTUAL_WALL).
+// This file contains the LED Mapper data of every wall variant. A wall picks
+// its variant at boot, so the same image runs on all the walls.
+//
+// The data is generated by tools/generate_led_mapping.py.
 #ifndef INCLUDE_WALL_LED_MAPPER_DATA_H_
 #define INCLUDE_WALL_LED_MAPPER_DATA_H_
 
 #include <cstdint>
-#include <vector>
-
-// Number of LEDs.
-extern const int kNumLeds;
-
-// X coordinate, between 0-255.
-extern std::vector<uint8_t> coordsX;
-// Y coordinate, between 0-255.
-extern std::vector<uint8_t> coordsY;
-// Angle from center, between 0-255.
-extern std::vector<uint8_t> angles;
-// Radius from center, between 0-255.
-extern std::vector<uint8_t> radii;
+
+// The LED positions of a wall, and indexes derived from them. The arrays are
+// not owned, and must outlive the mapping.
+struct LEDMapping {
+  // Size of the spatial grid, in cells along x and y.
+  static constexpr int kGridSize = 16;
+  static constexpr int kNumGridCells = kGridSize * kGridSize;
+  // Width of a grid cell, in coordinate units.
+  static constexpr int kGridCellSize = 256 / kGridSize;
+  // Number of neighbor slots of each LED.
+  static constexpr int kNumNeighbors = 6;
+
+  // Returns the grid cell containing a position.
+  static constexpr int GridCell(uint8_t x, uint8_t y) {
+    return (y / kGridCellSize) * kGridSize + x / kGridCellSize;
+  }
+
+  int num_leds;
+  // X coordinate, between 0-255.
+  const uint8_t* x;
+  // Y coordinate, between 0-255.
+  const uint8_t* y;
+  // Angle from center, between 0-255.
+  const uint8_t* angle;
+  // Radius from center, between 0-255.
+  const uint8_t* radius;
+  // The center the angles and radii are measured from, in LED coordinates:
+  // LED Mapper's, which is not quite (128, 128). It is the patterns' default
+  // origin, see Pattern::Coordinate().
+  uint8_t origin_x;
+  uint8_t origin_y;
+
+  // The LEDs grouped by radius. Bucket b holds the LEDs of radius
+  // unique_radii[b], which are radius_bucket_leds[radius_bucket_starts[b]] up
+  // to (excluding) radius_bucket_leds[radius_bucket_starts[b + 1]]. Radii are
+  // in increasing order.
+  int num_radius_buckets;
+  const uint8_t* unique_radii;
+  const uint16_t* radius_bucket_starts;
+  const uint16_t* radius_bucket_leds;
+
+  // The LEDs grouped by grid cell, laid out like the radius buckets: cell c
+  // holds grid_cell_leds[grid_cell_starts[c]] up to (excluding)
+  // grid_cell_leds[grid_cell_starts[c + 1]]. See GridCell().
+  const uint16_t* grid_cell_starts;
+  const uint16_t* grid_cell_leds;
+
+  // The neighbors of LED i are in neighbors[i * kNumNeighbors] to
+  // neighbors[(i + 1) * kNumNeighbors - 1], closest first. Two LEDs are
+  // neighbors when each is among the kNumNeighbors closest LEDs of the other,
+  // so the graph is symmetric, which keeps the stencils built on it (see
+  // wall/stencil.h) stable. The slots after the last neighbor hold i itself.
+  const uint16_t* neighbors;
+};
+
+// A run of consecutive LEDs chained on one data pin.
+struct LEDSegment {
+  uint16_t first_led;
+  uint16_t num_leds;
+  uint8_t pin;
+};
+
+// How the LEDs of a wall are wired: segments in LED order, each on its own
+// data pin, sent to in parallel. Not owned, like the arrays of LEDMapping.
+struct LEDSegmentLayout {
+  int num_segments;
+  const LEDSegment* segments;
+};
+
+// The LED chips of a wall, which set the timing of the data and the order of
+// the channels on the wire.
+enum class LEDChipset : uint8_t {
+  // WS2812B, green-red-blue, as in the test LED matrix.
+  kWS2812GRB,
+  // WS2811, blue-red-green, as in the actual wall.
+  kWS2811BRG,
+};
+
+// A wall the firmware has the mapping and wiring of, in flash.
+struct LEDWallVariant {
+  // Name of the variant's LED Mapper export in tools/led_mapper, without the
+  // extension.
+  const char* name;
+  LEDMapping mapping;
+  LEDSegmentLayout segments;
+  LEDChipset chipset;
+};
+
+constexpr int kNumLEDWallVariants = 4;
+extern const LEDWallVariant kLEDWallVariants[kNumLEDWallVariants];
+
+// Returns the variant with the name, or nullptr if there is none.
+const LEDWallVariant* FindLEDWallVariant(const char* name);
 
 #endif  // INCLUDE_WALL_LED_MAPPER_DATA_H_
@@ -0,0 +1,62 @@
+// The binary format of the LED mappings uploaded to the walls at runtime.
+//
+// A blob is a header followed by the arrays of LEDMapping, laid out so that the
+// mapping can point straight into the blob:
+//
+//   MappingBlobHeader
+//   uint16_t radius_bucket_starts[num_radius_buckets + 1]
+//   uint16_t radius_bucket_leds[num_leds]
+//   uint16_t grid_cell_starts[LEDMapping::kNumGridCells + 1]
+//   uint16_t grid_cell_leds[num_leds]
+//   uint16_t neighbors[num_leds * LEDMapping::kNumNeighbors]
+//   uint8_t x[num_leds]
+//   uint8_t y[num_leds]
+//   uint8_t angle[num_leds]
+//   uint8_t radius[num_leds]
+//   uint8_t unique_radii[num_radius_buckets]
+//
+// All the values are little-endian. Blobs are generated from LED Mapper exports
+// by tools/generate_led_mapping.py --blob.
+#ifndef INCLUDE_WALL_MAPPING_BLOB_H_
+#define INCLUDE_WALL_MAPPING_BLOB_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "wall/led_mapper_data.h"
+
+struct MappingBlobHeader {
+  // "LEDM".
+  static constexpr uint32_t kMagic = 0x4d44454c;
+  static constexpr uint8_t kVersion = 2;
+
+  uint32_t magic;
+  uint8_t version;
+  // Must match LEDMapping::kGridSize and LEDMapping::kNumNeighbors.
+  uint8_t grid_size;
+  uint8_t num_neighbors;
+  uint8_t reserved;
+  uint16_t num_leds;
+  uint16_t num_radius_buckets;
+  // LEDMapping::origin_x and LEDMapping::origin_y.
+  uint8_t origin_x;
+  uint8_t origin_y;
+  uint8_t padding[2];
+  // CRC-32 of everything after the header.
+  uint32_t crc32;
+};
+static_assert(sizeof(MappingBlobHeader) == 20);
+
+// Returns the size of a blob with the given header.
+size_t MappingBlobSize(const MappingBlobHeader& header);
+
+// Returns the mapping stored in a blob, pointing into the blob, or nothing if
+// the blob is not a valid mapping. The blob must be 2-byte aligned, and outlive
+// the mapping.
+//
+// Besides the checksum, every index in the blob is checked to be in range, so a
+// mapping that parses can't make the patterns read out of bounds.
+std::optional<LEDMapping> ParseMappingBlob(const uint8_t* blob, size_t size);
+
+#endif  // INCLUDE_WALL_MAPPING_BLOB_H_
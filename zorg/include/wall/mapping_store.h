@@ -0,0 +1,90 @@
+#ifndef INCLUDE_WALL_MAPPING_STORE_H_
+#define INCLUDE_WALL_MAPPING_STORE_H_
+
+#include <Preferences.h>
+#include <esp_partition.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include "wall/led_mapper_data.h"
+
+// Keeps the LED mapping uploaded from the PC (see wall/mapping_blob.h) in the
+// "mapping" flash partition, see partitions.csv. At boot the stored mapping is
+// mapped into the address space, so the patterns read it straight from flash,
+// like the compiled-in mapping.
+//
+// The partition has two slots. Uploads go to the slot not in use, so an
+// interrupted or corrupted upload leaves the stored mapping alone. The slot in
+// use is kept in the preferences.
+class MappingStore {
+ public:
+  // Largest blob, the flash is mapped in pages of this size.
+  static constexpr size_t kSlotSize = 64 * 1024;
+
+  // The preferences must be open, and outlive the store.
+  explicit MappingStore(Preferences* prefs) : prefs_(prefs) {}
+
+  // Returns the stored mapping, or nothing if no valid mapping was uploaded.
+  // The mapping stays valid until the wall restarts.
+  std::optional<LEDMapping> Load();
+
+  // What became of a chunk given to WriteChunk().
+  enum class ChunkStatus {
+    // The chunk was written.
+    kWritten,
+    // The chunk doesn't follow the last one written, and was dropped. The
+    // upload goes on from next_offset().
+    kOutOfOrder,
+    // The upload doesn't fit in a slot, or the flash couldn't be written. The
+    // upload was dropped.
+    kFailed,
+  };
+
+  // Writes a chunk of an upload. A chunk at offset 0 starts a new upload of
+  // total_size bytes, which must hold at least a blob header, the other chunks
+  // must follow the previous one. Erases and writes flash, so it blocks for a
+  // while: don't call it from the WiFi task.
+  ChunkStatus WriteChunk(uint32_t offset, uint32_t total_size,
+                         const uint8_t* data, size_t size);
+
+  // Offset of the chunk the current upload expects next, 0 if there is no
+  // upload (a chunk at offset 0 starts one).
+  uint32_t next_offset() const {
+    return upload_slot_ >= 0 ? upload_offset_ : 0;
+  }
+
+  // Whether all the bytes of the current upload were written.
+  bool upload_complete() const {
+    return upload_slot_ >= 0 && upload_offset_ == upload_size_;
+  }
+
+  // Checks the uploaded mapping and, if it is valid and exactly as large as
+  // the upload, makes it the stored mapping from the next restart on. Returns
+  // whether it was valid.
+  bool FinishUpload();
+
+ private:
+  // Returns the mapping partition, or nullptr if the partition table has none.
+  static const esp_partition_t* Partition();
+
+  // Maps a slot, and returns the mapping it holds if it is valid. If size is
+  // given, it is set to the size of the valid blob.
+  std::optional<LEDMapping> MapSlot(int slot, spi_flash_mmap_handle_t* handle,
+                                    size_t* size = nullptr) const;
+
+  // Not owned.
+  Preferences* prefs_;
+  // The slot of the stored mapping, -1 if there is none.
+  int stored_slot_ = -1;
+  // The slot being uploaded to, -1 if there is no upload.
+  int upload_slot_ = -1;
+  uint32_t upload_size_ = 0;
+  // Bytes written so far.
+  uint32_t upload_offset_ = 0;
+  // Bytes of the slot erased so far, a multiple of the flash sector size.
+  uint32_t erased_size_ = 0;
+};
+
+#endif  // INCLUDE_WALL_MAPPING_STORE_H_
@@ -0,0 +1,93 @@
+#ifndef INCLUDE_WALL_OUTPUT_DRIVER_H_
+#define INCLUDE_WALL_OUTPUT_DRIVER_H_
+
+#include <FastLED.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "wall/led_mapper_data.h"
+
+// Sending frames to the LEDs, which are wired in segments (see
+// LEDSegmentLayout). Each segment is a chain of WS2811 LEDs on its own data
+// pin, and the segments are sent to in parallel, so a frame takes as long on
+// the wire as its longest segment.
+
+// Order in which the channels of an LED go on the wire, as indexes into
+// CRGB::raw.
+struct ChannelOrder {
+  uint8_t channels[3];
+};
+
+constexpr ChannelOrder kRGBOrder = {{0, 1, 2}};
+constexpr ChannelOrder kGRBOrder = {{1, 0, 2}};
+constexpr ChannelOrder kBRGOrder = {{2, 0, 1}};
+
+// How long frames take on the wire. Each LED takes 24 bits at 800 kHz, and the
+// line is then held low so the LEDs latch the frame.
+struct WireTimeModel {
+  uint32_t nanos_per_bit = 1250;
+  uint32_t latch_micros = 50;
+
+  // Time to send a segment of num_leds LEDs.
+  uint32_t SegmentMicros(int num_leds) const {
+    return (uint64_t(num_leds) * 24 * nanos_per_bit + 999) / 1000 +
+           latch_micros;
+  }
+
+  // Time to send a frame to all the segments, in parallel.
+  uint32_t FrameMicros(const std::vector<LEDSegment>& segments) const;
+};
+
+// Returns the segments of the layout, fitted to num_leds LEDs: segments past
+// the last LED are dropped or shortened, and the last segment takes any LEDs
+// past the end of the layout. Lets a wall play an uploaded mapping with a
+// different number of LEDs.
+std::vector<LEDSegment> FitSegments(const LEDSegmentLayout& layout,
+                                    int num_leds);
+
+// Returns num_leds LEDs split into segments of about the same length, one per
+// pin. For trying out layouts.
+std::vector<LEDSegment> SplitSegments(int num_leds,
+                                      const std::vector<uint8_t>& pins);
+
+// Sends frames to the LEDs of a set of segments.
+class OutputDriver {
+ public:
+  virtual ~OutputDriver() = default;
+
+  // Sends a frame: leds holds the LEDs of all the segments, in LED order.
+  // Returns once leds can be changed.
+  virtual void Show(const CRGB* leds) = 0;
+};
+
+// Driver that sends nothing, and records the bytes each segment would have
+// been sent instead. Runs anywhere, to try out segment layouts.
+class MockOutputDriver : public OutputDriver {
+ public:
+  MockOutputDriver(std::vector<LEDSegment> segments, ChannelOrder order,
+                   WireTimeModel model = {});
+
+  void Show(const CRGB* leds) override;
+
+  const std::vector<LEDSegment>& segments() const { return segments_; }
+
+  // The bytes the segment was sent for the last frame, in wire order.
+  const std::vector<uint8_t>& bytes(int segment) const {
+    return bytes_[segment];
+  }
+
+  // Modeled time on the wire of each frame.
+  uint32_t frame_micros() const { return frame_micros_; }
+
+  int num_frames() const { return num_frames_; }
+
+ private:
+  std::vector<LEDSegment> segments_;
+  ChannelOrder order_;
+  uint32_t frame_micros_;
+  std::vector<std::vector<uint8_t>> bytes_;
+  int num_frames_ = 0;
+};
+
+#endif  // INCLUDE_WALL_OUTPUT_DRIVER_H_
@@ -0,0 +1,96 @@
+#ifndef INCLUDE_WALL_OUTPUT_STAGE_H_
+#define INCLUDE_WALL_OUTPUT_STAGE_H_
+
+#include <FastLED.h>
+
+#include <cstdint>
+#include <vector>
+
+// Brightness of the whole wall over time: a triangle wave that rises from
+// min_brightness to max_brightness and falls back, once per period.
+struct BrightnessEnvelope {
+  uint8_t min_brightness = 10;
+  uint8_t max_brightness = 255;
+  uint32_t period_millis = 8000;
+
+  uint8_t At(uint32_t now_millis) const;
+};
+
+// Current drawn by the LEDs, following FastLED's power model: each channel
+// draws in proportion to its value, and each LED draws a little even when
+// dark.
+struct PowerModel {
+  // Current drawn by a channel at 255, in mA.
+  uint16_t red_milliamps = 16;
+  uint16_t green_milliamps = 11;
+  uint16_t blue_milliamps = 15;
+  // Current drawn by a dark LED, in mA.
+  uint16_t dark_milliamps = 1;
+};
+
+// Turns the frames rendered by LEDController into the frames sent to the LEDs,
+// in a single pass over the LEDs: each channel goes through a gamma and white
+// balance table, then is scaled by the brightness envelope, lowered if needed
+// to keep the LEDs within a power budget.
+//
+// The pass also adds up the current the frame draws at full brightness, which
+// sets the power limit of the next frame: frames usually draw about as much as
+// the previous one. When a frame draws more than the limit allows, the pass is
+// run again with a lower limit, so the budget is never exceeded.
+class OutputStage {
+ public:
+  struct Options {
+    // Each channel, from 0 to 1, is raised to this power. 1 keeps channels
+    // linear.
+    float gamma = 1.0f;
+    // Value of each channel for white, like FastLED's color corrections.
+    CRGB white_balance = CRGB(255, 255, 255);
+    BrightnessEnvelope envelope;
+    PowerModel power_model;
+    // Most current the LEDs may draw, in mA. 0 disables the limit.
+    uint32_t power_budget_milliamps = 0;
+  };
+
+  // Builds the tables and the output buffer, for num_leds LEDs.
+  void Init(int num_leds, const Options& options);
+
+  // Writes the frame to show at the given time to leds(), from the rendered
+  // frame.
+  void Apply(uint32_t now_millis, const CRGB* frame);
+
+  // The frame to send to the LEDs.
+  CRGB* leds() { return leds_.data(); }
+  int num_leds() const { return leds_.size(); }
+
+  // Brightness the last frame was scaled by, after the power limit.
+  uint8_t scale() const { return scale_; }
+  // Whether the power limit lowered the brightness of the last frame.
+  bool power_limited() const { return scale_ < brightness_; }
+  // Current drawn by the last frame, in mA.
+  uint32_t draw_milliamps() const { return draw_milliamps_; }
+
+ private:
+  // Writes the frame scaled by scale to leds_, and returns its draw at full
+  // brightness, without the dark LEDs, in 255ths of a mA.
+  uint32_t Pass(const CRGB* frame, uint8_t scale);
+
+  // Largest scale that keeps a frame of the given full brightness draw within
+  // the budget.
+  uint8_t LimitScale(uint32_t full_draw) const;
+
+  // Current drawn by a frame of the given full brightness draw, scaled.
+  uint32_t DrawMilliamps(uint32_t full_draw, uint8_t scale) const;
+
+  Options options_;
+  // Gamma and white balance of each channel.
+  uint8_t tables_[3][256];
+  std::vector<CRGB> leds_;
+  // Full brightness draw of the last frame.
+  uint32_t full_draw_ = 0;
+  // Brightness of the last frame, from the envelope.
+  uint8_t brightness_ = 0;
+  uint8_t scale_ = 0;
+  uint32_t draw_milliamps_ = 0;
+};
+
+#endif  // INCLUDE_WALL_OUTPUT_STAGE_H_
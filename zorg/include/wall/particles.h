@@ -0,0 +1,132 @@
+#ifndef INCLUDE_WALL_PARTICLES_H_
+#define INCLUDE_WALL_PARTICLES_H_
+
+#include <FastLED.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "wall/led_mapper_data.h"
+
+// A point moving over the wall, in 8.8 fixed point coordinate units: x >> 8 is
+// the x coordinate of the LEDs, between 0 and 255, and a velocity of 256 moves
+// the particle by one coordinate unit per frame.
+struct Particle {
+  uint16_t x;
+  uint16_t y;
+  int16_t vx;
+  int16_t vy;
+  // Frames left, roughly: see ParticlePool::Step().
+  uint8_t life;
+  // Intensity of the particle at full life.
+  uint8_t brightness;
+};
+
+// A fixed number of particles, moved once per frame and drawn onto the LEDs.
+//
+// The storage is allocated once, by the first Init(). Emitting and removing
+// particles never allocates: particles are added at the end, and a dying
+// particle is replaced by the last one. Emitting into a full pool drops the
+// particle.
+//
+// Particles are drawn as small discs of kSplatRadius. Each particle only looks
+// at the LEDs of the grid cells under its disc (see LEDMapping::GridCell), not
+// at all the LEDs.
+class ParticlePool {
+ public:
+  // Radius of the disc drawn for each particle, in coordinate units. At most
+  // half a grid cell, so a disc covers at most 2x2 cells.
+  static constexpr int kSplatRadius = 8;
+  static_assert(2 * kSplatRadius <= LEDMapping::kGridCellSize);
+
+  // Sets the capacity of the pool, which must not change afterwards.
+  void Init(int capacity) {
+    if (!particles_.empty()) return;
+    particles_.resize(capacity);
+    for (int d2 = 0; d2 <= kSplatRadius * kSplatRadius; ++d2) {
+      falloff_[d2] = 255 - d2 * 255 / (kSplatRadius * kSplatRadius);
+    }
+    falloff_.back() = 0;
+  }
+
+  int capacity() const { return particles_.size(); }
+  int size() const { return size_; }
+  const Particle* particles() const { return particles_.data(); }
+
+  // Removes all the particles.
+  void Clear() { size_ = 0; }
+
+  // Adds a particle, unless the pool is full.
+  void Emit(const Particle& particle) {
+    if (size_ < capacity()) particles_[size_++] = particle;
+  }
+
+  // Moves every particle by one frame. accelerate(particle) first changes the
+  // particle's velocity, then the particle moves by it and loses decay life.
+  // Particles with no life left, or that leave the wall, are removed.
+  template <typename Fn>
+  void Step(uint8_t decay, Fn accelerate) {
+    for (int i = 0; i < size_;) {
+      Particle& particle = particles_[i];
+      accelerate(particle);
+      int x = particle.x + particle.vx;
+      int y = particle.y + particle.vy;
+      particle.life = qsub8(particle.life, decay);
+      if (particle.life == 0 || x < 0 || x > UINT16_MAX || y < 0 ||
+          y > UINT16_MAX) {
+        particle = particles_[--size_];
+        continue;
+      }
+      particle.x = x;
+      particle.y = y;
+      ++i;
+    }
+  }
+
+  // Adds the intensity of every particle to the LEDs it covers, saturating. A
+  // particle's intensity is its brightness scaled by its life, and fades out
+  // towards the edge of its disc.
+  void Splat(const LEDMapping& mapping, uint8_t* intensities) const {
+    constexpr int kCellSize = LEDMapping::kGridCellSize;
+    constexpr int kRadius2 = kSplatRadius * kSplatRadius;
+    for (int p = 0; p < size_; ++p) {
+      const Particle& particle = particles_[p];
+      uint8_t intensity = scale8(particle.brightness, particle.life);
+      if (intensity == 0) continue;
+      int px = particle.x >> 8;
+      int py = particle.y >> 8;
+      int min_x = std::max(px - kSplatRadius, 0) / kCellSize;
+      int max_x = std::min(px + kSplatRadius, 255) / kCellSize;
+      int min_y = std::max(py - kSplatRadius, 0) / kCellSize;
+      int max_y = std::min(py + kSplatRadius, 255) / kCellSize;
+      // The cells of a grid row are next to each other in grid_cell_leds, so
+      // each row of cells under the disc is a single run of LEDs.
+      for (int cy = min_y; cy <= max_y; ++cy) {
+        int row = cy * LEDMapping::kGridSize;
+        int end = mapping.grid_cell_starts[row + max_x + 1];
+        for (int j = mapping.grid_cell_starts[row + min_x]; j < end; ++j) {
+          int led = mapping.grid_cell_leds[j];
+          int dx = mapping.x[led] - px;
+          int dy = mapping.y[led] - py;
+          // Most LEDs of the cells are outside the disc. They add 0 rather than
+          // being skipped, which is faster than mispredicting a branch.
+          int d2 = std::min(dx * dx + dy * dy, kRadius2 + 1);
+          intensities[led] =
+              qadd8(intensities[led], scale8(intensity, falloff_[d2]));
+        }
+      }
+    }
+  }
+
+ private:
+  std::vector<Particle> particles_;
+  // Particles in use, the first size_ of particles_.
+  int size_ = 0;
+  // Intensity at each squared distance from a particle, out of 255. The last
+  // entry is for all the distances outside the disc.
+  std::array<uint8_t, kSplatRadius * kSplatRadius + 2> falloff_;
+};
+
+#endif  // INCLUDE_WALL_PARTICLES_H_
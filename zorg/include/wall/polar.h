@@ -0,0 +1,57 @@
+#ifndef INCLUDE_WALL_POLAR_H_
+#define INCLUDE_WALL_POLAR_H_
+
+#include <cstdint>
+#include <vector>
+
+// Polar coordinates of the LEDs around any point of the wall, computed with
+// table lookups instead of floating point math, fast enough to follow a point
+// that moves every frame.
+//
+// The angle of a position around an origin is atan2(origin_y - y,
+// origin_x - x), in 256ths of a turn, as LED Mapper's, and its radius is its
+// distance to the origin times sqrt(2), capped at 255, so that the corners of
+// the wall are at radius 255 from its center.
+//
+// Around the mapping's own origin (see LEDMapping), patterns read LED Mapper's
+// angles and radii instead. LED Mapper scales its radii so that the farthest
+// LED is at 255, so they are up to about 8% off the ones computed here.
+
+// Returns the angle of the vector (dx, dy), where dx and dy are between -255
+// and 255, in 256ths of a turn from the x axis towards the y axis. Within 1 of
+// the exact angle.
+uint8_t PolarAngle(int dx, int dy);
+
+// Returns the length of the vector (dx, dy) times sqrt(2), capped at 255, where
+// dx and dy are between -255 and 255. Within 1 of the exact length.
+uint8_t PolarRadius(int dx, int dy);
+
+// Fills angle[i] and radius[i] with the polar coordinates of the position
+// (x[i], y[i]) around (origin_x, origin_y), for num_leds positions.
+void ComputePolarCoordinates(int num_leds, const uint8_t* x, const uint8_t* y,
+                             uint8_t origin_x, uint8_t origin_y,
+                             uint8_t* angle, uint8_t* radius);
+
+// The polar coordinates of the LEDs around an origin, recomputed when the
+// origin moves.
+class PolarCoordinates {
+ public:
+  // Computes the coordinates of the LEDs around the origin, unless they were
+  // last computed for the same origin and LEDs.
+  void Update(int num_leds, const uint8_t* x, const uint8_t* y,
+              uint8_t origin_x, uint8_t origin_y);
+
+  const uint8_t* angle() const { return angle_.data(); }
+  const uint8_t* radius() const { return radius_.data(); }
+
+ private:
+  // LEDs and origin the coordinates were computed for. Not owned.
+  const uint8_t* x_ = nullptr;
+  const uint8_t* y_ = nullptr;
+  uint8_t origin_x_ = 0;
+  uint8_t origin_y_ = 0;
+  std::vector<uint8_t> angle_;
+  std::vector<uint8_t> radius_;
+};
+
+#endif  // INCLUDE_WALL_POLAR_H_
@@ -0,0 +1,136 @@
+#ifndef INCLUDE_WALL_PROGRAM_H_
+#define INCLUDE_WALL_PROGRAM_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+// Operations of the pattern bytecode. The values are part of the bytecode
+// format, never reorder them.
+enum class ProgramOp : uint8_t {
+  // dst = a. a is a constant rather than a register, b is ignored.
+  kConst,
+  // dst = a + b, wrapping around.
+  kAdd,
+  // dst = a - b, wrapping around.
+  kSub,
+  // dst = a * b, wrapping around.
+  kMul,
+  // dst = scale8(a, b).
+  kScale8,
+  // dst = qadd8(a, b).
+  kQadd8,
+  // dst = qsub8(a, b).
+  kQsub8,
+  // dst = sin8(a), b is ignored.
+  kSin8,
+  // dst = cos8(a), b is ignored.
+  kCos8,
+  kNumOps,
+};
+
+// A per-LED pattern expression, uploaded at runtime rather than compiled into
+// the firmware.
+//
+// The bytecode is a version byte followed by 3-byte instructions {op, a, b},
+// where a and b are register numbers. Registers hold one byte per LED.
+// Registers 0 to 5 are the inputs (see Input), and instruction i writes
+// register kNumInputs + i, so each register is written once before it is read.
+// The intensity of the LED is the register written by the last instruction.
+class PatternProgram {
+ public:
+  static constexpr uint8_t kVersion = 1;
+  static constexpr int kMaxInstructions = 16;
+
+  // Input registers.
+  enum Input : uint8_t {
+    // LED coordinates.
+    kX,
+    kY,
+    kAngle,
+    kRadius,
+    // beat8(speed).
+    kT,
+    // The pattern speed.
+    kSpeed,
+    kNumInputs,
+  };
+  static constexpr int kMaxRegisters = kNumInputs + kMaxInstructions;
+
+  struct Instruction {
+    ProgramOp op;
+    uint8_t a;
+    uint8_t b;
+  };
+
+  // Returns the program encoded in bytes, or nothing if it is not a valid
+  // program.
+  static std::optional<PatternProgram> Parse(const uint8_t* bytes,
+                                             size_t size);
+
+  // The encoded program.
+  const std::vector<uint8_t>& bytes() const { return bytes_; }
+
+  const std::vector<Instruction>& instructions() const {
+    return instructions_;
+  }
+  int num_registers() const { return kNumInputs + instructions_.size(); }
+
+ private:
+  std::vector<uint8_t> bytes_;
+  std::vector<Instruction> instructions_;
+};
+
+// Runs a program over all the LEDs of a wall.
+//
+// Instructions are run one at a time over all the LEDs, so the interpreter
+// dispatches once per instruction rather than once per instruction and LED.
+// Registers whose value is the same for all the LEDs are kept as a single
+// byte, and instructions that don't depend on t or speed only run when the
+// program or the LEDs change, like the phase caches of the built-in patterns.
+class ProgramRunner {
+ public:
+  // Sets the program to run, until the next call.
+  void SetProgram(const PatternProgram& program);
+
+  // Sets the LED coordinates, one value per LED. Not owned, they must outlive
+  // the runner or the next call.
+  void SetLEDs(int num_leds, const uint8_t* x, const uint8_t* y,
+               const uint8_t* angle, const uint8_t* radius);
+
+  // Writes the intensity of every LED to out.
+  void Run(uint8_t t, uint8_t speed, uint8_t* out);
+
+ private:
+  // Whether the value of a register varies between LEDs, and between frames.
+  enum Variance : uint8_t {
+    kPerLed = 1 << 0,
+    kPerFrame = 1 << 1,
+  };
+
+  // Allocates the per-LED registers and runs the instructions that don't vary
+  // between frames.
+  void Prepare();
+
+  // Runs instruction i.
+  void Execute(int i);
+
+  std::optional<PatternProgram> program_;
+  int num_leds_ = 0;
+  // Variance of each register.
+  uint8_t variance_[PatternProgram::kMaxRegisters] = {};
+  // Values of the registers that are the same for all LEDs.
+  uint8_t scalars_[PatternProgram::kMaxRegisters] = {};
+  // Values of the registers that vary between LEDs, one per LED.
+  const uint8_t* leds_[PatternProgram::kMaxRegisters] = {};
+  // Same as leds_, for the registers written by the program.
+  uint8_t* outputs_[PatternProgram::kMaxRegisters] = {};
+  // Storage of the per-LED registers written by the program, num_leds_ bytes
+  // per register.
+  std::vector<uint8_t> storage_;
+  // Whether the instructions that don't vary between frames have run.
+  bool prepared_ = false;
+};
+
+#endif  // INCLUDE_WALL_PROGRAM_H_
@@ -0,0 +1,93 @@
+#ifndef INCLUDE_WALL_RANDOM_H_
+#define INCLUDE_WALL_RANDOM_H_
+
+#include <cstdint>
+
+// Counter-based random numbers: the random number at a position of a stream is
+// a pure function of the stream's seed and of the position, (frame, index),
+// rather than the next state of a shared generator. Patterns each have their
+// own stream, so rendering a pattern never changes the numbers another pattern
+// gets, and the numbers of a frame can be computed in any order, or all at
+// once into a buffer.
+//
+// The position is hashed with a 32-bit integer hash, in the style of the
+// squares generator but without its 64-bit multiplies, which the ESP32 doesn't
+// have: the frame and the seed are hashed into a key once per frame, then each
+// index is hashed with the key.
+
+// A 32-bit hash that is a bijection: distinct inputs give distinct outputs.
+// Chris Wellons' lowbias32.
+inline uint32_t RandomMix(uint32_t x) {
+  x ^= x >> 16;
+  x *= 0x7feb352d;
+  x ^= x >> 15;
+  x *= 0x846ca68b;
+  x ^= x >> 16;
+  return x;
+}
+
+// The random numbers of one frame of a RandomStream, by index. Indexes can be
+// LED indexes, or count the numbers drawn during the frame.
+class RandomFrame {
+ public:
+  explicit RandomFrame(uint32_t key) : key_(key) {}
+
+  uint32_t Get(uint32_t index) const {
+    // Multiplying by an odd constant is a bijection too, so the numbers of a
+    // frame only repeat by chance.
+    return RandomMix(key_ ^ index * 0x9e3779b9);
+  }
+
+  // Between 0 and 255.
+  uint8_t Get8(uint32_t index) const { return Get(index) >> 24; }
+
+  // Between 0 and 65535.
+  uint16_t Get16(uint32_t index) const { return Get(index) >> 16; }
+
+  // Between 0 and limit - 1, like FastLED's random8(limit) and
+  // random16(limit).
+  uint16_t Below(uint32_t index, uint16_t limit) const {
+    return (uint32_t(Get16(index)) * limit) >> 16;
+  }
+
+  // Sets out[i] to Get8(first_index + i), for count numbers.
+  void Fill8(uint8_t* out, int count, uint32_t first_index = 0) const {
+    for (int i = 0; i < count; ++i) {
+      out[i] = Get8(first_index + i);
+    }
+  }
+
+  // Sets out[i] to Below(first_index + i, limit), for count numbers.
+  void FillBelow(uint16_t* out, int count, uint16_t limit,
+                 uint32_t first_index = 0) const {
+    for (int i = 0; i < count; ++i) {
+      out[i] = Below(first_index + i, limit);
+    }
+  }
+
+ private:
+  uint32_t key_;
+};
+
+// A stream of random numbers, one frame after the other.
+class RandomStream {
+ public:
+  explicit RandomStream(uint32_t seed = 0) : seed_(seed) {}
+
+  uint32_t seed() const { return seed_; }
+  void set_seed(uint32_t seed) { seed_ = seed; }
+
+  RandomFrame Frame(uint32_t frame) const {
+    return RandomFrame(RandomMix(seed_ ^ RandomMix(frame + 0x6a09e667)));
+  }
+
+  // The number at index of the frame.
+  uint32_t Get(uint32_t frame, uint32_t index) const {
+    return Frame(frame).Get(index);
+  }
+
+ private:
+  uint32_t seed_;
+};
+
+#endif  // INCLUDE_WALL_RANDOM_H_
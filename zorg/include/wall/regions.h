@@ -0,0 +1,47 @@
+#ifndef INCLUDE_WALL_REGIONS_H_
+#define INCLUDE_WALL_REGIONS_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "common/messages.h"
+#include "wall/led_mapper_data.h"
+
+// Returns whether an LED at the given coordinates is in the region.
+bool InRegion(Region region, uint8_t x, uint8_t y, uint8_t radius);
+
+// The LEDs of a region of the wall, and a mapping of only those LEDs.
+//
+// A pattern rendered onto mapping() only computes the LEDs of the region: LED
+// i of the region's mapping is LED leds()[i] of the wall. The region's mapping
+// keeps the wall's coordinates, and its indexes only list LEDs of the region:
+// radius buckets and grid cells keep the region's LEDs, and neighbors outside
+// the region are dropped. The arrays are built once, by Init().
+class LEDRegion {
+ public:
+  // Selects the LEDs of the wall's mapping that are in the region. The
+  // mapping's arrays must outlive this.
+  void Init(const LEDMapping& mapping, Region region);
+
+  int num_leds() const { return leds_.size(); }
+  // Index in the wall's mapping of each LED of the region, increasing.
+  const uint16_t* leds() const { return leds_.data(); }
+  const LEDMapping& mapping() const { return mapping_; }
+
+ private:
+  std::vector<uint16_t> leds_;
+  // The arrays of mapping_.
+  std::vector<uint8_t> x_;
+  std::vector<uint8_t> y_;
+  std::vector<uint8_t> angle_;
+  std::vector<uint8_t> radius_;
+  std::vector<uint8_t> unique_radii_;
+  std::vector<uint16_t> radius_bucket_starts_;
+  std::vector<uint16_t> radius_bucket_leds_;
+  std::vector<uint16_t> grid_cell_starts_;
+  std::vector<uint16_t> grid_cell_leds_;
+  std::vector<uint16_t> neighbors_;
+  LEDMapping mapping_ = {};
+};
+
+#endif  // INCLUDE_WALL_REGIONS_H_
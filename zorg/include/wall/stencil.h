@@ -0,0 +1,86 @@
+#ifndef INCLUDE_WALL_STENCIL_H_
+#define INCLUDE_WALL_STENCIL_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "wall/led_mapper_data.h"
+
+// A fixed point state per LED, stepped once per frame by a rule that looks at
+// the state of the LED's neighbors (see LEDMapping::neighbors). Effects that
+// spread across the wall, like heat or ripples, are built on this: per-LED
+// formulas of the LED's own coordinates can't express them.
+//
+// The stencil keeps the current and the previous state of every LED. A step is
+// a single pass over the LEDs, reading the neighbor graph in order: the next
+// state of each LED overwrites its previous state, and becomes the current
+// state once the pass is done.
+class CellStencil {
+ public:
+  using Cell = int16_t;
+  // Fractional bits of the cells, which hold values between -256 and 256.
+  static constexpr int kFractionBits = 7;
+  static constexpr Cell kOne = 1 << kFractionBits;
+  static constexpr Cell kMax = INT16_MAX;
+  static constexpr Cell kMin = -INT16_MAX;
+  static constexpr int kNumNeighbors = LEDMapping::kNumNeighbors;
+
+  // Sets the LEDs, and clears the state if they changed. The neighbor graph is
+  // not copied, it must outlive the stencil or the next call.
+  void Init(const LEDMapping& mapping) {
+    if (neighbors_ == mapping.neighbors && num_leds_ == mapping.num_leds) {
+      return;
+    }
+    neighbors_ = mapping.neighbors;
+    num_leds_ = mapping.num_leds;
+    storage_.assign(2 * num_leds_, 0);
+    current_ = storage_.data();
+    previous_ = current_ + num_leds_;
+  }
+
+  // Sets the state of all the LEDs to 0.
+  void Clear() { std::fill(storage_.begin(), storage_.end(), 0); }
+
+  int num_leds() const { return num_leds_; }
+
+  // The current state of each LED. Patterns write to it to add sources.
+  Cell* cells() { return current_; }
+  const Cell* cells() const { return current_; }
+
+  // Returns the neighbors of LED i.
+  const uint16_t* neighbors(int i) const {
+    return neighbors_ + i * kNumNeighbors;
+  }
+
+  // Steps every LED to rule(cell, neighbor_sum, previous): cell is the LED's
+  // current state, neighbor_sum the sum of the current states in its
+  // kNumNeighbors neighbor slots, and previous its state before the last step.
+  // The result is clamped to the range of a cell. Slots without a neighbor hold
+  // the LED itself, so neighbor_sum - kNumNeighbors * cell is the sum of the
+  // differences with the neighbors (the graph Laplacian).
+  template <typename Rule>
+  void Step(Rule rule) {
+    const uint16_t* neighbors = neighbors_;
+    for (int i = 0; i < num_leds_; ++i, neighbors += kNumNeighbors) {
+      int neighbor_sum = 0;
+      for (int k = 0; k < kNumNeighbors; ++k) {
+        neighbor_sum += current_[neighbors[k]];
+      }
+      int next = rule(int(current_[i]), neighbor_sum, int(previous_[i]));
+      previous_[i] = std::clamp<int>(next, kMin, kMax);
+    }
+    std::swap(current_, previous_);
+  }
+
+ private:
+  // Not owned.
+  const uint16_t* neighbors_ = nullptr;
+  int num_leds_ = 0;
+  // The current and previous states, num_leds_ cells each.
+  std::vector<Cell> storage_;
+  Cell* current_ = nullptr;
+  Cell* previous_ = nullptr;
+};
+
+#endif  // INCLUDE_WALL_STENCIL_H_
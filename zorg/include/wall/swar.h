@@ -0,0 +1,93 @@
+#ifndef INCLUDE_WALL_SWAR_H_
+#define INCLUDE_WALL_SWAR_H_
+
+#include <FastLED.h>
+
+#include <cstdint>
+#include <cstring>
+
+// Color kernels that process four 8-bit channels at once, packed in a 32-bit
+// word (SIMD within a register). The ESP32 has no SIMD unit, but a 32-bit
+// multiply can scale two channels at once: the channels are split into their
+// even and odd bytes, each channel then has 16 bits to itself, and the
+// products of 8-bit channels by 9-bit factors never carry into the next one.
+//
+// Each word kernel applies one of FastLED's 8-bit functions to the four bytes
+// of its words, and gives the same result, bit for bit, as FastLED built with
+// its default FASTLED_SCALE8_FIXED and FASTLED_BLEND_FIXED. Channels don't
+// interact, so a buffer of CRGBs is processed as a plain array of bytes, and
+// LEDs can straddle words.
+
+// Even bytes of a word. The odd bytes are ~kEvenBytes.
+constexpr uint32_t kEvenBytes = 0x00ff00ff;
+// Top bit of each byte.
+constexpr uint32_t kByteTopBits = 0x80808080;
+
+// scale8(a, scale) of each byte.
+inline uint32_t Scale8x4(uint32_t a, fract8 scale) {
+  uint32_t factor = uint32_t(scale) + 1;
+  uint32_t even = (((a & kEvenBytes) * factor) >> 8) & kEvenBytes;
+  uint32_t odd = (((a >> 8) & kEvenBytes) * factor) & ~kEvenBytes;
+  return even | odd;
+}
+
+// blend8(a, b, amount_of_b) of each byte, a * (256 - amount_of_b) +
+// b * (amount_of_b + 1), divided by 256. At most 255 * 257, so it fits in 16
+// bits.
+inline uint32_t Blend8x4(uint32_t a, uint32_t b, fract8 amount_of_b) {
+  uint32_t factor_a = 256 - uint32_t(amount_of_b);
+  uint32_t factor_b = uint32_t(amount_of_b) + 1;
+  uint32_t even =
+      (((a & kEvenBytes) * factor_a + (b & kEvenBytes) * factor_b) >> 8) &
+      kEvenBytes;
+  uint32_t odd = (((a >> 8) & kEvenBytes) * factor_a +
+                  ((b >> 8) & kEvenBytes) * factor_b) &
+                 ~kEvenBytes;
+  return even | odd;
+}
+
+// qadd8(a, b) of each byte.
+inline uint32_t QAdd8x4(uint32_t a, uint32_t b) {
+  // Add the low 7 bits of each byte, then add the top bits without carrying.
+  // A byte overflows if both top bits are set, or either is and the low bits
+  // carried into it.
+  uint32_t low = (a & ~kByteTopBits) + (b & ~kByteTopBits);
+  uint32_t sum = low ^ ((a ^ b) & kByteTopBits);
+  uint32_t overflow = ((a & b) | ((a | b) & low)) & kByteTopBits;
+  return sum | ((overflow >> 7) * 0xff);
+}
+
+// max(a, b) of each byte.
+inline uint32_t Max8x4(uint32_t a, uint32_t b) {
+  // The top bit of each byte of low is set if the low 7 bits of a are at least
+  // those of b: setting a's top bit keeps the subtraction from borrowing from
+  // the next byte.
+  uint32_t low = (a | kByteTopBits) - (b & ~kByteTopBits);
+  uint32_t a_at_least_b = ((a & ~b) | (~(a ^ b) & low)) & kByteTopBits;
+  uint32_t mask = (a_at_least_b >> 7) * 0xff;
+  return (a & mask) | (b & ~mask);
+}
+
+// Sets dst[i] to fn(dst[i], src[i]) for n bytes, fn taking and returning four
+// bytes packed in a word. The bytes don't need to be aligned. The last word is
+// padded with zeros.
+template <typename Fn>
+inline void TransformBytes(uint8_t* dst, const uint8_t* src, int n, Fn fn) {
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    uint32_t a, b;
+    std::memcpy(&a, dst + i, 4);
+    std::memcpy(&b, src + i, 4);
+    a = fn(a, b);
+    std::memcpy(dst + i, &a, 4);
+  }
+  if (i < n) {
+    uint32_t a = 0, b = 0;
+    std::memcpy(&a, dst + i, n - i);
+    std::memcpy(&b, src + i, n - i);
+    a = fn(a, b);
+    std::memcpy(dst + i, &a, n - i);
+  }
+}
+
+#endif  // INCLUDE_WALL_SWAR_H_
@@ -0,0 +1,30 @@
+// Minimal Arduino core for host builds. Only provides what the wall animation
+// engine uses.
+#ifndef NATIVE_SHIM_ARDUINO_H_
+#define NATIVE_SHIM_ARDUINO_H_
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+
+// Milliseconds and microseconds since the program started.
+uint32_t millis();
+uint32_t micros();
+
+// Arduino's global pseudo random number generator.
+long random(long howbig);
+long random(long howsmall, long howbig);
+void randomSeed(unsigned long seed);
+
+// Serial port, printed to stdout.
+class HardwareSerial {
+ public:
+  void begin(unsigned long baud) {}
+  int printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+  void print(const char* str) { std::fputs(str, stdout); }
+  void println(const char* str = "") { std::puts(str); }
+};
+
+extern HardwareSerial Serial;
+
+#endif  // NATIVE_SHIM_ARDUINO_H_
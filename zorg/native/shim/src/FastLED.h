@@ -0,0 +1,140 @@
+// Subset of FastLED for host builds: pixel types, lib8tion math, the beat
+// generators and the color utilities used by the wall animation engine.
+// There is no LED output; FastLED.show() is a no-op.
+#ifndef NATIVE_SHIM_FASTLED_H_
+#define NATIVE_SHIM_FASTLED_H_
+
+#include <Arduino.h>
+#include <pixeltypes.h>
+
+#include <cstdint>
+
+// Color correction presets, as FastLED defines them.
+enum LEDColorCorrection : uint32_t {
+  TypicalSMD5050 = 0xFFB0F0,
+  TypicalLEDStrip = 0xFFB0F0,
+  UncorrectedColor = 0xFFFFFF,
+};
+
+inline uint8_t sin8(uint8_t theta) {
+  static constexpr uint8_t b_m16_interleave[] = {0, 49, 49, 41, 90, 27, 117, 10};
+  uint8_t offset = theta;
+  if (theta & 0x40) offset = 255 - offset;
+  offset &= 0x3F;
+
+  uint8_t secoffset = offset & 0x0F;
+  if (theta & 0x40) ++secoffset;
+
+  uint8_t section = offset >> 4;
+  const uint8_t* p = b_m16_interleave + section * 2;
+  uint8_t b = p[0];
+  uint8_t m16 = p[1];
+  uint8_t mx = (m16 * secoffset) >> 4;
+
+  int8_t y = mx + b;
+  if (theta & 0x80) y = -y;
+  y += 128;
+  return y;
+}
+
+inline uint8_t cos8(uint8_t theta) { return sin8(theta + 64); }
+
+inline uint16_t scale16by8(uint16_t i, fract8 scale) {
+  return (uint32_t(i) * (1 + uint32_t(scale))) >> 8;
+}
+
+inline uint16_t lerp16by8(uint16_t a, uint16_t b, fract8 frac) {
+  if (b > a) return a + scale16by8(b - a, frac);
+  return a - scale16by8(a - b, frac);
+}
+
+inline fract8 ease8InOutCubic(fract8 i) {
+  uint8_t ii = scale8(i, i);
+  uint8_t iii = scale8(ii, i);
+  uint16_t r1 = (3 * uint16_t(ii)) - (2 * uint16_t(iii));
+  uint8_t result = r1;
+  if (r1 & 0x100) result = 255;
+  return result;
+}
+
+// FastLED's 16-bit linear congruential generator.
+extern uint16_t rand16seed;
+
+inline uint8_t random8() {
+  rand16seed = (rand16seed * 2053) + 13849;
+  return uint8_t(rand16seed & 0xFF) + uint8_t(rand16seed >> 8);
+}
+
+inline uint8_t random8(uint8_t lim) { return (random8() * lim) >> 8; }
+
+inline uint16_t random16() {
+  rand16seed = (rand16seed * 2053) + 13849;
+  return rand16seed;
+}
+
+inline uint16_t beat88(uint16_t beats_per_minute_88, uint32_t timebase = 0) {
+  return ((millis() - timebase) * beats_per_minute_88 * 280) >> 16;
+}
+
+inline uint16_t beat16(uint16_t beats_per_minute, uint32_t timebase = 0) {
+  if (beats_per_minute < 256) beats_per_minute <<= 8;
+  return beat88(beats_per_minute, timebase);
+}
+
+inline uint8_t beat8(uint16_t beats_per_minute, uint32_t timebase = 0) {
+  return beat16(beats_per_minute, timebase) >> 8;
+}
+
+inline uint8_t beatsin8(uint16_t beats_per_minute, uint8_t lowest = 0,
+                        uint8_t highest = 255, uint32_t timebase = 0,
+                        uint8_t phase_offset = 0) {
+  uint8_t beat = beat8(beats_per_minute, timebase);
+  uint8_t beatsin = sin8(beat + phase_offset);
+  uint8_t rangewidth = highest - lowest;
+  return lowest + scale8(beatsin, rangewidth);
+}
+
+void fill_solid(CRGB* leds, int num_leds, const CRGB& color);
+CRGB HeatColor(uint8_t temperature);
+void nscale8(CRGB* leds, uint16_t num_leds, uint8_t scale);
+void fadeToBlackBy(CRGB* leds, uint16_t num_leds, uint8_t fade_by);
+CRGB& nblend(CRGB& existing, const CRGB& overlay, fract8 amount_of_overlay);
+void nblend(CRGB* existing, const CRGB* overlay, uint16_t count,
+            fract8 amount_of_overlay);
+
+// Runs the following block at most once every N seconds.
+class CEveryNSeconds {
+ public:
+  explicit CEveryNSeconds(uint32_t period) : period_(period) {}
+  bool ready() {
+    uint32_t now = millis() / 1000;
+    if (now - last_ < period_) return false;
+    last_ = now;
+    return true;
+  }
+
+ private:
+  uint32_t period_;
+  uint32_t last_ = 0;
+};
+
+#define EVERY_N_SECONDS_CONCAT_(a, b) a##b
+#define EVERY_N_SECONDS_NAME_(line) EVERY_N_SECONDS_CONCAT_(every_n_secs_, line)
+#define EVERY_N_SECONDS(n)                                      \
+  static CEveryNSeconds EVERY_N_SECONDS_NAME_(__LINE__)(n);     \
+  if (EVERY_N_SECONDS_NAME_(__LINE__).ready())
+
+// Stand-in for the global FastLED object.
+class CFastLED {
+ public:
+  void setBrightness(uint8_t scale) { brightness_ = scale; }
+  uint8_t getBrightness() const { return brightness_; }
+  void show() {}
+
+ private:
+  uint8_t brightness_ = 255;
+};
+
+extern CFastLED FastLED;
+
+#endif  // NATIVE_SHIM_FASTLED_H_
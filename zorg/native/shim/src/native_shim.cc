@@ -0,0 +1,204 @@
+#include <Arduino.h>
+#include <FastLED.h>
+
+#include <chrono>
+#include <cstdarg>
+#include <cstdio>
+#include <random>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const Clock::time_point& StartTime() {
+  static const Clock::time_point start = Clock::now();
+  return start;
+}
+
+std::minstd_rand& Rng() {
+  static std::minstd_rand rng;
+  return rng;
+}
+
+}  // namespace
+
+HardwareSerial Serial;
+CFastLED FastLED;
+uint16_t rand16seed = 1337;
+
+uint32_t millis() {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() -
+                                                               StartTime())
+      .count();
+}
+
+uint32_t micros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() -
+                                                               StartTime())
+      .count();
+}
+
+long random(long howbig) {
+  if (howbig == 0) return 0;
+  return Rng()() % howbig;
+}
+
+long random(long howsmall, long howbig) {
+  if (howsmall >= howbig) return howsmall;
+  return random(howbig - howsmall) + howsmall;
+}
+
+void randomSeed(unsigned long seed) {
+  if (seed != 0) Rng().seed(seed);
+}
+
+int HardwareSerial::printf(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  int result = std::vprintf(format, args);
+  va_end(args);
+  return result;
+}
+
+void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb) {
+  uint8_t hue = hsv.hue;
+  uint8_t sat = hsv.sat;
+  uint8_t val = hsv.val;
+
+  uint8_t offset8 = (hue & 0x1F) << 3;
+  uint8_t third = scale8(offset8, 256 / 3);
+  uint8_t twothirds = scale8(offset8, (256 * 2) / 3);
+
+  uint8_t r, g, b;
+  switch (hue >> 5) {
+    case 0:  // Red to orange.
+      r = 255 - third;
+      g = third;
+      b = 0;
+      break;
+    case 1:  // Orange to yellow.
+      r = 171;
+      g = 85 + third;
+      b = 0;
+      break;
+    case 2:  // Yellow to green.
+      r = 171 - twothirds;
+      g = 170 + third;
+      b = 0;
+      break;
+    case 3:  // Green to aqua.
+      r = 0;
+      g = 255 - third;
+      b = third;
+      break;
+    case 4:  // Aqua to blue.
+      r = 0;
+      g = 171 - twothirds;
+      b = 85 + twothirds;
+      break;
+    case 5:  // Blue to purple.
+      r = third;
+      g = 0;
+      b = 255 - third;
+      break;
+    case 6:  // Purple to pink.
+      r = 85 + third;
+      g = 0;
+      b = 171 - third;
+      break;
+    default:  // Pink to red.
+      r = 170 + third;
+      g = 0;
+      b = 85 - third;
+      break;
+  }
+
+  if (sat != 255) {
+    if (sat == 0) {
+      r = 255;
+      g = 255;
+      b = 255;
+    } else {
+      uint8_t desat = 255 - sat;
+      desat = scale8_video(desat, desat);
+      uint8_t satscale = 255 - desat;
+      r = scale8(r, satscale) + desat;
+      g = scale8(g, satscale) + desat;
+      b = scale8(b, satscale) + desat;
+    }
+  }
+
+  if (val != 255) {
+    val = scale8_video(val, val);
+    if (val == 0) {
+      r = 0;
+      g = 0;
+      b = 0;
+    } else {
+      r = scale8(r, val);
+      g = scale8(g, val);
+      b = scale8(b, val);
+    }
+  }
+
+  rgb.r = r;
+  rgb.g = g;
+  rgb.b = b;
+}
+
+void fill_solid(CRGB* leds, int num_leds, const CRGB& color) {
+  for (int i = 0; i < num_leds; ++i) leds[i] = color;
+}
+
+CRGB HeatColor(uint8_t temperature) {
+  // Black, then red, then yellow, then white.
+  uint8_t t192 = scale8_video(temperature, 191);
+  uint8_t heatramp = (t192 & 0x3f) << 2;
+  CRGB heatcolor;
+  if (t192 & 0x80) {
+    heatcolor.r = 255;
+    heatcolor.g = 255;
+    heatcolor.b = heatramp;
+  } else if (t192 & 0x40) {
+    heatcolor.r = 255;
+    heatcolor.g = heatramp;
+    heatcolor.b = 0;
+  } else {
+    heatcolor.r = heatramp;
+    heatcolor.g = 0;
+    heatcolor.b = 0;
+  }
+  return heatcolor;
+}
+
+void nscale8(CRGB* leds, uint16_t num_leds, uint8_t scale) {
+  for (uint16_t i = 0; i < num_leds; ++i) leds[i].nscale8(scale);
+}
+
+void fadeToBlackBy(CRGB* leds, uint16_t num_leds, uint8_t fade_by) {
+  nscale8(leds, num_leds, 255 - fade_by);
+}
+
+CRGB& nblend(CRGB& existing, const CRGB& overlay, fract8 amount_of_overlay) {
+  if (amount_of_overlay == 0) return existing;
+  if (amount_of_overlay == 255) {
+    existing = overlay;
+    return existing;
+  }
+  existing.red = blend8(existing.red, overlay.red, amount_of_overlay);
+  existing.green = blend8(existing.green, overlay.green, amount_of_overlay);
+  existing.blue = blend8(existing.blue, overlay.blue, amount_of_overlay);
+  return existing;
+}
+
+void nblend(CRGB* existing, const CRGB* overlay, uint16_t count,
+            fract8 amount_of_overlay) {
+  if (amount_of_overlay == 0) return;
+  if (amount_of_overlay == 255) {
+    for (uint16_t i = 0; i < count; ++i) existing[i] = overlay[i];
+    return;
+  }
+  for (uint16_t i = 0; i < count; ++i) {
+    nblend(existing[i], overlay[i], amount_of_overlay);
+  }
+}
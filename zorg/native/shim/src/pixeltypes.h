@@ -0,0 +1,124 @@
+// Subset of FastLED's pixel types for host builds. The color math matches
+// FastLED 3.7 with FASTLED_SCALE8_FIXED and FASTLED_BLEND_FIXED set, which is
+// what the ESP32 build uses.
+#ifndef NATIVE_SHIM_PIXELTYPES_H_
+#define NATIVE_SHIM_PIXELTYPES_H_
+
+#include <cstdint>
+
+typedef uint8_t fract8;
+typedef uint16_t fract16;
+
+inline uint8_t scale8(uint8_t i, fract8 scale) {
+  return (uint16_t(i) * (1 + uint16_t(scale))) >> 8;
+}
+
+inline uint8_t scale8_video(uint8_t i, fract8 scale) {
+  return ((uint16_t(i) * scale) >> 8) + ((i && scale) ? 1 : 0);
+}
+
+inline uint8_t qadd8(uint8_t i, uint8_t j) {
+  unsigned t = i + j;
+  return t > 255 ? 255 : t;
+}
+
+inline uint8_t qsub8(uint8_t i, uint8_t j) { return i > j ? i - j : 0; }
+
+inline uint8_t blend8(uint8_t a, uint8_t b, uint8_t amount_of_b) {
+  uint16_t partial = a * (255 - amount_of_b) + a + b * amount_of_b + b;
+  return partial >> 8;
+}
+
+struct CHSV {
+  union {
+    struct {
+      uint8_t hue;
+      uint8_t sat;
+      uint8_t val;
+    };
+    uint8_t raw[3];
+  };
+
+  CHSV() = default;
+  constexpr CHSV(uint8_t ih, uint8_t is, uint8_t iv)
+      : hue(ih), sat(is), val(iv) {}
+};
+
+struct CRGB;
+void hsv2rgb_rainbow(const CHSV& hsv, CRGB& rgb);
+
+struct CRGB {
+  union {
+    struct {
+      union {
+        uint8_t r;
+        uint8_t red;
+      };
+      union {
+        uint8_t g;
+        uint8_t green;
+      };
+      union {
+        uint8_t b;
+        uint8_t blue;
+      };
+    };
+    uint8_t raw[3];
+  };
+
+  enum HTMLColorCode : uint32_t {
+    Black = 0x000000,
+    Blue = 0x0000FF,
+    Green = 0x008000,
+    Red = 0xFF0000,
+    White = 0xFFFFFF,
+  };
+
+  CRGB() = default;
+  constexpr CRGB(uint8_t ir, uint8_t ig, uint8_t ib) : r(ir), g(ig), b(ib) {}
+  constexpr CRGB(uint32_t colorcode)
+      : r((colorcode >> 16) & 0xFF),
+        g((colorcode >> 8) & 0xFF),
+        b(colorcode & 0xFF) {}
+  constexpr CRGB(HTMLColorCode colorcode) : CRGB(uint32_t(colorcode)) {}
+  CRGB(const CHSV& rhs) { hsv2rgb_rainbow(rhs, *this); }
+
+  CRGB& operator=(const CHSV& rhs) {
+    hsv2rgb_rainbow(rhs, *this);
+    return *this;
+  }
+
+  CRGB& setHSV(uint8_t hue, uint8_t sat, uint8_t val) {
+    hsv2rgb_rainbow(CHSV(hue, sat, val), *this);
+    return *this;
+  }
+
+  uint8_t& operator[](uint8_t x) { return raw[x]; }
+  const uint8_t& operator[](uint8_t x) const { return raw[x]; }
+
+  CRGB& operator+=(const CRGB& rhs) {
+    r = qadd8(r, rhs.r);
+    g = qadd8(g, rhs.g);
+    b = qadd8(b, rhs.b);
+    return *this;
+  }
+
+  CRGB& nscale8(uint8_t scaledown) {
+    r = scale8(r, scaledown);
+    g = scale8(g, scaledown);
+    b = scale8(b, scaledown);
+    return *this;
+  }
+
+  CRGB& fadeToBlackBy(uint8_t fadefactor) { return nscale8(255 - fadefactor); }
+};
+
+inline bool operator==(const CRGB& lhs, const CRGB& rhs) {
+  return lhs.r == rhs.r && lhs.g == rhs.g && lhs.b == rhs.b;
+}
+
+inline bool operator!=(const CRGB& lhs, const CRGB& rhs) {
+  return !(lhs == rhs);
+}
+
+#endif  // NATIVE_SHIM_PIXELTYPES_H_
@@ -0,0 +1,1039 @@
+// Pattern benchmark.
+//
+// Runs every pattern of the wall animation engine on the host, and reports the
+// time it takes to render a frame. Each pattern is measured on its own, and
+// while transitioning from another pattern (which renders both patterns).
+// Transitions between patterns of the same family morph their parameters
+// instead, and are measured separately. A pattern is also measured under a
+// growing stack of overlay layers, under an overlay limited to each region of
+// the wall, and in a heavy scene under a frame budget, which the governor has
+// to lower the render quality to keep. Programs equivalent to some of the
+// patterns are run by the bytecode interpreter, to compare it with the
+// hand-written patterns. Radial patterns are also measured with an origin that
+// moves every frame. Finally, the polar coordinates kernel, the stencil engine
+// and the particle engine are measured on their own, the polar coordinates are
+// compared with floating point math and LED Mapper's, the color kernels of
+// wall/swar.h are compared with FastLED's, the output stage is checked to keep
+// frames within the wall's power budget, the time frames take on the wire is
+// modeled for several segment layouts, and the climax fill is checked frame by
+// frame against the way ClimaxPattern used to draw the same frames. Every
+// pattern that isn't stateful must draw the same frames when only rendered
+// every few frames, as outgoing layers are, as when rendered every frame. An
+// hour of the cube's ambient cycle is also played twice, and must draw the same
+// frames both times.
+//
+// All the frames are timed by virtual clocks that step one frame at a time (see
+// frame_clock), so what the patterns draw doesn't depend on how fast the host
+// renders it.
+//
+// The test wall is benchmarked, build with -DACTUAL_WALL (the native-wall
+// environment) to benchmark the actual wall.
+#include <Arduino.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "common/clock.h"
+#include "common/messages.h"
+#include "wall/animation.h"
+#include "wall/frame_governor.h"
+#include "wall/led_mapper_data.h"
+#include "wall/output_driver.h"
+#include "wall/output_stage.h"
+#include "wall/particles.h"
+#include "wall/polar.h"
+#include "wall/program.h"
+#include "wall/random.h"
+#include "wall/regions.h"
+#include "wall/stencil.h"
+#include "wall/swar.h"
+
+namespace {
+
+#ifdef ACTUAL_WALL
+constexpr char kWallVariant[] = "actual_wall";
+#else
+constexpr char kWallVariant[] = "test_wall";
+#endif
+// The mapping and wiring of the wall benchmarked.
+const LEDWallVariant& kWall = *FindLEDWallVariant(kWallVariant);
+const LEDMapping& kLEDMapping = kWall.mapping;
+const LEDSegmentLayout& kLEDSegments = kWall.segments;
+
+// Frames rendered before measuring, and frames measured.
+constexpr int kWarmupFrames = 50;
+constexpr int kMeasuredFrames = 1000;
+
+// The frames are timed by a virtual clock, one step per frame at 60 frames per
+// second, so the patterns draw the same frames on every run however fast the
+// host renders them.
+constexpr uint64_t kFrameMicros = 1000 * 1000 / 60;
+VirtualClock frame_clock(kFrameMicros);
+
+constexpr uint8_t kSpeed = 60;
+// Long enough for the whole measurement to happen mid-transition.
+constexpr int kTransitionDurationMillis = 1000 * 1000;
+
+const char* PatternName(PatternId pattern_id) {
+  switch (pattern_id) {
+    case kNone:
+      return "None";
+    case kSpiral:
+      return "Spiral";
+    case kOutWave:
+      return "OutWave";
+    case kRose:
+      return "Rose";
+    case kInWave:
+      return "InWave";
+    case kCircles:
+      return "Circles";
+    case kAwaitTouch:
+      return "AwaitTouch";
+    case kGlitch:
+      return "Glitch";
+    case kClimax:
+      return "Climax";
+    case kRecovery:
+      return "Recovery";
+    case kManBurn:
+      return "ManBurn";
+    case kTempleBurn:
+      return "TempleBurn";
+    case kProgram:
+      return "Program";
+    case kDiffusion:
+      return "Diffusion";
+    case kRipple:
+      return "Ripple";
+    case kSparks:
+      return "Sparks";
+    case kEmbers:
+      return "Embers";
+    case kSwarm:
+      return "Swarm";
+    case kNumPatternIds:
+      break;
+  }
+  return "Unknown";
+}
+
+const char* RegionName(Region region) {
+  switch (region) {
+    case Region::kWall:
+      return "Wall";
+    case Region::kHandZone:
+      return "HandZone";
+    case Region::kOutsideHandZone:
+      return "OutsideHandZone";
+    case Region::kTopBand:
+      return "TopBand";
+    case Region::kBottomBand:
+      return "BottomBand";
+    case Region::kNumRegions:
+      break;
+  }
+  return "Unknown";
+}
+
+const char* QualityName(RenderQuality quality) {
+  switch (quality) {
+    case RenderQuality::kFull:
+      return "Full";
+    case RenderQuality::kHalfRateOutgoing:
+      return "HalfRateOutgoing";
+    case RenderQuality::kHalfRateOverlays:
+      return "HalfRateOverlays";
+    case RenderQuality::kFrozenOutgoing:
+      return "FrozenOutgoing";
+    case RenderQuality::kNumQualities:
+      break;
+  }
+  return "Unknown";
+}
+
+void RenderFrame(LEDController& controller) {
+  controller.Update();
+  controller.SwapBuffers();
+  frame_clock.Step();
+}
+
+// Returns the average time to render a frame, in nanoseconds.
+double MeasureFrameNanos(LEDController& controller) {
+  for (int i = 0; i < kWarmupFrames; ++i) RenderFrame(controller);
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kMeasuredFrames; ++i) RenderFrame(controller);
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         kMeasuredFrames;
+}
+
+// Time to render pattern_id on its own.
+double BenchmarkPattern(LEDController& controller, PatternId pattern_id) {
+  controller.SetCurrentPattern(pattern_id, kSpeed, 0);
+  return MeasureFrameNanos(controller);
+}
+
+// Time to render pattern_id while it blends in from another pattern.
+double BenchmarkTransition(LEDController& controller, PatternId pattern_id) {
+  PatternId previous_id = pattern_id == kSpiral ? kRose : kSpiral;
+  controller.SetCurrentPattern(previous_id, kSpeed, 0);
+  RenderFrame(controller);
+  controller.SetCurrentPattern(pattern_id, kSpeed, kTransitionDurationMillis);
+  return MeasureFrameNanos(controller);
+}
+
+// Time to render pattern_id while it morphs from previous_id, which is in the
+// same family. The morph barely moves during the measurement, so per-LED values
+// that depend on the morphing parameters are measured cached. On the wall they
+// are recomputed every frame, like on the first frame of a pattern.
+double BenchmarkMorph(LEDController& controller, PatternId previous_id,
+                      PatternId pattern_id) {
+  controller.SetCurrentPattern(previous_id, kSpeed, 0);
+  RenderFrame(controller);
+  controller.SetCurrentPattern(pattern_id, kSpeed, kTransitionDurationMillis);
+  return MeasureFrameNanos(controller);
+}
+
+// Time to render pattern_id while its origin moves by one coordinate unit every
+// frame, so its angles and radii are recomputed every frame.
+double BenchmarkMovingOrigin(LEDController& controller, PatternId pattern_id) {
+  controller.SetCurrentPattern(pattern_id, kSpeed, 0);
+  int frame = 0;
+  auto render = [&] {
+    SetPatternParamsCommand command;
+    command.origin_x = 64 + frame % 128;
+    command.origin_y = 96;
+    controller.SetPatternParams(command);
+    RenderFrame(controller);
+    ++frame;
+  };
+  for (int i = 0; i < kWarmupFrames; ++i) render();
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kMeasuredFrames; ++i) render();
+  auto end = std::chrono::steady_clock::now();
+  // Back to the mapping's origin for the next measurements.
+  SetPatternParamsCommand command;
+  command.origin_x = kLEDMapping.origin_x;
+  command.origin_y = kLEDMapping.origin_y;
+  controller.SetPatternParams(command);
+  RenderFrame(controller);
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         kMeasuredFrames;
+}
+
+// Overlay layers drawn over the pattern, bottom first.
+constexpr SetLayerCommand kOverlays[] = {
+    {.layer = 0, .pattern_id = kRipple, .blend_mode = BlendMode::kAdd},
+    {.layer = 1, .pattern_id = kGlitch, .opacity = 64,
+     .blend_mode = BlendMode::kScreen},
+    {.layer = 2, .pattern_id = kSparks, .blend_mode = BlendMode::kMax},
+};
+
+// Time to render pattern_id under the first num_overlays of kOverlays.
+double BenchmarkOverlays(LEDController& controller, PatternId pattern_id,
+                         int num_overlays) {
+  controller.SetCurrentPattern(pattern_id, kSpeed, 0);
+  for (int i = 0; i < num_overlays; ++i) controller.SetLayer(kOverlays[i]);
+  double nanos = MeasureFrameNanos(controller);
+  for (int i = 0; i < num_overlays; ++i) {
+    controller.SetLayer({.layer = i, .pattern_id = kNone});
+  }
+  return nanos;
+}
+
+// Time to render pattern_id under a Ripple overlay limited to the region.
+double BenchmarkRegion(LEDController& controller, PatternId pattern_id,
+                       Region region) {
+  controller.SetCurrentPattern(pattern_id, kSpeed, 0);
+  controller.SetLayer({.layer = 0,
+                       .pattern_id = kRipple,
+                       .blend_mode = BlendMode::kNormal,
+                       .region = region});
+  double nanos = MeasureFrameNanos(controller);
+  controller.SetLayer({.layer = 0, .pattern_id = kNone});
+  return nanos;
+}
+
+// A heavy scene rendered under a frame budget.
+struct GovernorRun {
+  // Time to render a frame with no budget.
+  double full_nanos;
+  uint32_t budget_micros;
+  // What the governor did during the run.
+  FrameGovernor::Stats stats;
+};
+
+// Renders Spiral fading in over ManBurn and Circles, under all of kOverlays,
+// with a frame budget of budget_fraction of the time the scene takes at full
+// quality.
+GovernorRun BenchmarkGovernor(LEDController& controller,
+                              double budget_fraction) {
+  controller.SetCurrentPattern(kManBurn, kSpeed, 0);
+  RenderFrame(controller);
+  controller.SetCurrentPattern(kCircles, kSpeed, kTransitionDurationMillis);
+  RenderFrame(controller);
+  controller.SetCurrentPattern(kSpiral, kSpeed, kTransitionDurationMillis);
+  for (const SetLayerCommand& overlay : kOverlays) controller.SetLayer(overlay);
+  GovernorRun run;
+  run.full_nanos = MeasureFrameNanos(controller);
+  run.budget_micros = run.full_nanos * budget_fraction / 1000;
+  FrameGovernor::Stats before = controller.governor().stats();
+  controller.set_frame_budget_micros(run.budget_micros);
+  for (int i = 0; i < kMeasuredFrames; ++i) RenderFrame(controller);
+  controller.set_frame_budget_micros(0);
+  const FrameGovernor::Stats& after = controller.governor().stats();
+  run.stats.steps_down = after.steps_down - before.steps_down;
+  run.stats.steps_up = after.steps_up - before.steps_up;
+  for (int q = 0; q < FrameGovernor::kNumQualities; ++q) {
+    run.stats.frames[q] = after.frames[q] - before.frames[q];
+    run.stats.micros[q] = after.micros[q] - before.micros[q];
+  }
+  for (const SetLayerCommand& overlay : kOverlays) {
+    controller.SetLayer({.layer = overlay.layer, .pattern_id = kNone});
+  }
+  return run;
+}
+
+// Returns the bytecode of the given instructions.
+std::vector<uint8_t> Encode(
+    std::initializer_list<PatternProgram::Instruction> instructions) {
+  std::vector<uint8_t> bytes = {PatternProgram::kVersion};
+  for (const PatternProgram::Instruction& instruction : instructions) {
+    bytes.push_back(uint8_t(instruction.op));
+    bytes.push_back(instruction.a);
+    bytes.push_back(instruction.b);
+  }
+  return bytes;
+}
+
+// Programs computing the same intensities as the pattern.
+struct EquivalentProgram {
+  PatternId pattern_id;
+  std::vector<uint8_t> bytecode;
+};
+
+std::vector<EquivalentProgram> EquivalentPrograms() {
+  using Op = ProgramOp;
+  using P = PatternProgram;
+  return {
+      // sin8(2 * radius + 4 * angle - t).
+      {kSpiral, Encode({{Op::kConst, 2, 0},            // 6
+                        {Op::kMul, P::kRadius, 6},     // 7
+                        {Op::kConst, 4, 0},            // 8
+                        {Op::kMul, P::kAngle, 8},      // 9
+                        {Op::kAdd, 7, 9},              // 10
+                        {Op::kSub, 10, P::kT},         // 11
+                        {Op::kSin8, 11, 0}})},         // 12
+      // sin8(scale8(255 - x, y) + scale8(255 - y, x) + t).
+      {kTempleBurn, Encode({{Op::kConst, 255, 0},      // 6
+                            {Op::kSub, 6, P::kX},      // 7
+                            {Op::kScale8, 7, P::kY},   // 8
+                            {Op::kSub, 6, P::kY},      // 9
+                            {Op::kScale8, 9, P::kX},   // 10
+                            {Op::kAdd, 8, 10},         // 11
+                            {Op::kAdd, 11, P::kT},     // 12
+                            {Op::kSin8, 12, 0}})},     // 13
+  };
+}
+
+// Time to render the program.
+double BenchmarkProgram(LEDController& controller,
+                        const std::vector<uint8_t>& bytecode) {
+  std::optional<PatternProgram> program =
+      PatternProgram::Parse(bytecode.data(), bytecode.size());
+  if (!program.has_value()) return 0;
+  controller.SetProgram(*program);
+  return BenchmarkPattern(controller, kProgram);
+}
+
+// Time to compute the polar coordinates of all the LEDs around an origin.
+double BenchmarkPolarCoordinates(const LEDMapping& mapping) {
+  std::vector<uint8_t> angle(mapping.num_leds);
+  std::vector<uint8_t> radius(mapping.num_leds);
+  int frame = 0;
+  auto compute = [&] {
+    ComputePolarCoordinates(mapping.num_leds, mapping.x, mapping.y,
+                            frame % 256, 255 - frame % 256, angle.data(),
+                            radius.data());
+    ++frame;
+  };
+  for (int i = 0; i < kWarmupFrames; ++i) compute();
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kMeasuredFrames; ++i) compute();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         kMeasuredFrames;
+}
+
+// Largest and average differences between the polar coordinates and their
+// exact values, over all the vectors between two positions.
+struct PolarError {
+  double max_angle = 0;
+  double mean_angle = 0;
+  double max_radius = 0;
+  double mean_radius = 0;
+};
+
+PolarError MeasurePolarError() {
+  PolarError error;
+  int count = 0;
+  for (int dx = -255; dx <= 255; ++dx) {
+    for (int dy = -255; dy <= 255; ++dy) {
+      double angle = 0;
+      if (dx != 0 || dy != 0) {
+        double exact = std::atan2(dy, dx) * 128 / M_PI;
+        angle = std::fabs(std::remainder(PolarAngle(dx, dy) - exact, 256));
+      }
+      double exact_radius = std::min(std::hypot(dx, dy) * std::sqrt(2), 255.0);
+      double radius = std::fabs(PolarRadius(dx, dy) - exact_radius);
+      error.max_angle = std::max(error.max_angle, angle);
+      error.max_radius = std::max(error.max_radius, radius);
+      error.mean_angle += angle;
+      error.mean_radius += radius;
+      ++count;
+    }
+  }
+  error.mean_angle /= count;
+  error.mean_radius /= count;
+  return error;
+}
+
+// Differences between the polar coordinates computed around the mapping's
+// origin and LED Mapper's. Patterns read LED Mapper's at the mapping's origin
+// and computed ones elsewhere, so these are how far they jump as the origin
+// moves off it.
+PolarError MeasureMappingPolarError(const LEDMapping& mapping) {
+  std::vector<uint8_t> angle(mapping.num_leds);
+  std::vector<uint8_t> radius(mapping.num_leds);
+  ComputePolarCoordinates(mapping.num_leds, mapping.x, mapping.y,
+                          mapping.origin_x, mapping.origin_y, angle.data(),
+                          radius.data());
+  PolarError error;
+  for (int i = 0; i < mapping.num_leds; ++i) {
+    double angle_error =
+        std::fabs(std::remainder(angle[i] - mapping.angle[i], 256));
+    double radius_error = std::abs(radius[i] - mapping.radius[i]);
+    error.max_angle = std::max(error.max_angle, angle_error);
+    error.max_radius = std::max(error.max_radius, radius_error);
+    error.mean_angle += angle_error;
+    error.mean_radius += radius_error;
+  }
+  error.mean_angle /= mapping.num_leds;
+  error.mean_radius /= mapping.num_leds;
+  return error;
+}
+
+// Time to step a stencil over all the LEDs, with a diffusion rule.
+double BenchmarkStencilStep(const LEDMapping& mapping) {
+  CellStencil stencil;
+  stencil.Init(mapping);
+  stencil.cells()[0] = CellStencil::kMax;
+  auto step = [&stencil] {
+    stencil.Step([](int cell, int neighbor_sum, int previous) {
+      return cell + (((neighbor_sum - CellStencil::kNumNeighbors * cell) *
+                      32) >>
+                     8);
+    });
+  };
+  for (int i = 0; i < kWarmupFrames; ++i) step();
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kMeasuredFrames; ++i) step();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         kMeasuredFrames;
+}
+
+// Time to move num_particles particles and draw them onto the LEDs.
+double BenchmarkParticles(const LEDMapping& mapping, int num_particles) {
+  ParticlePool pool;
+  pool.Init(num_particles);
+  for (int i = 0; i < num_particles; ++i) {
+    pool.Emit({.x = random16(),
+               .y = random16(),
+               .vx = int16_t(random8(64) - 32),
+               .vy = int16_t(random8(64) - 32),
+               .life = 255,
+               .brightness = 64});
+  }
+  std::vector<uint8_t> intensities(mapping.num_leds);
+  // The particles bounce around the middle of the wall, so none are removed.
+  auto step = [&] {
+    pool.Step(0, [](Particle& particle) {
+      if ((particle.x < 0x4000 && particle.vx < 0) ||
+          (particle.x > 0xc000 && particle.vx > 0)) {
+        particle.vx = -particle.vx;
+      }
+      if ((particle.y < 0x4000 && particle.vy < 0) ||
+          (particle.y > 0xc000 && particle.vy > 0)) {
+        particle.vy = -particle.vy;
+      }
+    });
+    std::fill(intensities.begin(), intensities.end(), 0);
+    pool.Splat(mapping, intensities.data());
+  };
+  for (int i = 0; i < kWarmupFrames; ++i) step();
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kMeasuredFrames; ++i) step();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         kMeasuredFrames;
+}
+
+// Frames of a climax: 20 seconds at 60 frames per second, then some frames
+// fully lit.
+constexpr int kClimaxFillFrames = 1200;
+constexpr int kClimaxFrames = kClimaxFillFrames + 300;
+
+// A frame of ClimaxPattern as it was before ClimaxFill: the random numbers are
+// drawn again every frame, and every LED is tested against the fill progress.
+void ReferenceClimaxFrame(const RandomFrame& random, uint8_t fill_progress,
+                          std::vector<CRGB>& glow, CRGB* leds) {
+  for (int i = 0; i < int(glow.size()); ++i) {
+    if (random.Get8(i) < fill_progress) {
+      glow[i] += CHSV(10, 10, 1);
+    } else {
+      glow[i].setHSV(0, 0, 0);
+    }
+    leds[i] = glow[i];
+  }
+}
+
+// ClimaxFill compared with the reference over a whole climax.
+struct ClimaxCheck {
+  double reference_nanos = 0;
+  double fill_nanos = 0;
+  // Frames where some LED differs.
+  int mismatched_frames = 0;
+};
+
+ClimaxCheck CheckClimaxFill(const LEDMapping& mapping) {
+  const RandomFrame random = RandomStream(4242).Frame(0);
+  ClimaxCheck check;
+  std::vector<CRGB> glow(mapping.num_leds, CRGB::Black);
+  std::vector<CRGB> reference(mapping.num_leds);
+  std::vector<CRGB> leds(mapping.num_leds);
+  ClimaxFill fill;
+  fill.Init(mapping.num_leds, random);
+  for (int frame = 0; frame < kClimaxFrames; ++frame) {
+    uint8_t fill_progress =
+        255 * std::min(frame, kClimaxFillFrames) / kClimaxFillFrames;
+    auto start = std::chrono::steady_clock::now();
+    ReferenceClimaxFrame(random, fill_progress, glow, reference.data());
+    auto middle = std::chrono::steady_clock::now();
+    fill.Advance(fill_progress, leds.data());
+    auto end = std::chrono::steady_clock::now();
+    check.reference_nanos +=
+        std::chrono::duration<double, std::nano>(middle - start).count();
+    check.fill_nanos +=
+        std::chrono::duration<double, std::nano>(end - middle).count();
+    if (!std::equal(leds.begin(), leds.end(), reference.begin())) {
+      ++check.mismatched_frames;
+    }
+  }
+  check.reference_nanos /= kClimaxFrames;
+  check.fill_nanos /= kClimaxFrames;
+  return check;
+}
+
+// Four bytes packed in a word, the first one lowest, as in memory.
+uint32_t PackBytes(uint8_t b0, uint8_t b1, uint8_t b2, uint8_t b3) {
+  return b0 | uint32_t(b1) << 8 | uint32_t(b2) << 16 | uint32_t(b3) << 24;
+}
+
+// Bytes where each word kernel differs from the function it replaces, over
+// all their operands.
+struct WordKernelMismatches {
+  int scale = 0;
+  int blend = 0;
+  int add = 0;
+  int max = 0;
+};
+
+// Each lane of a word gets different operands, so carries between lanes would
+// show.
+WordKernelMismatches CountWordKernelMismatches() {
+  WordKernelMismatches mismatches;
+  auto check = [](int& mismatches, uint32_t word, uint8_t b0, uint8_t b1,
+                  uint8_t b2, uint8_t b3) {
+    mismatches += (word & 0xff) != b0;
+    mismatches += (word >> 8 & 0xff) != b1;
+    mismatches += (word >> 16 & 0xff) != b2;
+    mismatches += (word >> 24) != b3;
+  };
+  for (int a = 0; a < 256; ++a) {
+    // The other lanes get other values of a.
+    uint8_t a0 = a, a1 = a + 85, a2 = a + 170, a3 = 255 - a;
+    uint32_t a_word = PackBytes(a0, a1, a2, a3);
+    for (int b = 0; b < 256; b += 4) {
+      uint8_t b0 = b, b1 = b + 1, b2 = b + 2, b3 = b + 3;
+      uint32_t b_word = PackBytes(b0, b1, b2, b3);
+      check(mismatches.add, QAdd8x4(a_word, b_word), qadd8(a0, b0),
+            qadd8(a1, b1), qadd8(a2, b2), qadd8(a3, b3));
+      check(mismatches.max, Max8x4(a_word, b_word), std::max(a0, b0),
+            std::max(a1, b1), std::max(a2, b2), std::max(a3, b3));
+      for (int amount = 0; amount < 256; ++amount) {
+        check(mismatches.blend, Blend8x4(a_word, b_word, amount),
+              blend8(a0, b0, amount), blend8(a1, b1, amount),
+              blend8(a2, b2, amount), blend8(a3, b3, amount));
+      }
+    }
+    for (int scale = 0; scale < 256; ++scale) {
+      check(mismatches.scale, Scale8x4(a_word, scale), scale8(a0, scale),
+            scale8(a1, scale), scale8(a2, scale), scale8(a3, scale));
+    }
+  }
+  return mismatches;
+}
+
+// Time to apply a color kernel to all the LEDs, the way FastLED does, one
+// channel at a time, and with the word kernels of wall/swar.h.
+struct KernelTimes {
+  double scalar_nanos;
+  double word_nanos;
+};
+
+template <typename Scalar, typename Word>
+KernelTimes BenchmarkKernel(int num_leds, Scalar scalar, Word word) {
+  std::vector<CRGB> leds(num_leds);
+  std::vector<CRGB> overlay(num_leds);
+  for (int i = 0; i < num_leds; ++i) {
+    leds[i] = CRGB(random8(), random8(), random8());
+    overlay[i] = CRGB(random8(), random8(), random8());
+  }
+  auto measure = [&](auto kernel) {
+    for (int i = 0; i < kWarmupFrames; ++i) {
+      kernel(leds.data(), overlay.data(), num_leds);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kMeasuredFrames; ++i) {
+      kernel(leds.data(), overlay.data(), num_leds);
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() /
+           kMeasuredFrames;
+  };
+  return {.scalar_nanos = measure(scalar), .word_nanos = measure(word)};
+}
+
+// The output stage as the wall firmware sets it up.
+OutputStage::Options WallOutputOptions() {
+  return {.white_balance = CRGB(TypicalLEDStrip),
+          .power_budget_milliamps = 20000};
+}
+
+// Time to pass a frame through the output stage, and the current it draws.
+struct OutputTimes {
+  double nanos;
+  uint32_t draw_milliamps;
+  uint8_t scale;
+};
+
+// Measures frames alternating between first and second, so that the power
+// limit of each frame is set from the other one, at full brightness.
+OutputTimes BenchmarkOutputStage(const std::vector<CRGB>& first,
+                                 const std::vector<CRGB>& second) {
+  OutputStage stage;
+  OutputStage::Options options = WallOutputOptions();
+  options.envelope.min_brightness = 255;
+  stage.Init(first.size(), options);
+  OutputTimes times = {.nanos = 0, .draw_milliamps = 0, .scale = 255};
+  for (int i = 0; i < kWarmupFrames + kMeasuredFrames; ++i) {
+    const std::vector<CRGB>& frame = i % 2 == 0 ? first : second;
+    auto start = std::chrono::steady_clock::now();
+    stage.Apply(0, frame.data());
+    auto end = std::chrono::steady_clock::now();
+    if (i < kWarmupFrames) continue;
+    times.nanos +=
+        std::chrono::duration<double, std::nano>(end - start).count();
+    times.draw_milliamps = std::max(times.draw_milliamps,
+                                    stage.draw_milliamps());
+    times.scale = std::min(times.scale, stage.scale());
+  }
+  times.nanos /= kMeasuredFrames;
+  return times;
+}
+
+// A segment layout sent through the mock driver.
+struct WireTimes {
+  int num_segments;
+  // LEDs of the longest segment.
+  int longest_segment;
+  uint32_t frame_micros;
+  // Host time to lay out the bytes of a frame.
+  double nanos;
+  // Bytes sent that don't match the frame.
+  int mismatches;
+};
+
+WireTimes BenchmarkSegments(const std::vector<LEDSegment>& segments,
+                            const std::vector<CRGB>& frame) {
+  MockOutputDriver driver(segments, kBRGOrder);
+  for (int i = 0; i < kWarmupFrames; ++i) driver.Show(frame.data());
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < kMeasuredFrames; ++i) driver.Show(frame.data());
+  auto end = std::chrono::steady_clock::now();
+  WireTimes times = {
+      .num_segments = int(segments.size()),
+      .longest_segment = 0,
+      .frame_micros = driver.frame_micros(),
+      .nanos = std::chrono::duration<double, std::nano>(end - start).count() /
+               kMeasuredFrames,
+      .mismatches = 0};
+  for (int s = 0; s < int(segments.size()); ++s) {
+    const LEDSegment& segment = segments[s];
+    times.longest_segment = std::max<int>(times.longest_segment,
+                                          segment.num_leds);
+    const std::vector<uint8_t>& bytes = driver.bytes(s);
+    for (int i = 0; i < segment.num_leds; ++i) {
+      const CRGB& led = frame[segment.first_led + i];
+      times.mismatches += bytes[3 * i] != led.b;
+      times.mismatches += bytes[3 * i + 1] != led.r;
+      times.mismatches += bytes[3 * i + 2] != led.g;
+    }
+  }
+  return times;
+}
+
+// Outgoing layers are re-rendered every few frames, every kReducedRateFrames
+// frames at most with several of them in flight.
+constexpr int kReducedRateFrames = 24;
+constexpr int kReducedRateRenders = 20;
+
+// Whether pattern_id draws the same frames when rendered every
+// kReducedRateFrames frames as when rendered every frame. Outgoing layers that
+// aren't frozen are rendered that way.
+bool SameAtReducedRate(PatternId pattern_id) {
+  auto full_rate = std::make_unique<LEDController>();
+  auto reduced_rate = std::make_unique<LEDController>();
+  VirtualClock clock(kFrameMicros);
+  for (LEDController* controller : {full_rate.get(), reduced_rate.get()}) {
+    controller->InitLEDs(kLEDMapping);
+    controller->set_clock(&clock);
+    controller->SetCurrentPattern(pattern_id, kSpeed, 0);
+  }
+  int num_leds = kLEDMapping.num_leds;
+  for (int frame = 0; frame < kReducedRateFrames * kReducedRateRenders;
+       ++frame) {
+    full_rate->Update();
+    const CRGB* full = full_rate->SwapBuffers();
+    if (frame % kReducedRateFrames == 0) {
+      reduced_rate->Update();
+      const CRGB* reduced = reduced_rate->SwapBuffers();
+      if (!std::equal(full, full + num_leds, reduced)) return false;
+    }
+    clock.Step();
+  }
+  return true;
+}
+
+// The cube's ambient cycle (see Cube): each pattern plays for two minutes, and
+// blends into the next one over a second.
+constexpr PatternId kAmbientPatterns[] = {kSpiral, kOutWave, kRose, kInWave,
+                                          kCircles};
+constexpr uint64_t kAmbientCycleMicros = 120 * 1000 * 1000;
+constexpr int kAmbientTransitionMillis = 1000;
+constexpr uint8_t kAmbientSpeed = 60;
+
+// Minutes of installation time simulated.
+constexpr int kSimulatedMinutes = 60;
+
+// A run of the wall on a virtual clock.
+struct SimulatedRun {
+  int frames = 0;
+  // Time the run took on the host.
+  double seconds = 0;
+  // FNV-1a hash of all the frames.
+  uint32_t hash = 2166136261u;
+};
+
+// Plays the ambient cycle for the given number of minutes of virtual time, on
+// a controller of its own, and hashes every frame. Runs with the same clock
+// draw the same frames.
+SimulatedRun SimulateAmbientCycle(int minutes) {
+  auto controller = std::make_unique<LEDController>();
+  controller->InitLEDs(kLEDMapping);
+  VirtualClock clock(kFrameMicros);
+  controller->set_clock(&clock);
+  uint64_t end_micros = uint64_t(minutes) * 60 * 1000 * 1000;
+  uint64_t next_pattern_micros = 0;
+  int next_pattern = 0;
+  SimulatedRun run;
+  auto start = std::chrono::steady_clock::now();
+  for (; clock.NowMicros() < end_micros; clock.Step()) {
+    if (clock.NowMicros() >= next_pattern_micros) {
+      controller->SetCurrentPattern(kAmbientPatterns[next_pattern],
+                                    kAmbientSpeed, kAmbientTransitionMillis);
+      next_pattern = (next_pattern + 1) % std::size(kAmbientPatterns);
+      next_pattern_micros += kAmbientCycleMicros;
+    }
+    controller->Update();
+    const CRGB* frame = controller->SwapBuffers();
+    for (int i = 0; i < controller->num_leds(); ++i) {
+      for (uint8_t channel : frame[i].raw) {
+        run.hash = (run.hash ^ channel) * 16777619u;
+      }
+    }
+    ++run.frames;
+  }
+  auto end = std::chrono::steady_clock::now();
+  run.seconds = std::chrono::duration<double>(end - start).count();
+  return run;
+}
+
+}  // namespace
+
+int main() {
+  // The controller is large, keep it off the stack.
+  static LEDController controller;
+  controller.InitLEDs(kLEDMapping);
+  controller.set_clock(&frame_clock);
+
+  std::printf("Mapping: %s, %d LEDs, %d frames per measurement\n\n",
+              kWall.name, kLEDMapping.num_leds, kMeasuredFrames);
+  std::printf("%-12s %12s %10s %16s %10s\n", "pattern", "ns/frame", "frames/s",
+              "transition ns", "frames/s");
+  for (int id = 0; id < kNumPatternIds; ++id) {
+    PatternId pattern_id = static_cast<PatternId>(id);
+    double nanos = BenchmarkPattern(controller, pattern_id);
+    double transition_nanos = BenchmarkTransition(controller, pattern_id);
+    std::printf("%-12s %12.0f %10.0f %16.0f %10.0f\n", PatternName(pattern_id),
+                nanos, 1e9 / nanos, transition_nanos, 1e9 / transition_nanos);
+  }
+
+  constexpr PatternId kMorphs[][2] = {
+      {kInWave, kOutWave}, {kOutWave, kInWave}, {kRose, kManBurn},
+      {kManBurn, kRose}};
+  std::printf("\n%-25s %12s %10s\n", "morph", "ns/frame", "frames/s");
+  for (const auto& [previous_id, pattern_id] : kMorphs) {
+    double nanos = BenchmarkMorph(controller, previous_id, pattern_id);
+    char name[32];
+    std::snprintf(name, sizeof(name), "%s -> %s", PatternName(previous_id),
+                  PatternName(pattern_id));
+    std::printf("%-25s %12.0f %10.0f\n", name, nanos, 1e9 / nanos);
+  }
+
+  std::printf("\n%-25s %12s %10s\n", "overlays", "ns/frame", "frames/s");
+  for (int num_overlays = 0; num_overlays <= SetLayerCommand::kMaxLayers;
+       ++num_overlays) {
+    double nanos = BenchmarkOverlays(controller, kSpiral, num_overlays);
+    char name[32];
+    std::snprintf(name, sizeof(name), "Spiral + %d", num_overlays);
+    std::printf("%-25s %12.0f %10.0f\n", name, nanos, 1e9 / nanos);
+  }
+
+  std::printf("\n%-25s %6s %12s %10s\n", "Spiral + Ripple in region",
+              "LEDs", "ns/frame", "frames/s");
+  for (int r = 0; r < int(Region::kNumRegions); ++r) {
+    Region region = Region(r);
+    int num_leds = 0;
+    for (int i = 0; i < kLEDMapping.num_leds; ++i) {
+      num_leds += InRegion(region, kLEDMapping.x[i], kLEDMapping.y[i],
+                           kLEDMapping.radius[i]);
+    }
+    double nanos = BenchmarkRegion(controller, kSpiral, region);
+    std::printf("%-25s %6d %12.0f %10.0f\n", RegionName(region), num_leds,
+                nanos, 1e9 / nanos);
+  }
+
+  GovernorRun governor = BenchmarkGovernor(controller, 0.6);
+  std::printf("\n%-25s %8s %10s\n", "governor", "frames", "ns/frame");
+  std::printf("%-25s %8s %10.0f\n", "No budget", "", governor.full_nanos);
+  for (int q = 0; q < FrameGovernor::kNumQualities; ++q) {
+    uint32_t frames = governor.stats.frames[q];
+    if (frames == 0) continue;
+    std::printf("%-25s %8u %10.0f\n", QualityName(RenderQuality(q)), frames,
+                1000.0 * governor.stats.micros[q] / frames);
+  }
+  std::printf("Budget %u us, stepped down %u times, up %u times.\n",
+              governor.budget_micros, governor.stats.steps_down,
+              governor.stats.steps_up);
+
+  std::printf("\n%-12s %12s %12s %8s\n", "program", "pattern ns",
+              "program ns", "ratio");
+  for (const EquivalentProgram& program : EquivalentPrograms()) {
+    double pattern_nanos = BenchmarkPattern(controller, program.pattern_id);
+    double program_nanos = BenchmarkProgram(controller, program.bytecode);
+    std::printf("%-12s %12.0f %12.0f %8.2f\n", PatternName(program.pattern_id),
+                pattern_nanos, program_nanos, program_nanos / pattern_nanos);
+  }
+
+  std::printf("\n%-12s %12s %10s\n", "origin", "ns/frame", "frames/s");
+  for (PatternId pattern_id : {kInWave, kSpiral, kRose}) {
+    double nanos = BenchmarkMovingOrigin(controller, pattern_id);
+    std::printf("%-12s %12.0f %10.0f\n", PatternName(pattern_id), nanos,
+                1e9 / nanos);
+  }
+
+  double polar_nanos = BenchmarkPolarCoordinates(kLEDMapping);
+  PolarError error = MeasurePolarError();
+  PolarError mapper_error = MeasureMappingPolarError(kLEDMapping);
+  std::printf("\n%-12s %12s %10s %10s %10s %10s %10s\n", "polar", "ns/frame",
+              "frames/s", "max angle", "mean", "max radius", "mean");
+  std::printf("%-12s %12.0f %10.0f %10.2f %10.2f %10.2f %10.2f\n", "All LEDs",
+              polar_nanos, 1e9 / polar_nanos, error.max_angle,
+              error.mean_angle, error.max_radius, error.mean_radius);
+  std::printf("%-12s %12s %10s %10.2f %10.2f %10.2f %10.2f\n", "LED Mapper",
+              "", "", mapper_error.max_angle, mapper_error.mean_angle,
+              mapper_error.max_radius, mapper_error.mean_radius);
+
+  double step_nanos = BenchmarkStencilStep(kLEDMapping);
+  std::printf("\n%-12s %12s %10s\n", "stencil", "ns/step", "steps/s");
+  std::printf("%-12s %12.0f %10.0f\n", "Diffusion", step_nanos,
+              1e9 / step_nanos);
+
+  std::printf("\n%-12s %12s %10s\n", "particles", "ns/frame", "frames/s");
+  for (int num_particles : {500, 1000, 2000, 4000}) {
+    double nanos = BenchmarkParticles(kLEDMapping, num_particles);
+    std::printf("%-12d %12.0f %10.0f\n", num_particles, nanos, 1e9 / nanos);
+  }
+
+  int num_leds = kLEDMapping.num_leds;
+  BenchmarkPattern(controller, kSpiral);
+  std::vector<CRGB> spiral(controller.front_buffer(),
+                           controller.front_buffer() + num_leds);
+  std::vector<CRGB> white(num_leds, CRGB::White);
+  std::vector<CRGB> black(num_leds, CRGB::Black);
+  uint32_t budget = WallOutputOptions().power_budget_milliamps;
+  std::printf("\n%-14s %10s %10s %10s %8s\n", "output", "ns/frame", "max mA",
+              "budget mA", "scale");
+  bool within_budget = true;
+  auto print_output = [&](const char* name, OutputTimes times) {
+    std::printf("%-14s %10.0f %10u %10u %8u\n", name, times.nanos,
+                times.draw_milliamps, budget, times.scale);
+    within_budget = within_budget && times.draw_milliamps <= budget;
+  };
+  print_output("Spiral", BenchmarkOutputStage(spiral, spiral));
+  print_output("White", BenchmarkOutputStage(white, white));
+  print_output("Black, white", BenchmarkOutputStage(black, white));
+
+  WordKernelMismatches kernel_mismatches = CountWordKernelMismatches();
+  std::printf("\n%-12s %12s %12s %8s %10s\n", "colors", "FastLED ns",
+              "words ns", "ratio", "mismatches");
+  auto print_kernel = [](const char* name, KernelTimes times,
+                         int mismatches) {
+    std::printf("%-12s %12.0f %12.0f %8.2f %10d\n", name, times.scalar_nanos,
+                times.word_nanos, times.word_nanos / times.scalar_nanos,
+                mismatches);
+  };
+  // The kernels are applied through TransformBytes, as Composite() applies
+  // them, over and over to the same LEDs: the scales and amounts are close to
+  // 255, so the LEDs don't all go black.
+  print_kernel("Scale", BenchmarkKernel(
+                            num_leds,
+                            [](CRGB* leds, const CRGB*, int n) {
+                              nscale8(leds, n, 250);
+                            },
+                            [](CRGB* leds, const CRGB*, int n) {
+                              TransformBytes(leds->raw, leds->raw, 3 * n,
+                                             [](uint32_t a, uint32_t) {
+                                               return Scale8x4(a, 250);
+                                             });
+                            }),
+               kernel_mismatches.scale);
+  print_kernel("Blend", BenchmarkKernel(
+                            num_leds,
+                            [](CRGB* leds, const CRGB* overlay, int n) {
+                              nblend(leds, overlay, n, 100);
+                            },
+                            [](CRGB* leds, const CRGB* overlay, int n) {
+                              TransformBytes(leds->raw, overlay->raw, 3 * n,
+                                             [](uint32_t a, uint32_t b) {
+                                               return Blend8x4(a, b, 100);
+                                             });
+                            }),
+               kernel_mismatches.blend);
+  print_kernel("Add", BenchmarkKernel(
+                          num_leds,
+                          [](CRGB* leds, const CRGB* overlay, int n) {
+                            for (int i = 0; i < n; ++i) leds[i] += overlay[i];
+                          },
+                          [](CRGB* leds, const CRGB* overlay, int n) {
+                            TransformBytes(leds->raw, overlay->raw, 3 * n,
+                                           QAdd8x4);
+                          }),
+               kernel_mismatches.add);
+  print_kernel("Max", BenchmarkKernel(
+                          num_leds,
+                          [](CRGB* leds, const CRGB* overlay, int n) {
+                            for (int i = 0; i < n; ++i) {
+                              for (int c = 0; c < 3; ++c) {
+                                leds[i].raw[c] =
+                                    std::max(leds[i].raw[c], overlay[i].raw[c]);
+                              }
+                            }
+                          },
+                          [](CRGB* leds, const CRGB* overlay, int n) {
+                            TransformBytes(leds->raw, overlay->raw, 3 * n,
+                                           Max8x4);
+                          }),
+               kernel_mismatches.max);
+  bool kernels_match = kernel_mismatches.scale == 0 &&
+                       kernel_mismatches.blend == 0 &&
+                       kernel_mismatches.add == 0 &&
+                       kernel_mismatches.max == 0;
+
+  std::printf("\n%-14s %8s %8s %10s %10s %10s %10s\n", "segments", "pins",
+              "longest", "wire us", "frames/s", "host ns", "mismatches");
+  bool segments_match = true;
+  auto print_segments = [&](const char* name, WireTimes times) {
+    std::printf("%-14s %8d %8d %10u %10.0f %10.0f %10d\n", name,
+                times.num_segments, times.longest_segment, times.frame_micros,
+                1e6 / times.frame_micros, times.nanos, times.mismatches);
+    segments_match = segments_match && times.mismatches == 0;
+  };
+  print_segments("Wall wiring",
+                 BenchmarkSegments(FitSegments(kLEDSegments, num_leds),
+                                   spiral));
+  const std::vector<uint8_t> kPins = {5, 4, 12, 13, 15, 19, 21, 25};
+  for (int num_segments : {2, 4, 8}) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "Split in %d", num_segments);
+    std::vector<uint8_t> pins(kPins.begin(), kPins.begin() + num_segments);
+    print_segments(name,
+                   BenchmarkSegments(SplitSegments(num_leds, pins), spiral));
+  }
+
+  // Stateful patterns are frozen once outgoing, the others must play the same
+  // when they are only refreshed now and then.
+  std::printf("\n%-12s %10s %12s\n", "reduced rate", "stateful",
+              "same frames");
+  bool reduced_rate_ok = true;
+  for (int id = 0; id < kNumPatternIds; ++id) {
+    PatternId pattern_id = static_cast<PatternId>(id);
+    bool stateful = controller.IsStateful(pattern_id);
+    bool same = SameAtReducedRate(pattern_id);
+    std::printf("%-12s %10s %12s\n", PatternName(pattern_id),
+                stateful ? "yes" : "no", same ? "yes" : "no");
+    reduced_rate_ok = reduced_rate_ok && (stateful || same);
+  }
+
+  ClimaxCheck climax = CheckClimaxFill(kLEDMapping);
+  std::printf("\n%-12s %12s %12s %8s %10s\n", "climax", "reference ns",
+              "fill ns", "ratio", "mismatches");
+  std::printf("%-12s %12.0f %12.0f %8.2f %10d\n", "Fill frames",
+              climax.reference_nanos, climax.fill_nanos,
+              climax.fill_nanos / climax.reference_nanos,
+              climax.mismatched_frames);
+
+  SimulatedRun first_run = SimulateAmbientCycle(kSimulatedMinutes);
+  SimulatedRun second_run = SimulateAmbientCycle(kSimulatedMinutes);
+  bool repeatable = first_run.hash == second_run.hash;
+  std::printf("\n%-14s %8s %8s %8s %10s %10s %10s\n", "virtual clock",
+              "minutes", "frames", "host s", "speedup", "hash", "repeated");
+  std::printf("%-14s %8d %8d %8.2f %10.0f %10x %10s\n", "Ambient cycle",
+              kSimulatedMinutes, first_run.frames, first_run.seconds,
+              kSimulatedMinutes * 60 / first_run.seconds, first_run.hash,
+              repeatable ? "same" : "different");
+  bool passed = climax.mismatched_frames == 0 && kernels_match &&
+                within_budget && segments_match && reduced_rate_ok &&
+                repeatable;
+  return passed ? 0 : 1;
+}
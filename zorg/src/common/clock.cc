@@ -0,0 +1,26 @@
+#include "common/clock.h"
+
+#include <cstdint>
+
+#ifdef ESP_PLATFORM
+#include <esp_timer.h>
+#else
+#include <chrono>
+#endif
+
+uint64_t SystemClock::NowMicros() const {
+#ifdef ESP_PLATFORM
+  // Arduino's millis() and micros() are read from the same timer, truncated to
+  // 32 bits.
+  return esp_timer_get_time();
+#else
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+const Clock& DefaultClock() {
+  static SystemClock clock;
+  return clock;
+}
@@ -58,19 +58,20 @@ uint64_t LatestInteractionTime(const std::vector<Wall>& walls) {
   return latest_interaction_time_;
 }
 
-// Checks whether the cube should climax. The cube climaxes when all the walls
-// are pressed, and the last interaction time is greater than the timeout.
-bool ShouldClimax(const std::vector<Wall>& walls) {
+// Checks whether the cube should climax at the given time. The cube climaxes
+// when all the walls are pressed, and the last interaction time is greater than
+// the timeout.
+bool ShouldClimax(const std::vector<Wall>& walls, uint64_t now_millis) {
   if (!WallsAllPressed(walls)) return false;
   uint64_t latest_interaction_time = LatestInteractionTime(walls);
-  uint64_t elapsed = millis() - latest_interaction_time;
+  uint64_t elapsed = now_millis - latest_interaction_time;
   return elapsed > Cube::kClimaxHeldDurationMillis;
 }
 
-// Check if the cube should glitch.
-bool ShouldGlitch(const std::vector<Wall>& walls) {
+// Check if the cube should glitch at the given time.
+bool ShouldGlitch(const std::vector<Wall>& walls, uint64_t now_millis) {
   uint64_t latest_interaction_time = LatestInteractionTime(walls);
-  uint64_t elapsed = millis() - latest_interaction_time;
+  uint64_t elapsed = now_millis - latest_interaction_time;
   return elapsed > Cube::kGlitchTimeoutMillis;
 }
 
@@ -97,17 +98,18 @@ void Cube::Connect() {
 
 void Cube::Update() {
   std::lock_guard<std::mutex> lock(mu_);
+  uint64_t now = clock_->NowMillis();
   switch (state_) {
     case CubeState::kAmbient: {
       // Cycle through ambient patterns.
-      if (millis() > next_pattern_time_) {
+      if (now > next_pattern_time_) {
         PatternId first_pattern_id = PatternId::kSpiral;
         PatternId last_pattern_id = PatternId::kCircles;
         current_ambient_pattern_ =
             static_cast<PatternId>(current_ambient_pattern_ + 1);
         if (current_ambient_pattern_ > last_pattern_id)
           current_ambient_pattern_ = first_pattern_id;
-        next_pattern_time_ = millis() + kAmbientCycleMillis;
+        next_pattern_time_ = now + kAmbientCycleMillis;
         for (Wall& wall : walls_) {
           wall.SetPattern(current_ambient_pattern_, kAmbientSpeed,
                           kAmbientTransitionMillis);
@@ -116,11 +118,11 @@ void Cube::Update() {
       break;
     }
     case CubeState::kTouched: {
-      if (ShouldGlitch(walls_)) {
+      if (ShouldGlitch(walls_, now)) {
         serial::Debug("Timed out, entering glitch state.");
         SetState(CubeState::kGlitched);
       }
-      if (ShouldClimax(walls_)) {
+      if (ShouldClimax(walls_, now)) {
         serial::Debug("Entering climax state.");
         SetState(CubeState::kClimax);
       }
@@ -128,7 +130,7 @@ void Cube::Update() {
     }
     case CubeState::kGlitched: {
       // Check if we need to exit glitched state.
-      uint64_t time_in_glitched_state_millis = millis() - state_entered_millis_;
+      uint64_t time_in_glitched_state_millis = now - state_entered_millis_;
       if (time_in_glitched_state_millis > kGlitchDurationMillis) {
         serial::Debug("Leaving glitched state.");
         SetState(CubeState::kRecovery);
@@ -137,7 +139,7 @@ void Cube::Update() {
     }
     case CubeState::kClimax: {
       // Check if we need to exit climax state.
-      uint64_t time_in_climax_state_millis = millis() - state_entered_millis_;
+      uint64_t time_in_climax_state_millis = now - state_entered_millis_;
       if (time_in_climax_state_millis > kClimaxDurationMillis) {
         serial::Debug("Leaving climax state.");
         SetState(CubeState::kRecovery);
@@ -146,7 +148,7 @@ void Cube::Update() {
     }
     case CubeState::kRecovery: {
       // Check if we need to exit the recovery state.
-      uint64_t time_in_recovery_state_millis = millis() - state_entered_millis_;
+      uint64_t time_in_recovery_state_millis = now - state_entered_millis_;
       if (time_in_recovery_state_millis > kRecoveryDurationMillis) {
         serial::Debug("Leaving recovery state.");
         SetState(CubeState::kAmbient);
@@ -154,7 +156,8 @@ void Cube::Update() {
       break;
     }
     case CubeState::kManBurn:
-    case CubeState::kTempleBurn: {
+    case CubeState::kTempleBurn:
+    case CubeState::kProgram: {
       // TODO: implement.
       break;
     }
@@ -168,6 +171,13 @@ Wall* Cube::GetWall(MacAddress address) {
   return nullptr;
 }
 
+int Cube::GetWallId(const MacAddress& address) const {
+  for (int wall_id = 0; wall_id < int(walls_.size()); ++wall_id) {
+    if (walls_[wall_id].address() == address) return wall_id;
+  }
+  return -1;
+}
+
 void Cube::OnHandEvent(const MacAddress& mac_address,
                        const HandEvent& hand_event) {
   std::lock_guard<std::mutex> lock(mu_);
@@ -178,13 +188,12 @@ void Cube::OnHandEvent(const MacAddress& mac_address,
   }
 
   // Set the state for that wall and update its pattern.
-  // TODO: use the number of pressed/unpressed walls to influence the patterns
-  // playing.
+  uint64_t now = clock_->NowMillis();
   if (hand_event.type == HandEventType::kPressed) {
-    wall->OnHandPressed();
+    wall->OnHandPressed(now);
   }
   if (hand_event.type == HandEventType::kReleased) {
-    wall->OnHandReleased();
+    wall->OnHandReleased(now);
   }
 
   if (state_ == CubeState::kGlitched || state_ == CubeState::kClimax ||
@@ -198,8 +207,10 @@ void Cube::OnHandEvent(const MacAddress& mac_address,
     return;
   }
 
-  if (state_ == CubeState::kManBurn || state_ == CubeState::kTempleBurn) {
-    serial::Debug("Cube is in man burn/temple burn mode, ignoring hand.");
+  if (state_ == CubeState::kManBurn || state_ == CubeState::kTempleBurn ||
+      state_ == CubeState::kProgram) {
+    serial::Debug(
+        "Cube is in man burn/temple burn/program mode, ignoring hand.");
     // Don't play a dull sound for those modes.
     return;
   }
@@ -210,18 +221,21 @@ void Cube::OnHandEvent(const MacAddress& mac_address,
   }
   SetState(CubeState::kTouched);
 
-  // Check how many walls are pressed, and set the patterns accordingly.
+  // Check how many walls are pressed, and set the patterns accordingly: they
+  // get faster and brighter as more hands are pressed.
   int num_walls_pressed = WallPressedCount(walls_);
   float pressed_ratio = (float)num_walls_pressed / (float)walls_.size();
   uint8_t min_speed = 60;
   uint8_t max_speed = 180;
   uint8_t diff = max_speed - min_speed;
   uint8_t speed = min_speed + (pressed_ratio * diff);
+  uint8_t intensity =
+      kMinTouchedIntensity + pressed_ratio * (255 - kMinTouchedIntensity);
   for (Wall& wall : walls_) {
     if (wall.pressed()) {
-      wall.SetPattern(PatternId::kInWave, speed, 200);
+      wall.SetPattern(PatternId::kInWave, speed, 200, intensity);
     } else {
-      wall.SetPattern(PatternId::kAwaitTouch, speed, 200);
+      wall.SetPattern(PatternId::kAwaitTouch, speed, 200, intensity);
     }
   }
   // Play the pressed sound.
@@ -231,6 +245,7 @@ void Cube::OnHandEvent(const MacAddress& mac_address,
 void Cube::SetNormalMode() { SetState(CubeState::kAmbient); }
 void Cube::SetManBurnMode() { SetState(CubeState::kManBurn); }
 void Cube::SetTempleBurnMode() { SetState(CubeState::kTempleBurn); }
+void Cube::SetProgramMode() { SetState(CubeState::kProgram); }
 
 void Cube::SetLedsEnabled(bool enabled) {
   for (Wall& wall : walls_) {
@@ -238,10 +253,16 @@ void Cube::SetLedsEnabled(bool enabled) {
   }
 }
 
+void Cube::UploadProgram(const UploadProgramCommand& command) {
+  for (Wall& wall : walls_) {
+    wall.SendUploadProgramCommand(command);
+  }
+}
+
 void Cube::SetState(CubeState state) {
   if (state_ == state) return;
   state_ = state;
-  state_entered_millis_ = millis();
+  state_entered_millis_ = clock_->NowMillis();
   switch (state) {
     case CubeState::kAmbient: {
       // When entering the default state, set all the walls to the current
@@ -250,7 +271,7 @@ void Cube::SetState(CubeState state) {
         wall.SetPattern(current_ambient_pattern_, kAmbientSpeed,
                         kAmbientTransitionMillis);
       }
-      next_pattern_time_ = millis() + kAmbientCycleMillis;
+      next_pattern_time_ = state_entered_millis_ + kAmbientCycleMillis;
       // Start playing the ambient sound.
       serial::PlayAmbientSound();
       break;
@@ -293,5 +314,12 @@ void Cube::SetState(CubeState state) {
       serial::PlayAmbientSound();
       break;
     }
+    case CubeState::kProgram: {
+      for (Wall& wall : walls_) {
+        wall.SetPattern(PatternId::kProgram, 60, 1000);
+      }
+      serial::PlayAmbientSound();
+      break;
+    }
   }
 }
@@ -7,6 +7,7 @@
 #include <optional>
 #include <vector>
 
+#include "common/clock.h"
 #include "common/common.h"
 #include "common/messages.h"
 #include "master/cube.h"
@@ -47,6 +48,13 @@ void OnDataReceived(const uint8_t* raw_addr, const uint8_t* data,
 
     // Let the cube handle the event.
     cube.OnHandEvent(address, event);
+  } else if (doc[kMethod] == MappingUploadStatus::kMethodName) {
+    // Let the PC send the next chunk.
+    int wall_id = cube.GetWallId(address);
+    if (wall_id >= 0) {
+      serial::SendMappingUploadStatus(
+          wall_id, MappingUploadStatus::FromJsonCommand(doc));
+    }
   }
 }
 
@@ -108,6 +116,13 @@ void loop() {
       if (wall != nullptr) {
         wall->SendSetTouchThresholdCommand(params[kTouchThresholdParam]);
       }
+    } else if (method == kSetWallVariantMethod) {
+      // Forward the message to the wall.
+      int wall_id = params[kWallIdParam];
+      Wall* wall = cube.GetWall(wall_id);
+      if (wall != nullptr) {
+        wall->SendSetWallVariantCommand(params[kWallVariantParam]);
+      }
     } else if (method == kSetCubeModeMethod) {
       const std::string& mode = params[kCubeModeParam];
       if (mode == kNormalMode) {
@@ -116,15 +131,44 @@ void loop() {
         cube.SetManBurnMode();
       } else if (mode == kTempleBurnMode) {
         cube.SetTempleBurnMode();
+      } else if (mode == kProgramMode) {
+        cube.SetProgramMode();
       }
     } else if (method == kSetLedsEnabledMethod) {
       cube.SetLedsEnabled(params[kEnabledParam]);
+    } else if (method == UploadProgramCommand::kMethodName) {
+      // Forward the program to all the walls.
+      cube.UploadProgram(UploadProgramCommand::FromJsonCommand(doc));
+    } else if (method == SetPatternParamsCommand::kMethodName) {
+      // Forward the message to the wall.
+      int wall_id = params[kWallIdParam];
+      Wall* wall = cube.GetWall(wall_id);
+      if (wall != nullptr) {
+        wall->SendSetPatternParamsCommand(
+            SetPatternParamsCommand::FromJsonCommand(doc));
+      }
+    } else if (method == SetLayerCommand::kMethodName) {
+      // Forward the message to the wall.
+      int wall_id = params[kWallIdParam];
+      Wall* wall = cube.GetWall(wall_id);
+      if (wall != nullptr) {
+        wall->SendSetLayerCommand(SetLayerCommand::FromJsonCommand(doc));
+      }
+    } else if (method == UploadMappingChunkCommand::kMethodName) {
+      // Forward the chunk to the wall.
+      int wall_id = params[kWallIdParam];
+      Wall* wall = cube.GetWall(wall_id);
+      if (wall != nullptr) {
+        wall->SendUploadMappingChunkCommand(
+            UploadMappingChunkCommand::FromJsonCommand(doc));
+      }
     }
   }
   cube.Update();
 
-  if ((millis() - last_update_time_millis) > update_delay_millis) {
-    last_update_time_millis = millis();
+  uint64_t now = DefaultClock().NowMillis();
+  if ((now - last_update_time_millis) > update_delay_millis) {
+    last_update_time_millis = now;
     serial::UpdateStatus(cube);
   }
 }
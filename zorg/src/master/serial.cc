@@ -85,4 +85,10 @@ void UpdateStatus(const Cube& cube) {
   SendJson(msg);
 }
 
+void SendMappingUploadStatus(int wall_id, const MappingUploadStatus& status) {
+  ArduinoJson::JsonDocument msg = status.ToJsonCommand();
+  msg[kParams][kWallIdParam] = wall_id;
+  SendJson(msg);
+}
+
 }  // namespace serial
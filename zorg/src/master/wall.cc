@@ -4,6 +4,7 @@
 #include <esp_now.h>
 
 #include <cstdint>
+#include <string>
 
 #include "common/common.h"
 #include "common/messages.h"
@@ -18,17 +19,32 @@ void Wall::Connect() {
 }
 
 void Wall::SetPattern(PatternId pattern_id, uint8_t pattern_speed,
-                      int transition_duration_millis) {
+                      int transition_duration_millis, uint8_t intensity) {
   SendSetPatternCommand(SetPatternCommand{
       .pattern_id = pattern_id,
       .pattern_speed = pattern_speed,
       .transition_duration_millis = transition_duration_millis});
+  // The wall applies the parameters to the pattern it switched to, even when
+  // both commands arrive within a frame.
+  SetPatternParamsCommand params;
+  params.intensity = intensity;
+  params.transition_duration_millis = transition_duration_millis;
+  SendSetPatternParamsCommand(params);
 }
 
 void Wall::SendSetPatternCommand(const SetPatternCommand& command) const {
   Send(command.ToJsonCommand());
 }
 
+void Wall::SendSetPatternParamsCommand(
+    const SetPatternParamsCommand& command) const {
+  Send(command.ToJsonCommand());
+}
+
+void Wall::SendSetLayerCommand(const SetLayerCommand& command) const {
+  Send(command.ToJsonCommand());
+}
+
 void Wall::SendRestartCommand() const {
   ArduinoJson::JsonDocument doc;
   doc[kMethod] = kRestartMethod;
@@ -42,6 +58,13 @@ void Wall::SendSetTouchThresholdCommand(uint16_t threshold) const {
   Send(doc);
 }
 
+void Wall::SendSetWallVariantCommand(const std::string& variant) const {
+  ArduinoJson::JsonDocument doc;
+  doc[kMethod] = kSetWallVariantMethod;
+  doc[kParams][kWallVariantParam] = variant;
+  Send(doc);
+}
+
 void Wall::SendSetLedsEnabledCommand(bool enabled) const {
   ArduinoJson::JsonDocument doc;
   doc[kMethod] = kSetLedsEnabledMethod;
@@ -49,14 +72,24 @@ void Wall::SendSetLedsEnabledCommand(bool enabled) const {
   Send(doc);
 }
 
-void Wall::OnHandPressed() {
+void Wall::SendUploadProgramCommand(
+    const UploadProgramCommand& command) const {
+  Send(command.ToJsonCommand());
+}
+
+void Wall::SendUploadMappingChunkCommand(
+    const UploadMappingChunkCommand& command) const {
+  Send(command.ToJsonCommand());
+}
+
+void Wall::OnHandPressed(uint64_t now_millis) {
   pressed_ = true;
-  last_interaction_time_millis_ = millis();
+  last_interaction_time_millis_ = now_millis;
 }
 
-void Wall::OnHandReleased() {
+void Wall::OnHandReleased(uint64_t now_millis) {
   pressed_ = false;
-  last_interaction_time_millis_ = millis();
+  last_interaction_time_millis_ = now_millis;
 }
 
 void Wall::Send(const ArduinoJson::JsonDocument& doc) const {
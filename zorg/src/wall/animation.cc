@@ -2,98 +2,598 @@
 
 #include <pixeltypes.h>
 
+#include <algorithm>
 #include <cmath>
 #include <vector>
 
-LEDController::LEDController() {
-  patterns_.resize(PatternId::kNumPatternIds);
-  patterns_[PatternId::kNone] = std::make_unique<NonePattern>();
-  patterns_[PatternId::kSpiral] = std::make_unique<SpiralPattern>();
-  patterns_[PatternId::kRose] = std::make_unique<RosePattern>();
-  patterns_[PatternId::kCircles] = std::make_unique<CirclesPattern>();
-  patterns_[PatternId::kInWave] =
-      std::make_unique<WavePattern>(WavePattern::Direction::kIn);
-  patterns_[PatternId::kOutWave] =
-      std::make_unique<WavePattern>(WavePattern::Direction::kOut);
-  patterns_[PatternId::kAwaitTouch] = std::make_unique<AwaitTouchPattern>();
-  patterns_[PatternId::kGlitch] = std::make_unique<GlitchPattern>();
-  patterns_[PatternId::kClimax] = std::make_unique<ClimaxPattern>();
-  patterns_[PatternId::kRecovery] = std::make_unique<RecoveryPattern>();
-  patterns_[PatternId::kManBurn] = std::make_unique<ManBurnPattern>();
-  patterns_[PatternId::kTempleBurn] = std::make_unique<TempleBurnPattern>();
-}
-
-void LEDController::InitLEDs(int num_leds, const std::vector<uint8_t> coordsX,
-                             const std::vector<uint8_t> coordsY,
-                             const std::vector<uint8_t> angles,
-                             const std::vector<uint8_t> radii) {
-  InitBuffers(num_leds);
+namespace {
+
+// Blends the color of a layer over a pixel, by the blend mode and the layer's
+// opacity.
+template <BlendMode kMode>
+inline void BlendOver(const CRGB& color, fract8 opacity, CRGB& pixel) {
+  for (int c = 0; c < 3; ++c) {
+    uint8_t blended = BlendChannel(kMode, pixel.raw[c], color.raw[c]);
+    pixel.raw[c] =
+        opacity == 255 ? blended : blend8(pixel.raw[c], blended, opacity);
+  }
+}
+
+// Same, with the blend mode chosen at run time.
+inline void BlendOver(BlendMode mode, const CRGB& color, fract8 opacity,
+                      CRGB& pixel) {
+  switch (mode) {
+    case BlendMode::kAdd:
+      BlendOver<BlendMode::kAdd>(color, opacity, pixel);
+      return;
+    case BlendMode::kScreen:
+      BlendOver<BlendMode::kScreen>(color, opacity, pixel);
+      return;
+    case BlendMode::kMultiply:
+      BlendOver<BlendMode::kMultiply>(color, opacity, pixel);
+      return;
+    case BlendMode::kNormal:
+      BlendOver<BlendMode::kNormal>(color, opacity, pixel);
+      return;
+    case BlendMode::kMax:
+    case BlendMode::kNumBlendModes:
+      break;
+  }
+  BlendOver<BlendMode::kMax>(color, opacity, pixel);
+}
+
+// Whether BlendOverWords() handles the blend mode: whether the blend mode
+// combines channels without multiplying them together.
+inline bool BlendsWords(BlendMode mode) {
+  return mode == BlendMode::kAdd || mode == BlendMode::kMax ||
+         mode == BlendMode::kNormal;
+}
+
+// BlendChannel() of 4 channels packed in words, for the modes BlendsWords()
+// accepts.
+template <BlendMode kMode>
+inline uint32_t BlendChannels(uint32_t a, uint32_t b) {
+  if constexpr (kMode == BlendMode::kAdd) return QAdd8x4(a, b);
+  if constexpr (kMode == BlendMode::kMax) return Max8x4(a, b);
+  return b;
+}
+
+// Blends the colors of a layer over the LEDs, like BlendOver() for each LED,
+// 4 channels at a time.
+template <BlendMode kMode>
+inline void BlendOverWords(const CRGB* colors, fract8 opacity, CRGB* leds,
+                           int num_leds) {
+  if (opacity == 255) {
+    TransformBytes(leds->raw, colors->raw, 3 * num_leds, BlendChannels<kMode>);
+    return;
+  }
+  TransformBytes(leds->raw, colors->raw, 3 * num_leds,
+                 [opacity](uint32_t pixel, uint32_t color) {
+                   return Blend8x4(pixel, BlendChannels<kMode>(pixel, color),
+                                   opacity);
+                 });
+}
+
+// Same, with the blend mode chosen at run time.
+inline void BlendOverWords(BlendMode mode, const CRGB* colors, fract8 opacity,
+                           CRGB* leds, int num_leds) {
+  switch (mode) {
+    case BlendMode::kAdd:
+      BlendOverWords<BlendMode::kAdd>(colors, opacity, leds, num_leds);
+      return;
+    case BlendMode::kMax:
+      BlendOverWords<BlendMode::kMax>(colors, opacity, leds, num_leds);
+      return;
+    default:
+      break;
+  }
+  BlendOverWords<BlendMode::kNormal>(colors, opacity, leds, num_leds);
+}
+
+}  // namespace
+
+Palette HuePalette(uint8_t hue, uint8_t sat, uint8_t intensity) {
+  Palette palette;
+  for (int v = 0; v < 256; ++v) {
+    palette[v].setHSV(hue, sat, scale8(v, intensity));
+  }
+  return palette;
+}
+
+Palette HeatPalette() {
+  Palette palette;
+  for (int v = 0; v < 256; ++v) {
+    palette[v] = HeatColor(v);
+  }
+  return palette;
+}
+
+void ClimaxFill::Init(int num_leds, const RandomFrame& random) {
+  std::vector<uint8_t> thresholds(num_leds);
+  random.Fill8(thresholds.data(), num_leds);
+  // Counting sort, which keeps the LEDs of each threshold in index order.
+  int starts[257] = {};
+  for (uint8_t threshold : thresholds) ++starts[threshold + 1];
+  for (int t = 0; t < 256; ++t) starts[t + 1] += starts[t];
+  order_.resize(num_leds);
+  thresholds_.resize(num_leds);
   for (int i = 0; i < num_leds; ++i) {
-    led_buffer_.AddLED(coordsX[i], coordsY[i], angles[i], radii[i]);
-    previous_buffer_.AddLED(coordsX[i], coordsY[i], angles[i], radii[i]);
+    int k = starts[thresholds[i]]++;
+    order_[k] = i;
+    thresholds_[k] = thresholds[i];
   }
+  glow_.assign(num_leds, CRGB::Black);
+  num_lit_ = 0;
+  num_full_ = 0;
 }
 
-void LEDController::InitBuffers(int num_leds) {
-  led_buffer_.Init(num_leds);
-  previous_buffer_.Init(num_leds);
+void ClimaxFill::Advance(uint8_t fill_progress, CRGB* leds) {
+  int num_leds = order_.size();
+  while (num_lit_ < num_leds && thresholds_[num_lit_] < fill_progress) {
+    ++num_lit_;
+  }
+  const CRGB step = CHSV(10, 10, 1);
+  while (num_full_ < num_lit_) {
+    CRGB brighter = glow_[order_[num_full_]];
+    brighter += step;
+    if (brighter != glow_[order_[num_full_]]) break;
+    ++num_full_;
+  }
+  for (int k = num_full_; k < num_lit_; ++k) {
+    glow_[order_[k]] += step;
+  }
+  std::copy(glow_.begin(), glow_.end(), leds);
+}
+
+PatternParams Pattern::CurrentParams() const {
+  auto rounded = [this](auto param) { return (Param88(param) + 128) >> 8; };
+  PatternParams params;
+  params.zoom = rounded(&PatternParams::zoom);
+  params.shape = rounded(&PatternParams::shape);
+  params.petals = rounded(&PatternParams::petals);
+  params.twist = rounded(&PatternParams::twist);
+  params.strands = rounded(&PatternParams::strands);
+  params.scale = rounded(&PatternParams::scale);
+  params.direction = rounded(&PatternParams::direction);
+  params.hue = rounded(&PatternParams::hue);
+  params.hue_spread = rounded(&PatternParams::hue_spread);
+  params.intensity = rounded(&PatternParams::intensity);
+  params.origin_x = rounded(&PatternParams::origin_x);
+  params.origin_y = rounded(&PatternParams::origin_y);
+  return params;
+}
+
+LEDController::LEDController() {
+  patterns_[PatternId::kNone].emplace<NonePattern>();
+  patterns_[PatternId::kSpiral].emplace<SpiralPattern>();
+  patterns_[PatternId::kRose].emplace<RosePattern>();
+  patterns_[PatternId::kCircles].emplace<CirclesPattern>();
+  patterns_[PatternId::kInWave].emplace<WavePattern>(
+      WavePattern::Direction::kIn);
+  patterns_[PatternId::kOutWave].emplace<WavePattern>(
+      WavePattern::Direction::kOut);
+  patterns_[PatternId::kAwaitTouch].emplace<AwaitTouchPattern>();
+  patterns_[PatternId::kGlitch].emplace<GlitchPattern>();
+  patterns_[PatternId::kClimax].emplace<ClimaxPattern>();
+  patterns_[PatternId::kRecovery].emplace<RecoveryPattern>();
+  PatternParams man_burn_params;
+  man_burn_params.hue_spread = 128;
+  patterns_[PatternId::kManBurn].emplace<RosePattern>(man_burn_params);
+  patterns_[PatternId::kTempleBurn].emplace<TempleBurnPattern>();
+  patterns_[PatternId::kProgram].emplace<ProgramPattern>();
+  patterns_[PatternId::kDiffusion].emplace<DiffusionPattern>();
+  patterns_[PatternId::kRipple].emplace<RipplePattern>();
+  patterns_[PatternId::kSparks].emplace<SparksPattern>();
+  patterns_[PatternId::kEmbers].emplace<EmbersPattern>();
+  patterns_[PatternId::kSwarm].emplace<SwarmPattern>();
+}
+
+void LEDController::InitLEDs(const LEDMapping& mapping) {
+  geometry_ = LEDGeometry(mapping);
+  led_buffers_[0].Init(&geometry_);
+  led_buffers_[1].Init(&geometry_);
+  for (LEDBuffer& buffer : outgoing_buffers_) {
+    buffer.Init(&geometry_);
+  }
+  composite_scratch_.assign(num_leds(), CRGB::Black);
+  for (std::optional<RegionLayout>& region : regions_) {
+    region.reset();
+  }
+  for (AnyPattern& any_pattern : patterns_) {
+    std::visit(
+        [&mapping](Pattern& pattern) {
+          PatternParams params = pattern.params();
+          params.origin_x = mapping.origin_x;
+          params.origin_y = mapping.origin_y;
+          pattern.SetParams(params);
+        },
+        any_pattern);
+  }
+}
+
+const LEDGeometry& LEDController::RegionGeometry(Region region) {
+  if (region == Region::kWall) return geometry_;
+  std::optional<RegionLayout>& layout = regions_[int(region)];
+  if (!layout.has_value()) {
+    layout.emplace();
+    layout->region.Init(geometry_.mapping(), region);
+    layout->geometry = LEDGeometry(layout->region.mapping());
+  }
+  return layout->geometry;
 }
 
 void LEDController::SetCurrentPattern(PatternId pattern_id,
                                       uint8_t pattern_speed,
                                       int transition_duration_millis) {
   std::lock_guard<std::mutex> lock(mu_);
-  if (current_pattern_id_ == pattern_id) {
-    // Same pattern, just update the speed.
-    current_pattern_speed_ = pattern_speed;
+  // Only the latest command matters, the render task picks it up on the next
+  // frame.
+  pending_command_ = SetPatternCommand{
+      .pattern_id = pattern_id,
+      .pattern_speed = pattern_speed,
+      .transition_duration_millis = transition_duration_millis};
+}
+
+void LEDController::SetPatternParams(const SetPatternParamsCommand& command) {
+  std::lock_guard<std::mutex> lock(mu_);
+  if (pending_params_command_.has_value()) {
+    pending_params_command_->MergeFrom(command);
   } else {
-    previous_pattern_id_ = current_pattern_id_;
-    previous_pattern_speed_ = current_pattern_speed_;
-    current_pattern_id_ = pattern_id;
-    current_pattern_speed_ = pattern_speed;
-    transition_start_millis_ = millis();
-    transition_duration_millis_ = transition_duration_millis;
-    patterns_[current_pattern_id_]->Reset();
+    pending_params_command_ = command;
   }
 }
 
-void LEDController::Update() {
+void LEDController::SetProgram(const PatternProgram& program) {
+  std::lock_guard<std::mutex> lock(mu_);
+  pending_program_ = program;
+}
+
+void LEDController::SetLayer(const SetLayerCommand& command) {
+  if (command.layer < 0 || command.layer >= SetLayerCommand::kMaxLayers) {
+    Serial.printf("No layer %d.\n", command.layer);
+    return;
+  }
   std::lock_guard<std::mutex> lock(mu_);
-  // Return early if the LEDs should be off.
-  if (!enabled_) return;
-
-  // Call the current pattern.
-  Pattern* current_pattern = patterns_[current_pattern_id_].get();
-  if (current_pattern == nullptr) {
-    EVERY_N_SECONDS(1) {
-      Serial.printf("No pattern registered for id=%d.\n", current_pattern_id_);
+  pending_layer_commands_[command.layer] = command;
+}
+
+void LEDController::ApplyCommand(const SetPatternCommand& command) {
+  if (command.pattern_id >= PatternId::kNumPatternIds) {
+    Serial.printf("No pattern registered for id=%d.\n", command.pattern_id);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    current_pattern_id_ = command.pattern_id;
+  }
+  if (current_layer_.pattern_id == command.pattern_id) {
+    // Same pattern, just update the speed.
+    current_layer_.speed = command.pattern_speed;
+    return;
+  }
+
+  PatternFamily family = pattern(command.pattern_id).family();
+  if (command.transition_duration_millis > 0 &&
+      family != PatternFamily::kNone &&
+      family == pattern(current_layer_.pattern_id).family()) {
+    MorphTo(command);
+    return;
+  }
+
+  uint64_t now = now_millis_;
+  if (command.transition_duration_millis <= 0) {
+    num_outgoing_layers_ = 0;
+  } else if (num_outgoing_layers_ == kMaxOutgoingLayers) {
+    // Out of layers: flatten all of them into the frame currently on the LEDs,
+    // which already has the current pattern blended in.
+    std::copy_n(front_buffer(), num_leds(),
+                outgoing_buffers_[0].raw_led_data());
+    outgoing_layers_[0] = PatternLayer{.frozen = true};
+    num_outgoing_layers_ = 1;
+  } else {
+    // The current pattern becomes an outgoing layer. A stateful one keeps
+    // this frame.
+    Render(current_layer_, now, outgoing_buffers_[num_outgoing_layers_]);
+    outgoing_layers_[num_outgoing_layers_] = current_layer_;
+    outgoing_layers_[num_outgoing_layers_].frozen =
+        pattern(current_layer_.pattern_id).stateful();
+    ++num_outgoing_layers_;
+  }
+
+  // The new pattern is reset, so outgoing layers playing the same pattern can't
+  // keep rendering it. Neither can outgoing layers playing an overlay's
+  // pattern, which renders every frame.
+  for (int i = 0; i < num_outgoing_layers_; ++i) {
+    if (outgoing_layers_[i].pattern_id == command.pattern_id ||
+        IsOverlayPattern(outgoing_layers_[i].pattern_id)) {
+      outgoing_layers_[i].frozen = true;
     }
+  }
+
+  current_layer_ = PatternLayer{
+      .pattern_id = command.pattern_id,
+      .speed = command.pattern_speed,
+      .fade_start_millis = now,
+      .fade_duration_millis = uint64_t(std::max(
+          command.transition_duration_millis, 0))};
+  pattern(command.pattern_id).Reset();
+}
+
+void LEDController::MorphTo(const SetPatternCommand& command) {
+  uint64_t now = now_millis_;
+  Pattern& next = pattern(command.pattern_id);
+  // The current pattern was last rendered with these parameters.
+  PatternParams from = pattern(current_layer_.pattern_id).CurrentParams();
+  next.Reset();
+  next.StartMorph(from);
+
+  // The new pattern renders in place of the current one, and keeps fading in
+  // over the outgoing layers if it was.
+  for (int i = 0; i < num_outgoing_layers_; ++i) {
+    if (outgoing_layers_[i].pattern_id == command.pattern_id) {
+      outgoing_layers_[i].frozen = true;
+    }
+  }
+  current_layer_.pattern_id = command.pattern_id;
+  current_layer_.speed = command.pattern_speed;
+  current_layer_.morph_start_millis = now;
+  current_layer_.morph_duration_millis = command.transition_duration_millis;
+}
+
+void LEDController::ApplyParamsCommand(const SetPatternParamsCommand& command) {
+  Pattern& current = pattern(current_layer_.pattern_id);
+  PatternParams from = current.CurrentParams();
+  current.SetParams(command.ApplyTo(current.params()));
+  current.StartMorph(from);
+  current_layer_.morph_start_millis = now_millis_;
+  current_layer_.morph_duration_millis =
+      std::max(command.transition_duration_millis, 0);
+}
+
+void LEDController::ApplyLayerCommand(const SetLayerCommand& command) {
+  OverlayLayer& overlay = overlays_[command.layer];
+  if (command.pattern_id >= PatternId::kNumPatternIds ||
+      command.blend_mode >= BlendMode::kNumBlendModes ||
+      command.region >= Region::kNumRegions) {
+    Serial.printf("Invalid layer pattern id=%d, blend mode=%d or region=%d.\n",
+                  command.pattern_id, int(command.blend_mode),
+                  int(command.region));
     return;
   }
-  current_pattern->Update(led_buffer_, current_pattern_speed_);
-
-  // Calculate how much to blend the current pattern with the previous
-  // pattern.
-  uint64_t elapsed = millis() - transition_start_millis_;
-  if (elapsed < transition_duration_millis_) {
-    float ratio = float(elapsed) / float(transition_duration_millis_);
-    fract8 blend = ratio * 255;
-    blend = ease8InOutCubic(blend);
-    // Fade in the current pattern.
-    fadeToBlackBy(led_buffer_.raw_led_data(), led_buffer_.num_leds(),
-                  255 - blend);
-    // Call the previous pattern's function, but store in the alternate buffer.
-    Pattern* previous_pattern = patterns_[previous_pattern_id_].get();
-    if (previous_pattern == nullptr) {
-      EVERY_N_SECONDS(1) {
-        Serial.printf("No pattern registered for id=%d.\n",
-                      previous_pattern_id_);
+  bool is_palette_pattern = std::visit(
+      [](auto& pattern) {
+        return std::is_base_of_v<PalettePattern,
+                                 std::decay_t<decltype(pattern)>>;
+      },
+      patterns_[command.pattern_id]);
+  if (command.pattern_id != PatternId::kNone && !is_palette_pattern) {
+    Serial.printf("Pattern id=%d can't be drawn as a layer.\n",
+                  command.pattern_id);
+    return;
+  }
+  if (overlay.pattern_id != command.pattern_id &&
+      command.pattern_id != PatternId::kNone) {
+    // Like a new current pattern, the overlay's pattern starts over, unless it
+    // is the current pattern, and outgoing layers playing it can't keep
+    // rendering it.
+    for (int i = 0; i < num_outgoing_layers_; ++i) {
+      if (outgoing_layers_[i].pattern_id == command.pattern_id) {
+        outgoing_layers_[i].frozen = true;
       }
-      return;
     }
-    previous_pattern->Update(previous_buffer_, previous_pattern_speed_);
-    // Blend the two.
-    nblend(led_buffer_.raw_led_data(), previous_buffer_.raw_led_data(),
-           led_buffer_.num_leds(), 255 - blend);
+    if (command.pattern_id != current_layer_.pattern_id) {
+      pattern(command.pattern_id).Reset();
+    }
+  }
+  if (command.pattern_id != PatternId::kNone) {
+    overlay_indices_[command.layer].resize(
+        RegionGeometry(command.region).num_leds());
+  }
+  overlay = OverlayLayer{.pattern_id = command.pattern_id,
+                         .speed = command.pattern_speed,
+                         .opacity = command.opacity,
+                         .blend_mode = command.blend_mode,
+                         .region = command.region};
+}
+
+void LEDController::Render(const PatternLayer& layer, uint64_t now_millis,
+                           LEDBuffer& buffer) {
+  std::visit(
+      [&](auto& pattern) {
+        pattern.set_morph_amount(layer.MorphAmount(now_millis));
+        pattern.Update(buffer, layer.speed);
+      },
+      patterns_[layer.pattern_id]);
+}
+
+fract8 LEDController::DropHiddenLayers(uint64_t now_millis) {
+  fract8 current_opacity = current_layer_.Opacity(now_millis);
+  if (current_opacity == 255) {
+    num_outgoing_layers_ = 0;
+    return current_opacity;
+  }
+  // Find the topmost outgoing layer that fully covers the ones below it.
+  int bottom = 0;
+  for (int i = num_outgoing_layers_ - 1; i > 0; --i) {
+    if (outgoing_layers_[i].Opacity(now_millis) == 255) {
+      bottom = i;
+      break;
+    }
+  }
+  if (bottom == 0) return current_opacity;
+  for (int i = bottom; i < num_outgoing_layers_; ++i) {
+    outgoing_layers_[i - bottom] = outgoing_layers_[i];
+    std::swap(outgoing_buffers_[i - bottom], outgoing_buffers_[i]);
+  }
+  num_outgoing_layers_ -= bottom;
+  return current_opacity;
+}
+
+int LEDController::RenderOverlays(RenderedOverlay* overlays) {
+  bool half_rate = governor_.quality() >= RenderQuality::kHalfRateOverlays;
+  int num_overlays = 0;
+  for (int i = 0; i < SetLayerCommand::kMaxLayers; ++i) {
+    OverlayLayer& overlay = overlays_[i];
+    if (overlay.pattern_id == PatternId::kNone || overlay.opacity == 0 ||
+        overlay.pattern_id == current_layer_.pattern_id) {
+      continue;
+    }
+    const LEDGeometry& geometry = RegionGeometry(overlay.region);
+    if (geometry.num_leds() == 0) continue;
+    uint8_t* indices = overlay_indices_[i].data();
+    std::visit(
+        [&](auto& pattern) {
+          using P = std::decay_t<decltype(pattern)>;
+          if constexpr (std::is_base_of_v<PalettePattern, P>) {
+            // Layers take turns, so they aren't all rendered on the same
+            // frame.
+            if (!half_rate || !overlay.rendered ||
+                (frame_count_ + i) % 2 == 0) {
+              pattern.set_morph_amount(255);
+              pattern.RenderIndices(geometry, indices, overlay.speed);
+              overlay.rendered = true;
+            }
+            overlays[num_overlays++] = RenderedOverlay{
+                .palette = &pattern.palette(),
+                .indices = indices,
+                .leds = RegionLEDs(overlay.region),
+                .num_leds = geometry.num_leds(),
+                .opacity = overlay.opacity,
+                .blend_mode = overlay.blend_mode};
+          }
+        },
+        patterns_[overlay.pattern_id]);
+  }
+  return num_overlays;
+}
+
+void LEDController::Composite(uint64_t now_millis, fract8 current_opacity,
+                              const RenderedOverlay* overlays,
+                              int num_overlays, LEDBuffer& buffer) {
+  CRGB* leds = buffer.raw_led_data();
+  int num_leds = buffer.num_leds();
+  int num_bytes = 3 * num_leds;
+  CRGB* scratch = composite_scratch_.data();
+
+  // Each outgoing layer is faded in by its opacity, then blended over the
+  // layers below it by the same amount, and the current pattern over all of
+  // them. The opacities are the same for all the LEDs, so the layers are
+  // blended 4 channels at a time.
+  if (num_outgoing_layers_ > 0) {
+    std::copy_n(outgoing_buffers_[0].raw_led_data(), num_leds, scratch);
+    for (int i = 1; i < num_outgoing_layers_; ++i) {
+      fract8 opacity = outgoing_layers_[i].Opacity(now_millis);
+      TransformBytes(scratch->raw, outgoing_buffers_[i].raw_led_data()->raw,
+                     num_bytes, [opacity](uint32_t below, uint32_t layer) {
+                       return Blend8x4(Scale8x4(layer, opacity), below,
+                                       255 - opacity);
+                     });
+    }
+    TransformBytes(leds->raw, scratch->raw, num_bytes,
+                   [current_opacity](uint32_t pixel, uint32_t below) {
+                     return Blend8x4(Scale8x4(pixel, current_opacity), below,
+                                     255 - current_opacity);
+                   });
+  }
+
+  // Then each overlay is blended over the result by its blend mode and
+  // opacity, bottom first. The colors of an overlay over the whole wall are
+  // looked up into the scratch buffer, and blended 4 channels at a time if
+  // its blend mode allows. Otherwise, and for overlays limited to a region,
+  // each LED is blended on its own.
+  for (int layer = 0; layer < num_overlays; ++layer) {
+    const RenderedOverlay& overlay = overlays[layer];
+    const Palette& palette = *overlay.palette;
+    if (overlay.leds == nullptr && BlendsWords(overlay.blend_mode)) {
+      for (int i = 0; i < num_leds; ++i) {
+        scratch[i] = palette[overlay.indices[i]];
+      }
+      BlendOverWords(overlay.blend_mode, scratch, overlay.opacity, leds,
+                     num_leds);
+      continue;
+    }
+    for (int j = 0; j < overlay.num_leds; ++j) {
+      int led = overlay.leds == nullptr ? j : overlay.leds[j];
+      BlendOver(overlay.blend_mode, palette[overlay.indices[j]],
+                overlay.opacity, leds[led]);
+    }
+  }
+}
+
+void LEDController::Update() {
+  const Clock& system_clock = DefaultClock();
+  uint64_t start_micros = system_clock.NowMicros();
+  RenderFrame();
+  governor_.Record(system_clock.NowMicros() - start_micros);
+}
+
+void LEDController::SetFrameTime(uint64_t now_micros) {
+  now_millis_ = now_micros / 1000;
+  for (AnyPattern& any_pattern : patterns_) {
+    std::visit(
+        [now_micros](Pattern& pattern) { pattern.set_frame_time(now_micros); },
+        any_pattern);
   }
 }
+
+void LEDController::RenderFrame() {
+  // Patterns reset by the commands start at the time of the frame.
+  SetFrameTime(clock_->NowMicros());
+
+  std::optional<SetPatternCommand> command;
+  std::optional<SetPatternParamsCommand> params_command;
+  std::optional<PatternProgram> program;
+  std::optional<SetLayerCommand> layer_commands[SetLayerCommand::kMaxLayers];
+  bool enabled;
+  {
+    std::lock_guard<std::mutex> lock(mu_);
+    command.swap(pending_command_);
+    params_command.swap(pending_params_command_);
+    program.swap(pending_program_);
+    for (int i = 0; i < SetLayerCommand::kMaxLayers; ++i) {
+      layer_commands[i].swap(pending_layer_commands_[i]);
+    }
+    enabled = enabled_;
+  }
+  if (program.has_value()) {
+    std::get<ProgramPattern>(patterns_[PatternId::kProgram])
+        .SetProgram(*program);
+  }
+  if (command.has_value()) ApplyCommand(*command);
+  if (params_command.has_value()) ApplyParamsCommand(*params_command);
+  for (const std::optional<SetLayerCommand>& layer_command : layer_commands) {
+    if (layer_command.has_value()) ApplyLayerCommand(*layer_command);
+  }
+
+  LEDBuffer& led_buffer = led_buffers_[back_buffer_];
+  // Set LED buffer to black if we want them to be off.
+  if (!enabled) {
+    fill_solid(led_buffer.raw_led_data(), led_buffer.num_leds(), CRGB::Black);
+    return;
+  }
+
+  uint64_t now = now_millis_;
+  Render(current_layer_, now, led_buffer);
+  ++frame_count_;
+
+  fract8 current_opacity = 255;
+  if (num_outgoing_layers_ > 0) current_opacity = DropHiddenLayers(now);
+
+  // Refresh one of the outgoing layers every few frames. They keep fading out
+  // while the quality is too low to refresh them.
+  RenderQuality quality = governor_.quality();
+  int refresh_frames = kOutgoingRefreshFrames;
+  if (quality >= RenderQuality::kHalfRateOutgoing) refresh_frames *= 2;
+  if (num_outgoing_layers_ > 0 && quality < RenderQuality::kFrozenOutgoing &&
+      frame_count_ % refresh_frames == 0) {
+    int i = (frame_count_ / refresh_frames) % num_outgoing_layers_;
+    if (!outgoing_layers_[i].frozen) {
+      Render(outgoing_layers_[i], now, outgoing_buffers_[i]);
+    }
+  }
+
+  RenderedOverlay overlays[SetLayerCommand::kMaxLayers];
+  int num_overlays = RenderOverlays(overlays);
+  if (num_outgoing_layers_ == 0 && num_overlays == 0) return;
+  Composite(now, current_opacity, overlays, num_overlays, led_buffer);
+}
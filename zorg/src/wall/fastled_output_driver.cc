@@ -0,0 +1,67 @@
+#include "wall/fastled_output_driver.h"
+
+#include <FastLED.h>
+
+#include <vector>
+
+namespace {
+
+// Adds a FastLED controller for the LEDs of the wall on the pin. FastLED takes
+// the pin and the chipset as template parameters, hence the functions below,
+// which have a controller of each chipset compiled in.
+template <uint8_t kPin>
+CLEDController* AddLeds(LEDChipset chipset) {
+  switch (chipset) {
+    case LEDChipset::kWS2811BRG:
+      return &FastLED.addLeds<WS2811, kPin, BRG>(nullptr, 0);
+    case LEDChipset::kWS2812GRB:
+      break;
+  }
+  return &FastLED.addLeds<NEOPIXEL, kPin>(nullptr, 0);
+}
+
+// A pin LEDs can be chained on, and the function adding a controller on it.
+struct OutputPin {
+  uint8_t pin;
+  CLEDController* (*add_leds)(LEDChipset chipset);
+};
+
+// Leaves out the pins of the hand sensor and those that are inputs only.
+constexpr OutputPin kOutputPins[] = {
+    {4, AddLeds<4>},   {5, AddLeds<5>},   {12, AddLeds<12>}, {13, AddLeds<13>},
+    {15, AddLeds<15>}, {19, AddLeds<19>}, {21, AddLeds<21>}, {25, AddLeds<25>},
+    {26, AddLeds<26>}, {27, AddLeds<27>}, {32, AddLeds<32>}, {33, AddLeds<33>},
+};
+
+// Returns the output pin, or nullptr if LEDs can't be chained on it.
+const OutputPin* FindOutputPin(uint8_t pin) {
+  for (const OutputPin& output_pin : kOutputPins) {
+    if (output_pin.pin == pin) return &output_pin;
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+bool FastLEDOutputDriver::Init(const std::vector<LEDSegment>& segments,
+                               LEDChipset chipset) {
+  if (segments.size() > kMaxSegments) return false;
+  for (const LEDSegment& segment : segments) {
+    if (FindOutputPin(segment.pin) == nullptr) return false;
+  }
+  segments_ = segments;
+  for (const LEDSegment& segment : segments_) {
+    controllers_.push_back(FindOutputPin(segment.pin)->add_leds(chipset));
+  }
+  return true;
+}
+
+void FastLEDOutputDriver::Show(const CRGB* leds) {
+  // FastLED only reads the LEDs.
+  CRGB* mutable_leds = const_cast<CRGB*>(leds);
+  for (int s = 0; s < int(segments_.size()); ++s) {
+    controllers_[s]->setLeds(mutable_leds + segments_[s].first_led,
+                             segments_[s].num_leds);
+  }
+  FastLED.show();
+}
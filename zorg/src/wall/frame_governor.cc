@@ -0,0 +1,32 @@
+#include "wall/frame_governor.h"
+
+#include <cstdint>
+
+void FrameGovernor::set_budget_micros(uint32_t budget_micros) {
+  budget_micros_ = budget_micros;
+  if (budget_micros_ == 0) quality_ = RenderQuality::kFull;
+  frames_at_quality_ = 0;
+}
+
+void FrameGovernor::Record(uint32_t frame_micros) {
+  int q = int(quality_);
+  ++stats_.frames[q];
+  stats_.micros[q] += frame_micros;
+  // Each frame weighs an eighth of the average.
+  average_ += (int32_t(frame_micros) * 16 - average_) / 8;
+  ++frames_at_quality_;
+  if (budget_micros_ == 0) return;
+
+  int32_t budget = budget_micros_ * 16;
+  if (average_ > budget && frames_at_quality_ >= kStepDownFrames &&
+      q + 1 < kNumQualities) {
+    quality_ = RenderQuality(q + 1);
+    ++stats_.steps_down;
+    frames_at_quality_ = 0;
+  } else if (average_ < budget / 16 * kHeadroomSixteenths &&
+             frames_at_quality_ >= kStepUpFrames && q > 0) {
+    quality_ = RenderQuality(q - 1);
+    ++stats_.steps_up;
+    frames_at_quality_ = 0;
+  }
+}
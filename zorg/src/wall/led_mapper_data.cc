@@ -1,17 +1,23 @@
+// Generated by tools/generate_led_mapping.py from the LED Mapper exports in
+// tools/led_mapper. Do not edit, edit the exports and run the generator again.
+//
+// Every variant is compiled in, so one image runs on all the walls. The tables
+// are constexpr, so they stay in flash.
 #include "wall/led_mapper_data.h"
 
+#include <array>
 #include <cstdint>
-#include <vector>
+#include <cstring>
+
+namespace {
 
-#ifdef ACTUAL_WALL
 // LED Mapper data for the actual 8' wall.
+namespace actual_wall {
 
 constexpr int kNumLeds = 1000;
+constexpr int kNumRadiusBuckets = 177;
 
-#ifdef FLIP_WALL
-#define NUM_LEDS 1000
-
-std::vector<uint8_t> coordsX = {
+constexpr std::array<uint8_t, kNumLeds> kX = {
     0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
     0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
     0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
@@ -78,286 +84,10 @@ std::vector<uint8_t> coordsX = {
     230, 235, 240, 245, 250, 250, 245, 240, 235, 230, 224, 219, 214, 209, 204,
     199, 194, 189, 184, 179, 173, 168, 163, 158, 153, 148, 143, 138, 133, 128,
     122, 117, 112, 107, 102, 97,  92,  87,  82,  77,  71,  66,  61,  56,  51,
-    46,  41,  36,  31,  26,  20,  15,  10,  5,   0};
+    46,  41,  36,  31,  26,  20,  15,  10,  5,   0,
+};
 
-std::vector<uint8_t> coordsY = {
-    255, 251, 246, 242, 237, 229, 224, 220, 215, 211, 202, 198, 193, 189, 185,
-    176, 171, 167, 163, 158, 149, 145, 141, 136, 132, 123, 119, 114, 110, 106,
-    97,  92,  88,  84,  79,  70,  66,  62,  57,  53,  44,  40,  35,  31,  26,
-    18,  13,  9,   4,   0,   0,   4,   9,   13,  18,  26,  31,  35,  40,  44,
-    53,  57,  62,  66,  70,  79,  84,  88,  92,  97,  106, 110, 114, 119, 123,
-    132, 136, 141, 145, 149, 158, 163, 167, 171, 176, 185, 189, 193, 198, 202,
-    211, 215, 220, 224, 229, 237, 242, 246, 251, 255, 255, 251, 246, 242, 237,
-    229, 224, 220, 215, 211, 202, 198, 193, 189, 185, 176, 171, 167, 163, 158,
-    149, 145, 141, 136, 132, 123, 119, 114, 110, 106, 97,  92,  88,  84,  79,
-    70,  66,  62,  57,  53,  44,  40,  35,  31,  26,  18,  13,  9,   4,   0,
-    0,   4,   9,   13,  18,  26,  31,  35,  40,  44,  53,  57,  62,  66,  70,
-    79,  84,  88,  92,  97,  106, 110, 114, 119, 123, 132, 136, 141, 145, 149,
-    158, 163, 167, 171, 176, 185, 189, 193, 198, 202, 211, 215, 220, 224, 229,
-    237, 242, 246, 251, 255, 255, 251, 246, 242, 237, 229, 224, 220, 215, 211,
-    202, 198, 193, 189, 185, 176, 171, 167, 163, 158, 149, 145, 141, 136, 132,
-    123, 119, 114, 110, 106, 97,  92,  88,  84,  79,  70,  66,  62,  57,  53,
-    44,  40,  35,  31,  26,  18,  13,  9,   4,   0,   0,   4,   9,   13,  18,
-    26,  31,  35,  40,  44,  53,  57,  62,  66,  70,  79,  84,  88,  92,  97,
-    106, 110, 114, 119, 123, 132, 136, 141, 145, 149, 158, 163, 167, 171, 176,
-    185, 189, 193, 198, 202, 211, 215, 220, 224, 229, 237, 242, 246, 251, 255,
-    255, 251, 246, 242, 237, 229, 224, 220, 215, 211, 202, 198, 193, 189, 185,
-    176, 171, 167, 163, 158, 149, 145, 141, 136, 132, 123, 119, 114, 110, 106,
-    97,  92,  88,  84,  79,  70,  66,  62,  57,  53,  44,  40,  35,  31,  26,
-    18,  13,  9,   4,   0,   0,   4,   9,   13,  18,  26,  31,  35,  40,  44,
-    53,  57,  62,  66,  70,  79,  84,  88,  92,  97,  106, 110, 114, 119, 123,
-    132, 136, 141, 145, 149, 158, 163, 167, 171, 176, 185, 189, 193, 198, 202,
-    211, 215, 220, 224, 229, 237, 242, 246, 251, 255, 255, 251, 246, 242, 237,
-    229, 224, 220, 215, 211, 202, 198, 193, 189, 185, 176, 171, 167, 163, 158,
-    149, 145, 141, 136, 132, 123, 119, 114, 110, 106, 97,  92,  88,  84,  79,
-    70,  66,  62,  57,  53,  44,  40,  35,  31,  26,  18,  13,  9,   4,   0,
-    0,   4,   9,   13,  18,  26,  31,  35,  40,  44,  53,  57,  62,  66,  70,
-    79,  84,  88,  92,  97,  106, 110, 114, 119, 123, 132, 136, 141, 145, 149,
-    158, 163, 167, 171, 176, 185, 189, 193, 198, 202, 211, 215, 220, 224, 229,
-    237, 242, 246, 251, 255, 255, 251, 246, 242, 237, 229, 224, 220, 215, 211,
-    202, 198, 193, 189, 185, 176, 171, 167, 163, 158, 149, 145, 141, 136, 132,
-    123, 119, 114, 110, 106, 97,  92,  88,  84,  79,  70,  66,  62,  57,  53,
-    44,  40,  35,  31,  26,  18,  13,  9,   4,   0,   22,  22,  22,  22,  22,
-    22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,
-    22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,
-    22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,
-    48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,
-    48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,
-    48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,
-    48,  48,  48,  48,  48,  75,  75,  75,  75,  75,  75,  75,  75,  75,  75,
-    75,  75,  75,  75,  75,  75,  75,  75,  75,  75,  75,  75,  75,  75,  75,
-    75,  75,  75,  75,  75,  75,  75,  75,  75,  75,  75,  75,  75,  75,  75,
-    75,  75,  75,  75,  75,  75,  75,  75,  75,  75,  101, 101, 101, 101, 101,
-    101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101,
-    101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101,
-    101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101,
-    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
-    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
-    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
-    128, 128, 128, 128, 128, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154,
-    154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154,
-    154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154,
-    154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 180, 180, 180, 180, 180,
-    180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180,
-    180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180,
-    180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180,
-    207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207,
-    207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207,
-    207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207,
-    207, 207, 207, 207, 207, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233,
-    233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233,
-    233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233,
-    233, 233, 233, 233, 233, 233, 233, 233, 233, 233};
-
-std::vector<uint8_t> angles = {
-    221, 222, 222, 223, 224, 226, 227, 228, 229, 230, 232, 233, 234, 235, 237,
-    239, 241, 242, 243, 245, 248, 249, 251, 253, 254, 2,   4,   6,   7,   9,
-    12,  13,  14,  16,  17,  20,  21,  22,  23,  24,  26,  27,  28,  29,  30,
-    32,  33,  33,  34,  35,  39,  38,  38,  37,  36,  35,  34,  33,  32,  31,
-    29,  28,  26,  25,  24,  21,  19,  18,  16,  14,  11,  9,   7,   5,   3,
-    254, 252, 250, 248, 246, 243, 241, 239, 237, 236, 233, 231, 230, 229, 227,
-    225, 224, 223, 222, 221, 220, 219, 218, 217, 217, 211, 212, 213, 213, 214,
-    216, 217, 218, 219, 220, 222, 223, 224, 226, 227, 231, 233, 235, 237, 239,
-    244, 246, 249, 251, 254, 4,   6,   9,   11,  14,  18,  20,  22,  24,  26,
-    29,  31,  32,  33,  34,  36,  37,  38,  39,  40,  42,  42,  43,  44,  44,
-    50,  49,  49,  48,  48,  47,  46,  45,  45,  44,  42,  41,  40,  38,  37,
-    34,  32,  30,  28,  25,  20,  16,  13,  9,   6,   253, 249, 246, 242, 239,
-    233, 230, 227, 225, 223, 220, 218, 217, 215, 214, 212, 211, 210, 210, 209,
-    208, 207, 207, 206, 206, 199, 199, 200, 200, 200, 201, 201, 202, 202, 203,
-    204, 205, 206, 207, 208, 211, 213, 215, 217, 220, 227, 232, 238, 244, 251,
-    11,  17,  23,  28,  32,  38,  40,  42,  44,  46,  48,  49,  50,  51,  51,
-    53,  53,  54,  54,  54,  55,  55,  56,  56,  56,  63,  63,  63,  63,  63,
-    63,  63,  63,  63,  63,  63,  63,  62,  62,  62,  62,  62,  62,  61,  61,
-    60,  59,  58,  56,  51,  223, 204, 199, 197, 196, 194, 194, 194, 193, 193,
-    193, 193, 193, 193, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192,
-    185, 185, 184, 184, 184, 183, 183, 182, 182, 182, 180, 180, 179, 178, 177,
-    175, 173, 171, 169, 167, 159, 154, 148, 141, 132, 114, 107, 101, 96,  92,
-    86,  84,  82,  80,  79,  77,  76,  75,  75,  74,  73,  73,  72,  72,  71,
-    71,  71,  70,  70,  70,  76,  77,  77,  78,  78,  79,  80,  81,  81,  82,
-    84,  85,  86,  87,  89,  92,  94,  96,  98,  100, 106, 110, 113, 117, 121,
-    130, 134, 138, 142, 145, 152, 155, 157, 159, 161, 165, 166, 168, 169, 170,
-    172, 173, 174, 174, 175, 176, 177, 177, 178, 178, 172, 172, 171, 170, 170,
-    168, 167, 166, 165, 164, 162, 161, 159, 158, 156, 153, 151, 149, 147, 145,
-    140, 137, 134, 132, 129, 123, 121, 118, 115, 113, 108, 106, 104, 102, 100,
-    97,  96,  94,  93,  92,  90,  89,  88,  87,  86,  85,  84,  83,  83,  82,
-    87,  88,  89,  89,  90,  92,  93,  94,  95,  96,  98,  99,  100, 102, 103,
-    106, 107, 109, 111, 113, 116, 118, 120, 122, 124, 129, 131, 133, 135, 137,
-    141, 142, 144, 146, 148, 151, 152, 153, 155, 156, 158, 159, 160, 161, 162,
-    164, 165, 166, 166, 167, 162, 162, 161, 160, 159, 158, 157, 156, 155, 154,
-    152, 150, 149, 148, 147, 144, 143, 141, 140, 138, 135, 133, 132, 130, 128,
-    125, 123, 122, 120, 119, 115, 114, 112, 111, 110, 107, 106, 105, 103, 102,
-    100, 99,  98,  97,  96,  95,  94,  93,  93,  92,  95,  94,  93,  92,  91,
-    90,  89,  88,  87,  85,  84,  83,  82,  80,  79,  77,  76,  74,  73,  71,
-    70,  68,  66,  65,  63,  61,  60,  58,  56,  55,  53,  52,  50,  49,  47,
-    46,  45,  43,  42,  41,  40,  39,  38,  36,  35,  35,  34,  33,  32,  31,
-    25,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  37,  38,  40,  41,
-    43,  44,  46,  48,  50,  52,  54,  56,  58,  60,  63,  65,  67,  69,  71,
-    73,  75,  77,  79,  81,  83,  85,  86,  88,  89,  91,  92,  93,  94,  96,
-    97,  98,  99,  100, 100, 108, 107, 106, 105, 104, 103, 102, 101, 100, 99,
-    97,  96,  94,  92,  90,  88,  86,  83,  81,  78,  75,  72,  69,  65,  62,
-    59,  56,  53,  50,  47,  44,  42,  40,  37,  35,  34,  32,  30,  29,  28,
-    26,  25,  24,  23,  22,  21,  21,  20,  19,  18,  10,  11,  11,  11,  12,
-    12,  13,  14,  14,  15,  16,  17,  18,  19,  21,  22,  24,  26,  29,  32,
-    35,  39,  44,  49,  55,  61,  67,  73,  79,  84,  88,  92,  96,  99,  101,
-    103, 105, 107, 108, 109, 110, 111, 112, 113, 114, 114, 115, 116, 116, 117,
-    127, 127, 127, 127, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 125,
-    125, 125, 124, 124, 123, 122, 119, 114, 96,  32,  13,  8,   6,   4,   4,
-    3,   3,   2,   2,   2,   2,   2,   2,   1,   1,   1,   1,   1,   1,   1,
-    1,   1,   1,   1,   1,   246, 246, 246, 245, 245, 244, 244, 243, 243, 242,
-    241, 240, 239, 238, 237, 235, 234, 232, 229, 226, 223, 219, 214, 209, 202,
-    195, 188, 180, 174, 168, 163, 159, 156, 153, 151, 149, 147, 146, 144, 143,
-    142, 141, 141, 140, 139, 139, 138, 138, 137, 137, 146, 147, 147, 148, 149,
-    150, 151, 152, 153, 155, 156, 158, 159, 161, 163, 165, 168, 170, 173, 176,
-    179, 183, 186, 189, 193, 197, 200, 203, 206, 209, 212, 215, 217, 219, 221,
-    223, 225, 226, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 237, 238,
-    231, 230, 229, 228, 227, 226, 225, 224, 223, 222, 221, 219, 218, 216, 215,
-    213, 211, 210, 208, 206, 204, 201, 199, 197, 195, 192, 190, 188, 185, 183,
-    181, 179, 177, 175, 173, 171, 169, 168, 166, 165, 163, 162, 161, 159, 158,
-    157, 156, 155, 154, 153, 159, 160, 161, 162, 163, 164, 165, 166, 168, 169,
-    170, 171, 173, 174, 176, 177, 179, 180, 182, 184, 185, 187, 189, 190, 192,
-    194, 196, 197, 199, 201, 202, 204, 205, 207, 208, 210, 211, 212, 214, 215,
-    216, 217, 218, 219, 220, 221, 222, 223, 224, 225};
-
-std::vector<uint8_t> radii = {
-    250, 245, 241, 236, 231, 222, 218, 214, 210, 206, 199, 195, 192, 189, 186,
-    180, 178, 176, 174, 172, 169, 168, 168, 167, 167, 167, 168, 168, 169, 171,
-    174, 176, 178, 180, 183, 189, 192, 195, 199, 202, 210, 214, 218, 222, 227,
-    236, 241, 245, 250, 255, 235, 230, 224, 219, 214, 204, 199, 194, 190, 185,
-    176, 172, 168, 164, 161, 154, 151, 148, 145, 143, 139, 137, 136, 135, 134,
-    134, 134, 135, 136, 137, 141, 143, 145, 148, 151, 157, 161, 164, 168, 172,
-    181, 185, 190, 194, 199, 209, 214, 219, 224, 230, 212, 206, 201, 195, 190,
-    179, 173, 168, 163, 158, 148, 143, 139, 134, 130, 122, 119, 116, 113, 110,
-    106, 104, 103, 102, 101, 102, 103, 104, 106, 108, 113, 116, 119, 122, 126,
-    134, 139, 143, 148, 153, 163, 168, 173, 179, 184, 195, 201, 206, 212, 218,
-    205, 199, 193, 186, 180, 168, 162, 156, 151, 145, 133, 128, 122, 117, 112,
-    102, 97,  93,  88,  84,  78,  75,  72,  71,  69,  69,  69,  71,  72,  75,
-    81,  84,  88,  93,  97,  107, 112, 117, 122, 128, 139, 145, 151, 156, 162,
-    174, 180, 186, 193, 199, 190, 183, 177, 171, 164, 151, 145, 139, 132, 126,
-    114, 108, 101, 95,  89,  78,  72,  66,  61,  56,  46,  43,  40,  37,  36,
-    37,  40,  43,  46,  51,  61,  66,  72,  78,  83,  95,  101, 108, 114, 120,
-    132, 139, 145, 151, 158, 171, 177, 183, 190, 196, 193, 186, 180, 173, 167,
-    154, 147, 141, 134, 128, 114, 108, 101, 95,  88,  75,  69,  62,  56,  49,
-    36,  30,  23,  17,  10,  5,   10,  17,  23,  30,  43,  49,  56,  62,  69,
-    82,  88,  95,  101, 108, 121, 128, 134, 141, 147, 160, 167, 173, 180, 186,
-    189, 182, 176, 169, 163, 150, 144, 137, 131, 125, 112, 106, 99,  93,  87,
-    75,  69,  63,  57,  52,  42,  37,  34,  31,  30,  31,  34,  37,  42,  46,
-    57,  63,  69,  75,  81,  93,  99,  106, 112, 118, 131, 137, 144, 150, 156,
-    169, 176, 182, 189, 195, 203, 196, 190, 184, 178, 166, 160, 154, 148, 142,
-    130, 125, 119, 113, 108, 98,  93,  88,  83,  79,  72,  69,  66,  64,  63,
-    62,  63,  64,  66,  69,  75,  79,  83,  88,  93,  103, 108, 113, 119, 125,
-    136, 142, 148, 154, 160, 172, 178, 184, 190, 196, 209, 203, 198, 192, 186,
-    175, 170, 164, 159, 154, 144, 139, 134, 130, 125, 117, 113, 110, 107, 104,
-    99,  98,  96,  95,  95,  95,  96,  98,  99,  101, 107, 110, 113, 117, 121,
-    130, 134, 139, 144, 149, 159, 164, 170, 175, 181, 192, 198, 203, 209, 215,
-    231, 226, 220, 215, 210, 200, 195, 190, 185, 180, 171, 167, 163, 159, 155,
-    148, 145, 142, 139, 137, 132, 131, 130, 129, 128, 128, 128, 129, 130, 131,
-    134, 137, 139, 142, 145, 151, 155, 159, 163, 167, 176, 180, 185, 190, 195,
-    205, 210, 215, 220, 226, 246, 241, 236, 231, 227, 218, 213, 209, 205, 201,
-    193, 190, 186, 183, 180, 174, 172, 170, 168, 166, 163, 162, 161, 161, 160,
-    161, 161, 162, 163, 164, 168, 170, 172, 174, 177, 183, 186, 190, 193, 197,
-    205, 209, 213, 218, 222, 231, 236, 241, 246, 251, 222, 218, 213, 209, 205,
-    201, 197, 193, 190, 186, 183, 180, 177, 174, 172, 170, 168, 166, 164, 163,
-    162, 161, 161, 160, 160, 161, 161, 162, 163, 164, 166, 168, 170, 172, 174,
-    177, 180, 183, 186, 190, 193, 197, 201, 205, 209, 213, 218, 222, 227, 231,
-    206, 201, 196, 190, 185, 181, 176, 171, 167, 162, 158, 154, 150, 146, 142,
-    139, 136, 133, 131, 128, 126, 125, 123, 122, 121, 121, 121, 121, 122, 123,
-    125, 126, 128, 131, 133, 136, 139, 142, 146, 150, 154, 158, 162, 167, 171,
-    176, 181, 185, 190, 196, 174, 168, 163, 157, 151, 146, 141, 135, 130, 125,
-    120, 116, 111, 107, 103, 99,  95,  92,  89,  87,  85,  83,  82,  82,  82,
-    82,  83,  85,  87,  89,  92,  95,  99,  103, 107, 111, 116, 120, 125, 130,
-    135, 141, 146, 151, 157, 163, 168, 174, 180, 186, 172, 166, 159, 153, 147,
-    141, 134, 128, 122, 116, 110, 104, 98,  92,  86,  81,  75,  70,  65,  60,
-    56,  52,  48,  46,  44,  43,  43,  44,  46,  48,  52,  56,  60,  65,  70,
-    75,  81,  86,  92,  98,  104, 110, 116, 122, 128, 134, 141, 147, 153, 159,
-    154, 147, 141, 134, 128, 121, 114, 108, 101, 95,  88,  82,  75,  69,  62,
-    56,  49,  43,  36,  30,  23,  17,  10,  5,   5,   10,  17,  23,  30,  36,
-    43,  49,  56,  62,  69,  75,  82,  88,  95,  101, 108, 114, 121, 128, 134,
-    141, 147, 154, 160, 167, 171, 164, 158, 151, 145, 139, 132, 126, 120, 114,
-    108, 101, 95,  89,  83,  78,  72,  66,  61,  56,  51,  46,  43,  40,  37,
-    36,  36,  37,  40,  43,  46,  51,  56,  61,  66,  72,  78,  83,  89,  95,
-    101, 108, 114, 120, 126, 132, 139, 145, 151, 158, 171, 165, 159, 154, 148,
-    142, 137, 132, 126, 121, 116, 111, 106, 102, 98,  94,  90,  86,  83,  81,
-    79,  77,  76,  75,  75,  76,  77,  79,  81,  83,  86,  90,  94,  98,  102,
-    106, 111, 116, 121, 126, 132, 137, 142, 148, 154, 159, 165, 171, 177, 183,
-    202, 197, 192, 186, 181, 176, 171, 167, 162, 157, 153, 149, 145, 141, 137,
-    133, 130, 127, 125, 122, 120, 118, 117, 116, 115, 114, 114, 115, 116, 117,
-    118, 120, 122, 125, 127, 130, 133, 137, 141, 145, 149, 153, 157, 162, 167,
-    171, 176, 181, 186, 192, 217, 213, 208, 204, 200, 196, 192, 188, 184, 181,
-    177, 174, 171, 168, 166, 163, 161, 159, 158, 156, 155, 155, 154, 154, 154,
-    154, 155, 155, 156, 158, 159, 161, 163, 166, 168, 171, 174, 177, 181, 184,
-    188, 192, 196, 200, 204, 208, 213, 217, 222, 227};
-#else
-
-std::vector<uint8_t> coordsX = {
-    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0,   0,   0,   0,   0,   26,  26,  26,  26,  26,  26,  26,  26,  26,  26,
-    26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,
-    26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,
-    26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  51,  51,  51,  51,  51,
-    51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,
-    51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,
-    51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,
-    77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,
-    77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,
-    77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,
-    77,  77,  77,  77,  77,  102, 102, 102, 102, 102, 102, 102, 102, 102, 102,
-    102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102,
-    102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102,
-    102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 128, 128, 128, 128, 128,
-    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
-    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
-    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
-    153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153,
-    153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153,
-    153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153,
-    153, 153, 153, 153, 153, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179,
-    179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179,
-    179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179,
-    179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 204, 204, 204, 204, 204,
-    204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204,
-    204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204,
-    204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204,
-    230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230,
-    230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230,
-    230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230,
-    230, 230, 230, 230, 230, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 250, 245, 240, 235, 230,
-    224, 219, 214, 209, 204, 199, 194, 189, 184, 179, 173, 168, 163, 158, 153,
-    148, 143, 138, 133, 128, 122, 117, 112, 107, 102, 97,  92,  87,  82,  77,
-    71,  66,  61,  56,  51,  46,  41,  36,  31,  26,  20,  15,  10,  5,   0,
-    0,   5,   10,  15,  20,  26,  31,  36,  41,  46,  51,  56,  61,  66,  71,
-    77,  82,  87,  92,  97,  102, 107, 112, 117, 122, 128, 133, 138, 143, 148,
-    153, 158, 163, 168, 173, 179, 184, 189, 194, 199, 204, 209, 214, 219, 224,
-    230, 235, 240, 245, 250, 250, 245, 240, 235, 230, 224, 219, 214, 209, 204,
-    199, 194, 189, 184, 179, 173, 168, 163, 158, 153, 148, 143, 138, 133, 128,
-    122, 117, 112, 107, 102, 97,  92,  87,  82,  77,  71,  66,  61,  56,  51,
-    46,  41,  36,  31,  26,  20,  15,  10,  5,   0,   0,   5,   10,  15,  20,
-    26,  31,  36,  41,  46,  51,  56,  61,  66,  71,  77,  82,  87,  92,  97,
-    102, 107, 112, 117, 122, 128, 133, 138, 143, 148, 153, 158, 163, 168, 173,
-    179, 184, 189, 194, 199, 204, 209, 214, 219, 224, 230, 235, 240, 245, 250,
-    250, 245, 240, 235, 230, 224, 219, 214, 209, 204, 199, 194, 189, 184, 179,
-    173, 168, 163, 158, 153, 148, 143, 138, 133, 128, 122, 117, 112, 107, 102,
-    97,  92,  87,  82,  77,  71,  66,  61,  56,  51,  46,  41,  36,  31,  26,
-    20,  15,  10,  5,   0,   0,   5,   10,  15,  20,  26,  31,  36,  41,  46,
-    51,  56,  61,  66,  71,  77,  82,  87,  92,  97,  102, 107, 112, 117, 122,
-    128, 133, 138, 143, 148, 153, 158, 163, 168, 173, 179, 184, 189, 194, 199,
-    204, 209, 214, 219, 224, 230, 235, 240, 245, 250, 250, 245, 240, 235, 230,
-    224, 219, 214, 209, 204, 199, 194, 189, 184, 179, 173, 168, 163, 158, 153,
-    148, 143, 138, 133, 128, 122, 117, 112, 107, 102, 97,  92,  87,  82,  77,
-    71,  66,  61,  56,  51,  46,  41,  36,  31,  26,  20,  15,  10,  5,   0,
-    0,   5,   10,  15,  20,  26,  31,  36,  41,  46,  51,  56,  61,  66,  71,
-    77,  82,  87,  92,  97,  102, 107, 112, 117, 122, 128, 133, 138, 143, 148,
-    153, 158, 163, 168, 173, 179, 184, 189, 194, 199, 204, 209, 214, 219, 224,
-    230, 235, 240, 245, 250, 250, 245, 240, 235, 230, 224, 219, 214, 209, 204,
-    199, 194, 189, 184, 179, 173, 168, 163, 158, 153, 148, 143, 138, 133, 128,
-    122, 117, 112, 107, 102, 97,  92,  87,  82,  77,  71,  66,  61,  56,  51,
-    46,  41,  36,  31,  26,  20,  15,  10,  5,   0};
-
-std::vector<uint8_t> coordsY = {
+constexpr std::array<uint8_t, kNumLeds> kY = {
     0,   4,   9,   13,  18,  26,  31,  35,  40,  44,  53,  57,  62,  66,  70,
     79,  84,  88,  92,  97,  106, 110, 114, 119, 123, 132, 136, 141, 145, 149,
     158, 163, 167, 171, 176, 185, 189, 193, 198, 202, 211, 215, 220, 224, 229,
@@ -424,9 +154,10 @@ std::vector<uint8_t> coordsY = {
     48,  48,  48,  48,  48,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,
     22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,
     22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,
-    22,  22,  22,  22,  22,  22,  22,  22,  22,  22};
+    22,  22,  22,  22,  22,  22,  22,  22,  22,  22,
+};
 
-std::vector<uint8_t> angles = {
+constexpr std::array<uint8_t, kNumLeds> kAngle = {
     35,  34,  33,  33,  32,  30,  29,  28,  27,  26,  24,  23,  22,  21,  20,
     17,  16,  14,  13,  12,  9,   7,   6,   4,   2,   254, 253, 251, 249, 248,
     245, 243, 242, 241, 239, 237, 235, 234, 233, 232, 230, 229, 228, 227, 226,
@@ -493,9 +224,10 @@ std::vector<uint8_t> angles = {
     97,  98,  99,  100, 100, 95,  94,  93,  92,  91,  90,  89,  88,  87,  85,
     84,  83,  82,  80,  79,  77,  76,  74,  73,  71,  70,  68,  66,  65,  63,
     61,  60,  58,  56,  55,  53,  52,  50,  49,  47,  46,  45,  43,  42,  41,
-    40,  39,  38,  36,  35,  35,  34,  33,  32,  31};
+    40,  39,  38,  36,  35,  35,  34,  33,  32,  31,
+};
 
-std::vector<uint8_t> radii = {
+constexpr std::array<uint8_t, kNumLeds> kRadius = {
     255, 250, 245, 241, 236, 227, 222, 218, 214, 210, 202, 199, 195, 192, 189,
     183, 180, 178, 176, 174, 171, 169, 168, 168, 167, 167, 167, 168, 168, 169,
     172, 174, 176, 178, 180, 186, 189, 192, 195, 199, 206, 210, 214, 218, 222,
@@ -562,16 +294,1568 @@ std::vector<uint8_t> radii = {
     176, 181, 185, 190, 196, 222, 218, 213, 209, 205, 201, 197, 193, 190, 186,
     183, 180, 177, 174, 172, 170, 168, 166, 164, 163, 162, 161, 161, 160, 160,
     161, 161, 162, 163, 164, 166, 168, 170, 172, 174, 177, 180, 183, 186, 190,
-    193, 197, 201, 205, 209, 213, 218, 222, 227, 231};
+    193, 197, 201, 205, 209, 213, 218, 222, 227, 231,
+};
+
+constexpr std::array<uint8_t, kNumRadiusBuckets> kUniqueRadii = {
+    5,   10,  17,  23,  30,  31,  34,  36,  37,  40,  42,  43,  44,  46,  48,
+    49,  51,  52,  56,  57,  60,  61,  62,  63,  64,  65,  66,  69,  70,  71,
+    72,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  86,  87,  88,  89,
+    90,  92,  93,  94,  95,  96,  97,  98,  99,  101, 102, 103, 104, 106, 107,
+    108, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123,
+    125, 126, 127, 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 139, 141,
+    142, 143, 144, 145, 146, 147, 148, 149, 150, 151, 153, 154, 155, 156, 157,
+    158, 159, 160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172,
+    173, 174, 175, 176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 188,
+    189, 190, 192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 202, 203, 204,
+    205, 206, 208, 209, 210, 212, 213, 214, 215, 217, 218, 219, 220, 222, 224,
+    226, 227, 230, 231, 235, 236, 241, 245, 246, 250, 251, 255,
+};
+
+constexpr std::array<uint16_t, kNumRadiusBuckets + 1> kRadiusBucketStarts = {
+    0,    3,    7,    11,   15,   20,   22,   24,   30,   36,   40,   42,
+    51,   53,   60,   62,   66,   69,   72,   81,   83,   85,   89,   94,
+    98,   100,  102,  108,  119,  121,  123,  130,  142,  144,  146,  151,
+    155,  161,  168,  177,  179,  181,  185,  188,  196,  201,  203,  207,
+    213,  215,  228,  230,  232,  239,  245,  255,  260,  265,  270,  276,
+    281,  292,  297,  301,  305,  311,  320,  322,  332,  338,  341,  345,
+    352,  362,  372,  374,  384,  392,  394,  407,  409,  419,  425,  432,
+    437,  451,  455,  460,  470,  484,  495,  503,  507,  511,  523,  527,
+    533,  542,  545,  549,  560,  565,  580,  586,  591,  596,  604,  614,
+    621,  633,  643,  656,  665,  667,  674,  686,  703,  707,  713,  726,
+    735,  739,  750,  752,  762,  770,  774,  776,  788,  796,  798,  806,
+    811,  817,  830,  832,  836,  851,  859,  866,  868,  875,  882,  886,
+    888,  894,  897,  903,  905,  908,  911,  917,  921,  923,  930,  934,
+    936,  942,  946,  949,  951,  958,  960,  962,  968,  970,  972,  976,
+    978,  983,  984,  988,  992,  994,  996,  998,  999,  1000,
+};
+
+constexpr std::array<uint16_t, kNumLeds> kRadiusBucketLeds = {
+    274, 773, 774, 273, 275, 772, 775, 272, 276, 771, 776, 271, 277, 770, 777,
+    270, 278, 325, 769, 778, 324, 326, 323, 327, 225, 279, 725, 726, 768, 779,
+    224, 226, 322, 328, 724, 727, 223, 227, 723, 728, 321, 329, 222, 228, 269,
+    722, 729, 767, 780, 825, 826, 824, 827, 221, 229, 320, 721, 730, 823, 828,
+    822, 829, 268, 280, 766, 781, 220, 720, 731, 330, 821, 830, 230, 267, 281,
+    719, 732, 765, 782, 820, 831, 319, 331, 819, 832, 219, 231, 718, 733, 266,
+    282, 374, 764, 783, 318, 332, 373, 375, 372, 376, 818, 833, 218, 232, 371,
+    377, 717, 734, 173, 174, 175, 265, 283, 317, 333, 370, 378, 763, 784, 817,
+    834, 172, 176, 171, 177, 217, 233, 379, 716, 735, 170, 178, 284, 316, 334,
+    369, 673, 674, 762, 785, 816, 835, 672, 675, 671, 676, 179, 216, 234, 715,
+    736, 368, 380, 670, 677, 169, 315, 669, 678, 815, 836, 264, 761, 786, 872,
+    873, 874, 875, 215, 367, 381, 668, 679, 714, 737, 871, 876, 168, 180, 870,
+    877, 667, 680, 814, 837, 335, 869, 878, 167, 181, 263, 285, 366, 382, 760,
+    787, 235, 713, 738, 868, 879, 666, 681, 813, 838, 867, 880, 166, 182, 314,
+    336, 365, 383, 665, 682, 214, 236, 262, 286, 424, 425, 426, 712, 739, 759,
+    788, 866, 881, 423, 427, 165, 183, 384, 422, 428, 664, 683, 812, 839, 313,
+    337, 421, 429, 865, 882, 125, 213, 237, 261, 287, 420, 711, 740, 758, 789,
+    124, 126, 184, 663, 684, 123, 127, 364, 864, 883, 122, 128, 430, 811, 840,
+    121, 129, 312, 338, 662, 685, 164, 419, 431, 863, 884, 120, 212, 238, 260,
+    288, 363, 385, 710, 741, 757, 790, 130, 418, 432, 810, 841, 661, 686, 862,
+    885, 163, 185, 311, 339, 119, 131, 362, 386, 417, 433, 211, 239, 289, 625,
+    626, 709, 742, 756, 791, 624, 627, 118, 132, 623, 628, 660, 687, 809, 842,
+    861, 886, 162, 186, 416, 434, 622, 629, 310, 621, 630, 117, 133, 361, 387,
+    210, 620, 631, 708, 743, 860, 887, 259, 415, 659, 688, 755, 792, 924, 925,
+    926, 927, 116, 134, 161, 187, 619, 632, 808, 843, 923, 928, 922, 929, 340,
+    360, 388, 435, 618, 633, 859, 888, 921, 930, 115, 240, 658, 689, 707, 744,
+    920, 931, 617, 634, 160, 188, 258, 290, 473, 474, 475, 754, 793, 807, 844,
+    919, 932, 472, 476, 135, 389, 414, 436, 471, 477, 616, 635, 858, 889, 309,
+    341, 470, 478, 918, 933, 209, 241, 479, 657, 690, 706, 745, 189, 615, 636,
+    917, 934, 73,  74,  75,  114, 136, 257, 291, 413, 437, 469, 753, 794, 806,
+    845, 72,  76,  857, 890, 71,  77,  359, 916, 935, 70,  78,  308, 342, 468,
+    480, 614, 637, 656, 691, 79,  113, 137, 159, 208, 242, 412, 438, 467, 481,
+    705, 746, 915, 936, 69,  256, 292, 613, 638, 752, 795, 805, 846, 856, 891,
+    358, 390, 466, 482, 655, 692, 914, 937, 68,  80,  112, 138, 307, 343, 411,
+    439, 67,  81,  158, 190, 207, 243, 465, 483, 612, 639, 704, 747, 855, 892,
+    913, 938, 255, 293, 751, 796, 804, 847, 66,  82,  111, 139, 357, 391, 484,
+    654, 693, 410, 611, 640, 306, 344, 912, 939, 65,  83,  157, 191, 206, 244,
+    464, 703, 748, 854, 893, 110, 610, 641, 803, 848, 84,  294, 356, 392, 440,
+    572, 573, 574, 575, 653, 694, 750, 797, 911, 940, 463, 485, 570, 571, 576,
+    577, 156, 192, 305, 569, 578, 64,  609, 642, 853, 894, 140, 205, 568, 579,
+    702, 749, 910, 941, 409, 441, 462, 486, 567, 580, 652, 695, 802, 849, 254,
+    355, 393, 525, 798, 973, 974, 63,  85,  523, 524, 526, 527, 566, 581, 971,
+    972, 975, 976, 155, 193, 522, 528, 608, 643, 909, 942, 970, 977, 109, 141,
+    345, 461, 487, 521, 529, 565, 582, 852, 895, 969, 978, 62,  86,  245, 408,
+    442, 520, 701, 968, 979, 651, 696, 394, 530, 564, 583, 801, 967, 980, 24,
+    25,  26,  253, 295, 460, 488, 607, 644, 799, 908, 943, 22,  23,  27,  28,
+    61,  87,  108, 142, 194, 519, 531, 563, 584, 851, 896, 966, 981, 21,  29,
+    304, 346, 407, 443, 518, 532, 965, 982, 20,  204, 246, 489, 562, 585, 606,
+    645, 650, 697, 700, 907, 944, 30,  60,  88,  354, 517, 533, 800, 964, 983,
+    107, 143, 252, 296, 19,  31,  154, 516, 534, 561, 586, 850, 897, 963, 984,
+    406, 444, 18,  32,  89,  303, 347, 459, 605, 646, 906, 945, 203, 247, 515,
+    560, 587, 698, 962, 985, 17,  33,  353, 395, 106, 144, 16,  34,  153, 195,
+    251, 297, 458, 490, 535, 898, 961, 986, 59,  405, 559, 588, 604, 647, 905,
+    946, 302, 348, 15,  202, 248, 514, 536, 699, 960, 987, 105, 352, 396, 558,
+    589, 58,  90,  457, 491, 904, 947, 35,  152, 196, 250, 298, 445, 513, 537,
+    603, 648, 899, 959, 988, 557, 590, 14,  36,  301, 349, 57,  91,  145, 201,
+    249, 351, 397, 456, 492, 512, 538, 903, 948, 958, 989, 13,  37,  404, 446,
+    556, 591, 602, 649, 151, 197, 299, 511, 539, 957, 990, 56,  92,  12,  38,
+    104, 146, 300, 455, 493, 200, 350, 398, 555, 592, 902, 949, 510, 601, 956,
+    991, 403, 447, 11,  39,  55,  93,  150, 198, 494, 554, 593, 103, 147, 540,
+    901, 955, 992, 10,  600, 399, 402, 448, 94,  553, 594, 199, 454, 509, 541,
+    954, 993, 40,  102, 148, 900, 552, 595, 54,  401, 449, 508, 542, 953, 994,
+    9,   41,  453, 495, 101, 149, 507, 543, 551, 596, 952, 995, 8,   42,  53,
+    95,  400, 452, 496, 550, 597, 7,   43,  100, 506, 544, 951, 996, 52,  96,
+    451, 497, 6,   44,  505, 598, 950, 997, 51,  97,  450, 498, 5,   545, 599,
+    998, 50,  98,  45,  499, 504, 546, 999, 99,  4,   46,  503, 547, 3,   47,
+    502, 548, 2,   48,  501, 549, 1,   49,  500, 0,
+};
+
+constexpr std::array<uint16_t, LEDMapping::kNumGridCells + 1>
+    kGridCellStarts = {
+    0,    4,    8,    8,    12,   16,   16,   20,   20,   24,   28,   28,
+    32,   36,   36,   40,   44,   51,   57,   60,   66,   72,   75,   81,
+    84,   91,   97,   100,  106,  112,  115,  121,  127,  130,  133,  133,
+    136,  139,  139,  142,  142,  145,  148,  148,  151,  154,  154,  157,
+    160,  167,  173,  176,  182,  188,  191,  197,  200,  207,  213,  216,
+    222,  228,  231,  237,  243,  250,  256,  259,  265,  271,  274,  280,
+    283,  290,  296,  299,  305,  311,  314,  320,  326,  329,  332,  332,
+    335,  338,  338,  341,  341,  344,  347,  347,  350,  353,  353,  356,
+    359,  366,  372,  375,  381,  387,  390,  396,  399,  406,  412,  415,
+    421,  427,  430,  436,  442,  445,  448,  448,  451,  454,  454,  457,
+    457,  460,  463,  463,  466,  469,  469,  472,  475,  482,  488,  491,
+    497,  503,  506,  512,  515,  522,  528,  531,  537,  543,  546,  552,
+    558,  565,  571,  574,  580,  586,  589,  595,  598,  605,  611,  614,
+    620,  626,  629,  635,  641,  644,  647,  647,  650,  653,  653,  656,
+    656,  659,  662,  662,  665,  668,  668,  671,  674,  681,  687,  690,
+    696,  702,  705,  711,  714,  721,  727,  730,  736,  742,  745,  751,
+    757,  764,  770,  773,  779,  785,  788,  794,  797,  804,  810,  813,
+    819,  825,  828,  834,  840,  843,  846,  846,  849,  852,  852,  855,
+    855,  858,  861,  861,  864,  867,  867,  870,  873,  880,  886,  889,
+    895,  901,  904,  910,  913,  920,  926,  929,  935,  941,  944,  950,
+    956,  960,  964,  964,  968,  972,  972,  976,  976,  980,  984,  984,
+    988,  992,  992,  996,  1000,
+};
+
+constexpr std::array<uint16_t, kNumLeds> kGridCellLeds = {
+    0,   1,   2,   3,   96,  97,  98,  99,  100, 101, 102, 103, 196, 197, 198,
+    199, 200, 201, 202, 203, 296, 297, 298, 299, 300, 301, 302, 303, 396, 397,
+    398, 399, 400, 401, 402, 403, 496, 497, 498, 499, 500, 501, 502, 503, 4,
+    5,   6,   996, 997, 998, 999, 93,  94,  95,  993, 994, 995, 990, 991, 992,
+    104, 105, 106, 987, 988, 989, 193, 194, 195, 984, 985, 986, 981, 982, 983,
+    204, 205, 206, 978, 979, 980, 975, 976, 977, 293, 294, 295, 971, 972, 973,
+    974, 304, 305, 306, 968, 969, 970, 965, 966, 967, 393, 394, 395, 962, 963,
+    964, 404, 405, 406, 959, 960, 961, 956, 957, 958, 493, 494, 495, 953, 954,
+    955, 504, 505, 506, 950, 951, 952, 7,   8,   9,   90,  91,  92,  107, 108,
+    109, 190, 191, 192, 207, 208, 209, 290, 291, 292, 307, 308, 309, 390, 391,
+    392, 407, 408, 409, 490, 491, 492, 507, 508, 509, 10,  11,  12,  900, 901,
+    902, 903, 87,  88,  89,  904, 905, 906, 907, 908, 909, 110, 111, 112, 910,
+    911, 912, 187, 188, 189, 913, 914, 915, 916, 917, 918, 210, 211, 212, 919,
+    920, 921, 922, 923, 924, 287, 288, 289, 925, 926, 927, 928, 310, 311, 312,
+    929, 930, 931, 932, 933, 934, 387, 388, 389, 935, 936, 937, 410, 411, 412,
+    938, 939, 940, 941, 942, 943, 487, 488, 489, 944, 945, 946, 510, 511, 512,
+    947, 948, 949, 13,  14,  15,  896, 897, 898, 899, 84,  85,  86,  893, 894,
+    895, 890, 891, 892, 113, 114, 115, 887, 888, 889, 184, 185, 186, 884, 885,
+    886, 881, 882, 883, 213, 214, 215, 878, 879, 880, 875, 876, 877, 284, 285,
+    286, 871, 872, 873, 874, 313, 314, 315, 868, 869, 870, 865, 866, 867, 384,
+    385, 386, 862, 863, 864, 413, 414, 415, 859, 860, 861, 856, 857, 858, 484,
+    485, 486, 853, 854, 855, 513, 514, 515, 850, 851, 852, 16,  17,  18,  81,
+    82,  83,  116, 117, 118, 181, 182, 183, 216, 217, 218, 281, 282, 283, 316,
+    317, 318, 381, 382, 383, 416, 417, 418, 481, 482, 483, 516, 517, 518, 19,
+    20,  21,  800, 801, 802, 803, 78,  79,  80,  804, 805, 806, 807, 808, 809,
+    119, 120, 121, 810, 811, 812, 178, 179, 180, 813, 814, 815, 816, 817, 818,
+    219, 220, 221, 819, 820, 821, 822, 823, 824, 278, 279, 280, 825, 826, 827,
+    828, 319, 320, 321, 829, 830, 831, 832, 833, 834, 378, 379, 380, 835, 836,
+    837, 419, 420, 421, 838, 839, 840, 841, 842, 843, 478, 479, 480, 844, 845,
+    846, 519, 520, 521, 847, 848, 849, 22,  23,  24,  75,  76,  77,  122, 123,
+    124, 175, 176, 177, 222, 223, 224, 275, 276, 277, 322, 323, 324, 375, 376,
+    377, 422, 423, 424, 475, 476, 477, 522, 523, 524, 25,  26,  27,  796, 797,
+    798, 799, 72,  73,  74,  793, 794, 795, 790, 791, 792, 125, 126, 127, 787,
+    788, 789, 172, 173, 174, 784, 785, 786, 781, 782, 783, 225, 226, 227, 778,
+    779, 780, 775, 776, 777, 272, 273, 274, 771, 772, 773, 774, 325, 326, 327,
+    768, 769, 770, 765, 766, 767, 372, 373, 374, 762, 763, 764, 425, 426, 427,
+    759, 760, 761, 756, 757, 758, 472, 473, 474, 753, 754, 755, 525, 526, 527,
+    750, 751, 752, 28,  29,  30,  700, 701, 702, 703, 69,  70,  71,  704, 705,
+    706, 707, 708, 709, 128, 129, 130, 710, 711, 712, 169, 170, 171, 713, 714,
+    715, 716, 717, 718, 228, 229, 230, 719, 720, 721, 722, 723, 724, 269, 270,
+    271, 725, 726, 727, 728, 328, 329, 330, 729, 730, 731, 732, 733, 734, 369,
+    370, 371, 735, 736, 737, 428, 429, 430, 738, 739, 740, 741, 742, 743, 469,
+    470, 471, 744, 745, 746, 528, 529, 530, 747, 748, 749, 31,  32,  33,  66,
+    67,  68,  131, 132, 133, 166, 167, 168, 231, 232, 233, 266, 267, 268, 331,
+    332, 333, 366, 367, 368, 431, 432, 433, 466, 467, 468, 531, 532, 533, 34,
+    35,  36,  696, 697, 698, 699, 63,  64,  65,  693, 694, 695, 690, 691, 692,
+    134, 135, 136, 687, 688, 689, 163, 164, 165, 684, 685, 686, 681, 682, 683,
+    234, 235, 236, 678, 679, 680, 675, 676, 677, 263, 264, 265, 671, 672, 673,
+    674, 334, 335, 336, 668, 669, 670, 665, 666, 667, 363, 364, 365, 662, 663,
+    664, 434, 435, 436, 659, 660, 661, 656, 657, 658, 463, 464, 465, 653, 654,
+    655, 534, 535, 536, 650, 651, 652, 37,  38,  39,  600, 601, 602, 603, 60,
+    61,  62,  604, 605, 606, 607, 608, 609, 137, 138, 139, 610, 611, 612, 160,
+    161, 162, 613, 614, 615, 616, 617, 618, 237, 238, 239, 619, 620, 621, 622,
+    623, 624, 260, 261, 262, 625, 626, 627, 628, 337, 338, 339, 629, 630, 631,
+    632, 633, 634, 360, 361, 362, 635, 636, 637, 437, 438, 439, 638, 639, 640,
+    641, 642, 643, 460, 461, 462, 644, 645, 646, 537, 538, 539, 647, 648, 649,
+    40,  41,  42,  57,  58,  59,  140, 141, 142, 157, 158, 159, 240, 241, 242,
+    257, 258, 259, 340, 341, 342, 357, 358, 359, 440, 441, 442, 457, 458, 459,
+    540, 541, 542, 43,  44,  45,  596, 597, 598, 599, 54,  55,  56,  593, 594,
+    595, 590, 591, 592, 143, 144, 145, 587, 588, 589, 154, 155, 156, 584, 585,
+    586, 581, 582, 583, 243, 244, 245, 578, 579, 580, 575, 576, 577, 254, 255,
+    256, 571, 572, 573, 574, 343, 344, 345, 568, 569, 570, 565, 566, 567, 354,
+    355, 356, 562, 563, 564, 443, 444, 445, 559, 560, 561, 556, 557, 558, 454,
+    455, 456, 553, 554, 555, 543, 544, 545, 550, 551, 552, 46,  47,  48,  49,
+    50,  51,  52,  53,  146, 147, 148, 149, 150, 151, 152, 153, 246, 247, 248,
+    249, 250, 251, 252, 253, 346, 347, 348, 349, 350, 351, 352, 353, 446, 447,
+    448, 449, 450, 451, 452, 453, 546, 547, 548, 549,
+};
+
+constexpr std::array<uint16_t, kNumLeds * LEDMapping::kNumNeighbors>
+    kNeighbors = {
+    1,   2,   3,   0,   0,   0,   0,   2,   3,   1,   1,   1,   3,   1,   0,
+    4,   2,   2,   2,   4,   1,   999, 998, 0,   999, 3,   998, 5,   2,   997,
+    999, 6,   998, 4,   7,   997, 7,   5,   8,   999, 6,   6,   6,   8,   5,
+    9,   7,   7,   9,   7,   900, 6,   901, 8,   8,   900, 901, 7,   10,  902,
+    11,  900, 901, 9,   12,  902, 10,  12,  13,  900, 11,  11,  13,  11,  14,
+    10,  12,  12,  12,  14,  11,  899, 898, 13,  13,  899, 898, 12,  15,  897,
+    899, 16,  898, 14,  17,  897, 17,  15,  18,  899, 16,  16,  16,  18,  15,
+    19,  17,  17,  17,  19,  16,  800, 801, 18,  800, 18,  801, 17,  20,  802,
+    21,  800, 801, 22,  19,  802, 20,  22,  23,  800, 21,  21,  21,  23,  20,
+    24,  22,  22,  24,  22,  21,  799, 23,  23,  23,  799, 798, 22,  25,  797,
+    26,  799, 798, 24,  27,  797, 25,  27,  799, 28,  798, 26,  28,  26,  29,
+    25,  27,  27,  27,  29,  26,  700, 701, 28,  28,  700, 701, 27,  30,  702,
+    700, 31,  701, 29,  32,  702, 32,  30,  33,  700, 31,  31,  31,  33,  30,
+    34,  32,  32,  32,  34,  31,  699, 698, 33,  699, 33,  698, 32,  35,  697,
+    36,  699, 698, 37,  34,  697, 35,  37,  38,  699, 36,  36,  36,  38,  35,
+    39,  37,  37,  39,  37,  36,  600, 38,  38,  38,  600, 601, 37,  40,  602,
+    41,  600, 601, 39,  42,  602, 40,  42,  600, 43,  601, 41,  43,  41,  40,
+    44,  42,  42,  42,  44,  41,  599, 598, 43,  599, 43,  598, 45,  42,  597,
+    599, 46,  598, 44,  47,  597, 47,  45,  48,  599, 46,  46,  46,  48,  45,
+    49,  47,  47,  49,  47,  46,  48,  48,  48,  48,  47,  49,  49,  49,  49,
+    51,  52,  50,  50,  50,  50,  50,  52,  53,  51,  51,  51,  53,  51,  50,
+    54,  52,  52,  52,  54,  51,  594, 593, 595, 594, 53,  593, 595, 55,  52,
+    594, 56,  593, 595, 54,  57,  57,  55,  58,  594, 56,  56,  56,  58,  55,
+    59,  57,  57,  59,  57,  605, 56,  606, 604, 58,  605, 606, 604, 57,  60,
+    61,  605, 606, 604, 59,  62,  60,  62,  63,  605, 61,  61,  63,  61,  64,
+    60,  62,  62,  62,  64,  61,  694, 693, 695, 63,  694, 693, 695, 62,  65,
+    694, 66,  693, 695, 64,  67,  67,  65,  68,  694, 66,  66,  66,  68,  65,
+    69,  67,  67,  67,  69,  66,  705, 706, 704, 705, 68,  706, 704, 67,  70,
+    71,  705, 706, 704, 72,  69,  70,  72,  73,  705, 71,  71,  71,  73,  70,
+    74,  72,  72,  74,  72,  794, 71,  793, 795, 73,  794, 793, 795, 72,  75,
+    76,  794, 793, 795, 74,  77,  75,  77,  78,  794, 76,  76,  78,  76,  79,
+    75,  77,  77,  77,  79,  76,  805, 806, 804, 78,  805, 806, 804, 77,  80,
+    805, 81,  806, 804, 79,  82,  82,  80,  83,  805, 81,  81,  81,  83,  80,
+    84,  82,  82,  82,  84,  81,  894, 893, 895, 894, 83,  893, 895, 82,  85,
+    86,  894, 893, 895, 87,  84,  85,  87,  88,  894, 86,  86,  86,  88,  85,
+    89,  87,  87,  89,  87,  86,  905, 88,  88,  88,  905, 906, 904, 87,  90,
+    91,  905, 906, 904, 89,  92,  90,  92,  905, 93,  906, 904, 93,  91,  90,
+    94,  92,  92,  92,  94,  91,  994, 993, 995, 994, 93,  993, 995, 95,  92,
+    994, 96,  993, 995, 94,  97,  97,  95,  98,  994, 96,  96,  96,  98,  95,
+    99,  97,  97,  99,  97,  96,  98,  98,  98,  98,  97,  99,  99,  99,  99,
+    101, 102, 100, 100, 100, 100, 100, 102, 103, 101, 101, 101, 103, 101, 100,
+    104, 102, 102, 102, 104, 101, 989, 103, 103, 989, 103, 988, 990, 105, 102,
+    989, 106, 988, 990, 104, 107, 107, 105, 108, 989, 106, 106, 106, 108, 105,
+    109, 107, 107, 109, 107, 910, 106, 909, 911, 108, 910, 909, 911, 107, 110,
+    111, 910, 909, 911, 109, 112, 110, 112, 113, 910, 111, 111, 113, 111, 114,
+    110, 112, 112, 112, 114, 111, 889, 113, 113, 113, 889, 888, 890, 112, 115,
+    889, 116, 888, 890, 114, 117, 117, 115, 118, 889, 116, 116, 116, 118, 115,
+    119, 117, 117, 117, 119, 116, 810, 118, 118, 810, 118, 809, 811, 117, 120,
+    121, 810, 809, 811, 122, 119, 120, 122, 123, 810, 121, 121, 121, 123, 120,
+    124, 122, 122, 124, 122, 121, 789, 123, 123, 123, 789, 788, 790, 122, 125,
+    126, 789, 788, 790, 124, 127, 125, 127, 789, 128, 788, 790, 128, 126, 129,
+    125, 127, 127, 127, 129, 126, 710, 128, 128, 128, 710, 709, 711, 127, 130,
+    710, 131, 709, 711, 129, 132, 132, 130, 133, 710, 131, 131, 131, 133, 130,
+    134, 132, 132, 132, 134, 131, 689, 133, 133, 689, 133, 688, 690, 132, 135,
+    136, 689, 688, 690, 137, 134, 135, 137, 138, 689, 136, 136, 136, 138, 135,
+    139, 137, 137, 139, 137, 136, 610, 138, 138, 138, 610, 609, 611, 137, 140,
+    141, 610, 609, 611, 139, 142, 140, 142, 610, 143, 609, 611, 143, 141, 140,
+    144, 142, 142, 142, 144, 141, 589, 143, 143, 589, 143, 588, 590, 145, 142,
+    589, 146, 588, 590, 144, 147, 147, 145, 148, 589, 146, 146, 146, 148, 145,
+    149, 147, 147, 149, 147, 146, 148, 148, 148, 148, 147, 149, 149, 149, 149,
+    151, 152, 150, 150, 150, 150, 150, 152, 153, 151, 151, 151, 153, 151, 150,
+    154, 152, 152, 152, 154, 151, 584, 583, 585, 584, 153, 583, 585, 155, 152,
+    584, 156, 583, 585, 154, 157, 157, 155, 158, 584, 156, 156, 156, 158, 155,
+    159, 157, 157, 159, 157, 615, 156, 616, 614, 158, 615, 616, 614, 157, 160,
+    161, 615, 616, 614, 159, 162, 160, 162, 163, 615, 161, 161, 163, 161, 164,
+    160, 162, 162, 162, 164, 161, 684, 683, 685, 163, 684, 683, 685, 162, 165,
+    684, 166, 683, 685, 164, 167, 167, 165, 168, 684, 166, 166, 166, 168, 165,
+    169, 167, 167, 167, 169, 166, 715, 716, 714, 715, 168, 716, 714, 167, 170,
+    171, 715, 716, 714, 172, 169, 170, 172, 173, 715, 171, 171, 171, 173, 170,
+    174, 172, 172, 174, 172, 784, 171, 783, 785, 173, 784, 783, 785, 172, 175,
+    176, 784, 783, 785, 174, 177, 175, 177, 178, 784, 176, 176, 178, 176, 179,
+    175, 177, 177, 177, 179, 176, 815, 816, 814, 178, 815, 816, 814, 177, 180,
+    815, 181, 816, 814, 179, 182, 182, 180, 183, 815, 181, 181, 181, 183, 180,
+    184, 182, 182, 182, 184, 181, 884, 883, 885, 884, 183, 883, 885, 182, 185,
+    186, 884, 883, 885, 187, 184, 185, 187, 188, 884, 186, 186, 186, 188, 185,
+    189, 187, 187, 189, 187, 186, 915, 188, 188, 188, 915, 916, 914, 187, 190,
+    191, 915, 916, 914, 189, 192, 190, 192, 915, 193, 916, 914, 193, 191, 190,
+    194, 192, 192, 192, 194, 191, 984, 983, 985, 984, 193, 983, 985, 195, 192,
+    984, 196, 983, 985, 194, 197, 197, 195, 198, 984, 196, 196, 196, 198, 195,
+    199, 197, 197, 199, 197, 196, 198, 198, 198, 198, 197, 199, 199, 199, 199,
+    201, 202, 200, 200, 200, 200, 200, 202, 203, 201, 201, 201, 203, 201, 200,
+    204, 202, 202, 202, 204, 201, 979, 203, 203, 979, 203, 978, 980, 205, 202,
+    979, 206, 978, 980, 204, 207, 207, 205, 208, 979, 206, 206, 206, 208, 205,
+    209, 207, 207, 209, 207, 920, 206, 919, 921, 208, 920, 919, 921, 207, 210,
+    211, 920, 919, 921, 209, 212, 210, 212, 213, 920, 211, 211, 213, 211, 214,
+    210, 212, 212, 212, 214, 211, 879, 213, 213, 213, 879, 878, 880, 212, 215,
+    879, 216, 878, 880, 214, 217, 217, 215, 218, 879, 216, 216, 216, 218, 215,
+    219, 217, 217, 217, 219, 216, 820, 218, 218, 820, 218, 819, 821, 217, 220,
+    221, 820, 819, 821, 222, 219, 220, 222, 223, 820, 221, 221, 221, 223, 220,
+    224, 222, 222, 224, 222, 221, 779, 223, 223, 223, 779, 778, 780, 222, 225,
+    226, 779, 778, 780, 224, 227, 225, 227, 779, 228, 778, 780, 228, 226, 229,
+    225, 227, 227, 227, 229, 226, 720, 228, 228, 228, 720, 719, 721, 227, 230,
+    720, 231, 719, 721, 229, 232, 232, 230, 233, 720, 231, 231, 231, 233, 230,
+    234, 232, 232, 232, 234, 231, 679, 233, 233, 679, 233, 678, 680, 232, 235,
+    236, 679, 678, 680, 237, 234, 235, 237, 238, 679, 236, 236, 236, 238, 235,
+    239, 237, 237, 239, 237, 236, 620, 238, 238, 238, 620, 619, 621, 237, 240,
+    241, 620, 619, 621, 239, 242, 240, 242, 620, 243, 619, 621, 243, 241, 240,
+    244, 242, 242, 242, 244, 241, 579, 243, 243, 579, 243, 578, 580, 245, 242,
+    579, 246, 578, 580, 244, 247, 247, 245, 248, 579, 246, 246, 246, 248, 245,
+    249, 247, 247, 249, 247, 246, 248, 248, 248, 248, 247, 249, 249, 249, 249,
+    251, 252, 250, 250, 250, 250, 250, 252, 253, 251, 251, 251, 253, 251, 250,
+    254, 252, 252, 252, 254, 251, 574, 573, 575, 574, 253, 573, 575, 255, 252,
+    574, 256, 573, 575, 254, 257, 257, 255, 258, 574, 256, 256, 256, 258, 255,
+    259, 257, 257, 259, 257, 625, 256, 626, 624, 258, 625, 626, 624, 257, 260,
+    261, 625, 626, 624, 259, 262, 260, 262, 263, 625, 261, 261, 263, 261, 264,
+    260, 262, 262, 262, 264, 261, 674, 673, 675, 263, 674, 673, 675, 262, 265,
+    674, 266, 673, 675, 264, 267, 267, 265, 268, 674, 266, 266, 266, 268, 265,
+    269, 267, 267, 267, 269, 266, 725, 726, 724, 725, 268, 726, 724, 267, 270,
+    271, 725, 726, 724, 272, 269, 270, 272, 273, 725, 271, 271, 271, 273, 270,
+    274, 272, 272, 274, 272, 774, 271, 773, 775, 273, 774, 773, 775, 272, 275,
+    276, 774, 773, 775, 274, 277, 275, 277, 278, 774, 276, 276, 278, 276, 279,
+    275, 277, 277, 277, 279, 276, 825, 826, 824, 278, 825, 826, 824, 277, 280,
+    825, 281, 826, 824, 279, 282, 282, 280, 283, 825, 281, 281, 281, 283, 280,
+    284, 282, 282, 282, 284, 281, 874, 873, 875, 874, 283, 873, 875, 282, 285,
+    286, 874, 873, 875, 287, 284, 285, 287, 288, 874, 286, 286, 286, 288, 285,
+    289, 287, 287, 289, 287, 286, 925, 288, 288, 288, 925, 926, 924, 287, 290,
+    291, 925, 926, 924, 289, 292, 290, 292, 925, 293, 926, 924, 293, 291, 290,
+    294, 292, 292, 292, 294, 291, 974, 973, 975, 974, 293, 973, 975, 295, 292,
+    974, 296, 973, 975, 294, 297, 297, 295, 298, 974, 296, 296, 296, 298, 295,
+    299, 297, 297, 299, 297, 296, 298, 298, 298, 298, 297, 299, 299, 299, 299,
+    301, 302, 300, 300, 300, 300, 300, 302, 303, 301, 301, 301, 303, 301, 300,
+    304, 302, 302, 302, 304, 301, 969, 303, 303, 969, 303, 968, 970, 305, 302,
+    969, 306, 968, 970, 304, 307, 307, 305, 308, 969, 306, 306, 306, 308, 305,
+    309, 307, 307, 309, 307, 930, 306, 929, 931, 308, 930, 929, 931, 307, 310,
+    311, 930, 929, 931, 309, 312, 310, 312, 313, 930, 311, 311, 313, 311, 314,
+    310, 312, 312, 312, 314, 311, 869, 313, 313, 313, 869, 868, 870, 312, 315,
+    869, 316, 868, 870, 314, 317, 317, 315, 318, 869, 316, 316, 316, 318, 315,
+    319, 317, 317, 317, 319, 316, 830, 318, 318, 830, 318, 829, 831, 317, 320,
+    321, 830, 829, 831, 322, 319, 320, 322, 323, 830, 321, 321, 321, 323, 320,
+    324, 322, 322, 324, 322, 321, 769, 323, 323, 323, 769, 768, 770, 322, 325,
+    326, 769, 768, 770, 324, 327, 325, 327, 769, 328, 768, 770, 328, 326, 329,
+    325, 327, 327, 327, 329, 326, 730, 328, 328, 328, 730, 729, 731, 327, 330,
+    730, 331, 729, 731, 329, 332, 332, 330, 333, 730, 331, 331, 331, 333, 330,
+    334, 332, 332, 332, 334, 331, 669, 333, 333, 669, 333, 668, 670, 332, 335,
+    336, 669, 668, 670, 337, 334, 335, 337, 338, 669, 336, 336, 336, 338, 335,
+    339, 337, 337, 339, 337, 336, 630, 338, 338, 338, 630, 629, 631, 337, 340,
+    341, 630, 629, 631, 339, 342, 340, 342, 630, 343, 629, 631, 343, 341, 340,
+    344, 342, 342, 342, 344, 341, 569, 343, 343, 569, 343, 568, 570, 345, 342,
+    569, 346, 568, 570, 344, 347, 347, 345, 348, 569, 346, 346, 346, 348, 345,
+    349, 347, 347, 349, 347, 346, 348, 348, 348, 348, 347, 349, 349, 349, 349,
+    351, 352, 350, 350, 350, 350, 350, 352, 353, 351, 351, 351, 353, 351, 350,
+    354, 352, 352, 352, 354, 351, 564, 563, 565, 564, 353, 563, 565, 355, 352,
+    564, 356, 563, 565, 354, 357, 357, 355, 358, 564, 356, 356, 356, 358, 355,
+    359, 357, 357, 359, 357, 635, 356, 636, 634, 358, 635, 636, 634, 357, 360,
+    361, 635, 636, 634, 359, 362, 360, 362, 363, 635, 361, 361, 363, 361, 364,
+    360, 362, 362, 362, 364, 361, 664, 663, 665, 363, 664, 663, 665, 362, 365,
+    664, 366, 663, 665, 364, 367, 367, 365, 368, 664, 366, 366, 366, 368, 365,
+    369, 367, 367, 367, 369, 366, 735, 736, 734, 735, 368, 736, 734, 367, 370,
+    371, 735, 736, 734, 372, 369, 370, 372, 373, 735, 371, 371, 371, 373, 370,
+    374, 372, 372, 374, 372, 764, 371, 763, 765, 373, 764, 763, 765, 372, 375,
+    376, 764, 763, 765, 374, 377, 375, 377, 378, 764, 376, 376, 378, 376, 379,
+    375, 377, 377, 377, 379, 376, 835, 836, 834, 378, 835, 836, 834, 377, 380,
+    835, 381, 836, 834, 379, 382, 382, 380, 383, 835, 381, 381, 381, 383, 380,
+    384, 382, 382, 382, 384, 381, 864, 863, 865, 864, 383, 863, 865, 382, 385,
+    386, 864, 863, 865, 387, 384, 385, 387, 388, 864, 386, 386, 386, 388, 385,
+    389, 387, 387, 389, 387, 386, 935, 388, 388, 388, 935, 936, 934, 387, 390,
+    391, 935, 936, 934, 389, 392, 390, 392, 935, 393, 936, 934, 393, 391, 390,
+    394, 392, 392, 392, 394, 391, 964, 963, 965, 964, 393, 963, 965, 395, 392,
+    964, 396, 963, 965, 394, 397, 397, 395, 398, 964, 396, 396, 396, 398, 395,
+    399, 397, 397, 399, 397, 396, 398, 398, 398, 398, 397, 399, 399, 399, 399,
+    401, 402, 400, 400, 400, 400, 400, 402, 403, 401, 401, 401, 403, 401, 400,
+    404, 402, 402, 402, 404, 401, 959, 403, 403, 959, 403, 958, 960, 405, 402,
+    959, 406, 958, 960, 404, 407, 407, 405, 408, 959, 406, 406, 406, 408, 405,
+    409, 407, 407, 409, 407, 940, 406, 939, 941, 408, 940, 939, 941, 407, 410,
+    411, 940, 939, 941, 409, 412, 410, 412, 413, 940, 411, 411, 413, 411, 414,
+    410, 412, 412, 412, 414, 411, 859, 413, 413, 413, 859, 858, 860, 412, 415,
+    859, 416, 858, 860, 414, 417, 417, 415, 418, 859, 416, 416, 416, 418, 415,
+    419, 417, 417, 417, 419, 416, 840, 418, 418, 840, 418, 839, 841, 417, 420,
+    421, 840, 839, 841, 422, 419, 420, 422, 423, 840, 421, 421, 421, 423, 420,
+    424, 422, 422, 424, 422, 421, 759, 423, 423, 423, 759, 758, 760, 422, 425,
+    426, 759, 758, 760, 424, 427, 425, 427, 759, 428, 758, 760, 428, 426, 429,
+    425, 427, 427, 427, 429, 426, 740, 428, 428, 428, 740, 739, 741, 427, 430,
+    740, 431, 739, 741, 429, 432, 432, 430, 433, 740, 431, 431, 431, 433, 430,
+    434, 432, 432, 432, 434, 431, 659, 433, 433, 659, 433, 658, 660, 432, 435,
+    436, 659, 658, 660, 437, 434, 435, 437, 438, 659, 436, 436, 436, 438, 435,
+    439, 437, 437, 439, 437, 436, 640, 438, 438, 438, 640, 639, 641, 437, 440,
+    441, 640, 639, 641, 439, 442, 440, 442, 640, 443, 639, 641, 443, 441, 440,
+    444, 442, 442, 442, 444, 441, 559, 443, 443, 559, 443, 558, 560, 445, 442,
+    559, 446, 558, 560, 444, 447, 447, 445, 448, 559, 446, 446, 446, 448, 445,
+    449, 447, 447, 449, 447, 446, 448, 448, 448, 448, 447, 449, 449, 449, 449,
+    451, 452, 450, 450, 450, 450, 450, 452, 453, 451, 451, 451, 453, 451, 450,
+    454, 452, 452, 452, 454, 451, 554, 553, 555, 554, 453, 553, 555, 455, 452,
+    554, 456, 553, 555, 454, 457, 457, 455, 458, 554, 456, 456, 456, 458, 455,
+    459, 457, 457, 459, 457, 645, 456, 646, 644, 458, 645, 646, 644, 457, 460,
+    461, 645, 646, 644, 459, 462, 460, 462, 463, 645, 461, 461, 463, 461, 464,
+    460, 462, 462, 462, 464, 461, 654, 653, 655, 463, 654, 653, 655, 462, 465,
+    654, 466, 653, 655, 464, 467, 467, 465, 468, 654, 466, 466, 466, 468, 465,
+    469, 467, 467, 467, 469, 466, 745, 746, 744, 745, 468, 746, 744, 467, 470,
+    471, 745, 746, 744, 472, 469, 470, 472, 473, 745, 471, 471, 471, 473, 470,
+    474, 472, 472, 474, 472, 754, 471, 753, 755, 473, 754, 753, 755, 472, 475,
+    476, 754, 753, 755, 474, 477, 475, 477, 478, 754, 476, 476, 478, 476, 479,
+    475, 477, 477, 477, 479, 476, 845, 846, 844, 478, 845, 846, 844, 477, 480,
+    845, 481, 846, 844, 479, 482, 482, 480, 483, 845, 481, 481, 481, 483, 480,
+    484, 482, 482, 482, 484, 481, 854, 853, 855, 854, 483, 853, 855, 482, 485,
+    486, 854, 853, 855, 487, 484, 485, 487, 488, 854, 486, 486, 486, 488, 485,
+    489, 487, 487, 489, 487, 486, 945, 488, 488, 488, 945, 946, 944, 487, 490,
+    491, 945, 946, 944, 489, 492, 490, 492, 945, 493, 946, 944, 493, 491, 490,
+    494, 492, 492, 492, 494, 491, 954, 953, 955, 954, 493, 953, 955, 495, 492,
+    954, 496, 953, 955, 494, 497, 497, 495, 498, 954, 496, 496, 496, 498, 495,
+    499, 497, 497, 499, 497, 496, 498, 498, 498, 498, 497, 499, 499, 499, 499,
+    501, 502, 503, 500, 500, 500, 500, 502, 503, 501, 501, 501, 503, 501, 500,
+    504, 502, 502, 502, 504, 501, 950, 500, 505, 503, 950, 505, 502, 951, 506,
+    506, 950, 504, 507, 951, 503, 507, 505, 508, 950, 504, 509, 506, 508, 505,
+    509, 507, 507, 509, 507, 506, 949, 948, 510, 508, 949, 507, 510, 948, 506,
+    511, 949, 509, 512, 948, 508, 510, 512, 513, 949, 514, 511, 513, 511, 514,
+    510, 512, 512, 512, 514, 511, 850, 515, 513, 513, 850, 512, 515, 851, 511,
+    516, 850, 514, 517, 851, 513, 517, 515, 518, 850, 519, 516, 516, 518, 515,
+    519, 517, 517, 517, 519, 516, 849, 848, 518, 518, 849, 517, 520, 848, 516,
+    521, 849, 522, 519, 848, 523, 520, 522, 523, 849, 524, 521, 521, 523, 520,
+    524, 522, 522, 524, 522, 521, 750, 520, 525, 523, 750, 522, 525, 751, 521,
+    526, 750, 524, 527, 751, 523, 525, 527, 528, 750, 751, 526, 528, 526, 529,
+    525, 527, 527, 527, 529, 526, 749, 530, 528, 528, 749, 527, 530, 748, 529,
+    531, 749, 529, 532, 748, 528, 532, 530, 533, 749, 534, 531, 531, 533, 530,
+    534, 532, 532, 532, 534, 531, 650, 651, 533, 533, 650, 532, 535, 651, 531,
+    536, 650, 537, 534, 651, 538, 535, 537, 538, 650, 539, 536, 536, 538, 535,
+    539, 537, 537, 539, 537, 536, 649, 535, 540, 538, 649, 537, 540, 648, 536,
+    541, 649, 539, 542, 648, 538, 540, 542, 543, 649, 648, 541, 543, 541, 540,
+    544, 542, 542, 542, 544, 541, 550, 545, 543, 543, 550, 545, 542, 551, 546,
+    546, 550, 544, 547, 551, 543, 547, 545, 548, 550, 544, 549, 546, 548, 545,
+    549, 547, 547, 549, 547, 546, 548, 548, 548, 548, 547, 546, 549, 549, 549,
+    551, 544, 545, 552, 543, 546, 550, 552, 553, 544, 545, 551, 551, 553, 550,
+    552, 552, 552, 552, 554, 454, 455, 551, 453, 454, 455, 553, 555, 453, 456,
+    556, 554, 454, 455, 557, 453, 555, 557, 558, 556, 556, 556, 556, 558, 555,
+    557, 557, 557, 557, 559, 444, 445, 556, 560, 444, 445, 558, 560, 443, 446,
+    559, 561, 444, 445, 558, 562, 560, 562, 563, 561, 561, 561, 561, 563, 560,
+    562, 562, 562, 562, 564, 354, 355, 561, 353, 354, 355, 563, 565, 353, 356,
+    566, 564, 354, 355, 567, 353, 565, 567, 568, 566, 566, 566, 566, 568, 565,
+    567, 567, 567, 567, 569, 344, 345, 566, 570, 344, 345, 568, 570, 343, 346,
+    569, 571, 344, 345, 568, 572, 570, 572, 573, 571, 571, 571, 571, 573, 570,
+    572, 572, 572, 572, 574, 254, 255, 571, 253, 254, 255, 573, 575, 253, 256,
+    576, 574, 254, 255, 577, 253, 575, 577, 578, 576, 576, 576, 576, 578, 575,
+    577, 577, 577, 577, 579, 244, 245, 576, 580, 244, 245, 578, 580, 243, 246,
+    579, 581, 244, 245, 578, 582, 580, 582, 583, 581, 581, 581, 581, 583, 580,
+    582, 582, 582, 582, 584, 154, 155, 581, 153, 154, 155, 583, 585, 153, 156,
+    586, 584, 154, 155, 587, 153, 585, 587, 588, 586, 586, 586, 586, 588, 585,
+    587, 587, 587, 587, 589, 144, 145, 586, 590, 144, 145, 588, 590, 143, 146,
+    589, 591, 144, 145, 588, 592, 590, 592, 593, 591, 591, 591, 591, 593, 590,
+    592, 592, 592, 592, 594, 54,  55,  591, 53,  54,  55,  593, 595, 53,  56,
+    596, 594, 54,  55,  597, 53,  595, 597, 598, 596, 596, 596, 596, 598, 595,
+    599, 44,  45,  597, 599, 44,  45,  596, 43,  44,  45,  598, 43,  46,  597,
+    40,  39,  601, 41,  38,  602, 600, 602, 40,  39,  41,  603, 601, 603, 600,
+    604, 40,  39,  602, 604, 601, 603, 603, 603, 603, 605, 59,  60,  58,  602,
+    59,  60,  606, 604, 58,  61,  605, 607, 59,  60,  58,  608, 606, 608, 609,
+    607, 607, 607, 607, 609, 606, 608, 608, 608, 608, 610, 140, 139, 141, 607,
+    140, 139, 609, 611, 141, 138, 610, 612, 140, 139, 141, 611, 611, 613, 614,
+    612, 612, 612, 612, 614, 613, 613, 613, 613, 613, 615, 159, 160, 158, 612,
+    159, 160, 616, 614, 158, 161, 615, 617, 159, 160, 158, 618, 616, 618, 619,
+    617, 617, 617, 617, 619, 616, 618, 618, 618, 618, 620, 240, 239, 241, 617,
+    240, 239, 619, 621, 241, 238, 620, 622, 240, 239, 241, 621, 621, 623, 624,
+    622, 622, 622, 622, 624, 623, 623, 623, 623, 623, 625, 259, 260, 258, 622,
+    259, 260, 626, 624, 258, 261, 625, 627, 259, 260, 258, 628, 626, 628, 629,
+    627, 627, 627, 627, 629, 626, 628, 628, 628, 628, 630, 340, 339, 341, 627,
+    340, 339, 629, 631, 341, 338, 630, 632, 340, 339, 341, 631, 631, 633, 634,
+    632, 632, 632, 632, 634, 633, 633, 633, 633, 633, 635, 359, 360, 358, 632,
+    359, 360, 636, 634, 358, 361, 635, 637, 359, 360, 358, 638, 636, 638, 639,
+    637, 637, 637, 637, 639, 636, 638, 638, 638, 638, 640, 440, 439, 441, 637,
+    440, 439, 639, 641, 441, 438, 640, 642, 440, 439, 441, 641, 641, 643, 644,
+    642, 642, 642, 642, 644, 643, 643, 643, 643, 643, 645, 459, 460, 458, 642,
+    459, 460, 646, 644, 458, 461, 645, 647, 459, 460, 458, 648, 646, 648, 649,
+    647, 647, 647, 647, 649, 646, 540, 539, 541, 648, 540, 539, 541, 647, 538,
+    651, 534, 535, 652, 533, 536, 650, 652, 653, 534, 535, 533, 651, 653, 650,
+    652, 652, 652, 652, 654, 465, 464, 651, 463, 465, 464, 653, 655, 463, 466,
+    656, 654, 465, 464, 657, 463, 655, 657, 658, 656, 656, 656, 656, 658, 655,
+    657, 657, 657, 657, 659, 434, 435, 656, 660, 434, 435, 658, 660, 433, 436,
+    659, 661, 434, 435, 658, 662, 660, 662, 663, 661, 661, 661, 661, 663, 660,
+    662, 662, 662, 662, 664, 365, 364, 661, 363, 365, 364, 663, 665, 363, 366,
+    666, 664, 365, 364, 667, 363, 665, 667, 668, 666, 666, 666, 666, 668, 665,
+    667, 667, 667, 667, 669, 334, 335, 666, 670, 334, 335, 668, 670, 333, 336,
+    669, 671, 334, 335, 668, 672, 670, 672, 673, 671, 671, 671, 671, 673, 670,
+    672, 672, 672, 672, 674, 265, 264, 671, 263, 265, 264, 673, 675, 263, 266,
+    676, 674, 265, 264, 677, 263, 675, 677, 678, 676, 676, 676, 676, 678, 675,
+    677, 677, 677, 677, 679, 234, 235, 676, 680, 234, 235, 678, 680, 233, 236,
+    679, 681, 234, 235, 678, 682, 680, 682, 683, 681, 681, 681, 681, 683, 680,
+    682, 682, 682, 682, 684, 165, 164, 681, 163, 165, 164, 683, 685, 163, 166,
+    686, 684, 165, 164, 687, 163, 685, 687, 688, 686, 686, 686, 686, 688, 685,
+    687, 687, 687, 687, 689, 134, 135, 686, 690, 134, 135, 688, 690, 133, 136,
+    689, 691, 134, 135, 688, 692, 690, 692, 693, 691, 691, 691, 691, 693, 690,
+    692, 692, 692, 692, 694, 65,  64,  691, 63,  65,  64,  693, 695, 63,  66,
+    696, 694, 65,  64,  697, 63,  695, 697, 698, 696, 696, 696, 696, 698, 695,
+    699, 34,  35,  697, 699, 34,  35,  696, 33,  34,  35,  698, 33,  36,  697,
+    30,  29,  701, 28,  31,  702, 700, 702, 30,  29,  703, 28,  701, 703, 700,
+    704, 30,  29,  702, 704, 701, 703, 703, 703, 703, 705, 69,  70,  702, 68,
+    69,  70,  706, 704, 68,  71,  705, 707, 69,  70,  708, 68,  706, 708, 709,
+    707, 707, 707, 707, 709, 706, 708, 708, 708, 708, 710, 130, 129, 707, 711,
+    130, 129, 709, 711, 128, 131, 710, 712, 130, 129, 709, 713, 711, 713, 714,
+    712, 712, 712, 712, 714, 711, 713, 713, 713, 713, 715, 169, 170, 712, 168,
+    169, 170, 716, 714, 168, 171, 715, 717, 169, 170, 718, 168, 716, 718, 719,
+    717, 717, 717, 717, 719, 716, 718, 718, 718, 718, 720, 230, 229, 717, 721,
+    230, 229, 719, 721, 228, 231, 720, 722, 230, 229, 719, 723, 721, 723, 724,
+    722, 722, 722, 722, 724, 721, 723, 723, 723, 723, 725, 269, 270, 722, 268,
+    269, 270, 726, 724, 268, 271, 725, 727, 269, 270, 728, 268, 726, 728, 729,
+    727, 727, 727, 727, 729, 726, 728, 728, 728, 728, 730, 330, 329, 727, 731,
+    330, 329, 729, 731, 328, 331, 730, 732, 330, 329, 729, 733, 731, 733, 734,
+    732, 732, 732, 732, 734, 731, 733, 733, 733, 733, 735, 369, 370, 732, 368,
+    369, 370, 736, 734, 368, 371, 735, 737, 369, 370, 738, 368, 736, 738, 739,
+    737, 737, 737, 737, 739, 736, 738, 738, 738, 738, 740, 430, 429, 737, 741,
+    430, 429, 739, 741, 428, 431, 740, 742, 430, 429, 739, 743, 741, 743, 744,
+    742, 742, 742, 742, 744, 741, 743, 743, 743, 743, 745, 469, 470, 742, 468,
+    469, 470, 746, 744, 468, 471, 745, 747, 469, 470, 748, 468, 746, 748, 749,
+    747, 747, 747, 747, 749, 746, 530, 529, 748, 748, 530, 529, 747, 528, 531,
+    751, 525, 524, 526, 752, 523, 750, 752, 753, 525, 524, 526, 751, 753, 750,
+    752, 752, 752, 752, 754, 474, 475, 473, 751, 474, 475, 753, 755, 473, 476,
+    756, 754, 474, 475, 473, 757, 755, 757, 758, 756, 756, 756, 756, 758, 755,
+    757, 757, 757, 757, 759, 425, 424, 426, 756, 425, 424, 758, 760, 426, 423,
+    759, 761, 425, 424, 426, 760, 760, 762, 763, 761, 761, 761, 761, 763, 762,
+    762, 762, 762, 762, 764, 374, 375, 373, 761, 374, 375, 763, 765, 373, 376,
+    766, 764, 374, 375, 373, 767, 765, 767, 768, 766, 766, 766, 766, 768, 765,
+    767, 767, 767, 767, 769, 325, 324, 326, 766, 325, 324, 768, 770, 326, 323,
+    769, 771, 325, 324, 326, 770, 770, 772, 773, 771, 771, 771, 771, 773, 772,
+    772, 772, 772, 772, 774, 274, 275, 273, 771, 274, 275, 773, 775, 273, 276,
+    776, 774, 274, 275, 273, 777, 775, 777, 778, 776, 776, 776, 776, 778, 775,
+    777, 777, 777, 777, 779, 225, 224, 226, 776, 225, 224, 778, 780, 226, 223,
+    779, 781, 225, 224, 226, 780, 780, 782, 783, 781, 781, 781, 781, 783, 782,
+    782, 782, 782, 782, 784, 174, 175, 173, 781, 174, 175, 783, 785, 173, 176,
+    786, 784, 174, 175, 173, 787, 785, 787, 788, 786, 786, 786, 786, 788, 785,
+    787, 787, 787, 787, 789, 125, 124, 126, 786, 125, 124, 788, 790, 126, 123,
+    789, 791, 125, 124, 126, 790, 790, 792, 793, 791, 791, 791, 791, 793, 792,
+    792, 792, 792, 792, 794, 74,  75,  73,  791, 74,  75,  793, 795, 73,  76,
+    796, 794, 74,  75,  73,  797, 795, 797, 798, 796, 796, 796, 796, 798, 795,
+    799, 25,  24,  797, 799, 25,  24,  26,  796, 25,  24,  798, 26,  23,  797,
+    19,  20,  801, 18,  21,  802, 800, 802, 19,  20,  803, 18,  801, 803, 800,
+    804, 19,  20,  802, 804, 801, 803, 803, 803, 803, 805, 80,  79,  802, 78,
+    80,  79,  806, 804, 78,  81,  805, 807, 80,  79,  808, 78,  806, 808, 809,
+    807, 807, 807, 807, 809, 806, 808, 808, 808, 808, 810, 119, 120, 807, 811,
+    119, 120, 809, 811, 118, 121, 810, 812, 119, 120, 809, 813, 811, 813, 814,
+    812, 812, 812, 812, 814, 811, 813, 813, 813, 813, 815, 180, 179, 812, 178,
+    180, 179, 816, 814, 178, 181, 815, 817, 180, 179, 818, 178, 816, 818, 819,
+    817, 817, 817, 817, 819, 816, 818, 818, 818, 818, 820, 219, 220, 817, 821,
+    219, 220, 819, 821, 218, 221, 820, 822, 219, 220, 819, 823, 821, 823, 824,
+    822, 822, 822, 822, 824, 821, 823, 823, 823, 823, 825, 280, 279, 822, 278,
+    280, 279, 826, 824, 278, 281, 825, 827, 280, 279, 828, 278, 826, 828, 829,
+    827, 827, 827, 827, 829, 826, 828, 828, 828, 828, 830, 319, 320, 827, 831,
+    319, 320, 829, 831, 318, 321, 830, 832, 319, 320, 829, 833, 831, 833, 834,
+    832, 832, 832, 832, 834, 831, 833, 833, 833, 833, 835, 380, 379, 832, 378,
+    380, 379, 836, 834, 378, 381, 835, 837, 380, 379, 838, 378, 836, 838, 839,
+    837, 837, 837, 837, 839, 836, 838, 838, 838, 838, 840, 419, 420, 837, 841,
+    419, 420, 839, 841, 418, 421, 840, 842, 419, 420, 839, 843, 841, 843, 844,
+    842, 842, 842, 842, 844, 841, 843, 843, 843, 843, 845, 480, 479, 842, 478,
+    480, 479, 846, 844, 478, 481, 845, 847, 480, 479, 848, 478, 846, 848, 849,
+    847, 847, 847, 847, 849, 846, 519, 520, 518, 848, 519, 520, 847, 518, 521,
+    851, 515, 514, 852, 513, 516, 850, 852, 853, 515, 514, 851, 851, 853, 850,
+    852, 852, 852, 852, 854, 484, 485, 851, 483, 484, 485, 853, 855, 483, 486,
+    856, 854, 484, 485, 857, 483, 855, 857, 858, 856, 856, 856, 856, 858, 855,
+    857, 857, 857, 857, 859, 415, 414, 856, 860, 415, 414, 858, 860, 413, 416,
+    859, 861, 415, 414, 858, 862, 860, 862, 863, 861, 861, 861, 861, 863, 860,
+    862, 862, 862, 862, 864, 384, 385, 861, 383, 384, 385, 863, 865, 383, 386,
+    866, 864, 384, 385, 867, 383, 865, 867, 868, 866, 866, 866, 866, 868, 865,
+    867, 867, 867, 867, 869, 315, 314, 866, 870, 315, 314, 868, 870, 313, 316,
+    869, 871, 315, 314, 868, 872, 870, 872, 873, 871, 871, 871, 871, 873, 870,
+    872, 872, 872, 872, 874, 284, 285, 871, 283, 284, 285, 873, 875, 283, 286,
+    876, 874, 284, 285, 877, 283, 875, 877, 878, 876, 876, 876, 876, 878, 875,
+    877, 877, 877, 877, 879, 215, 214, 876, 880, 215, 214, 878, 880, 213, 216,
+    879, 881, 215, 214, 878, 882, 880, 882, 883, 881, 881, 881, 881, 883, 880,
+    882, 882, 882, 882, 884, 184, 185, 881, 183, 184, 185, 883, 885, 183, 186,
+    886, 884, 184, 185, 887, 183, 885, 887, 888, 886, 886, 886, 886, 888, 885,
+    887, 887, 887, 887, 889, 115, 114, 886, 890, 115, 114, 888, 890, 113, 116,
+    889, 891, 115, 114, 888, 892, 890, 892, 893, 891, 891, 891, 891, 893, 890,
+    892, 892, 892, 892, 894, 84,  85,  891, 83,  84,  85,  893, 895, 83,  86,
+    896, 894, 84,  85,  897, 83,  895, 897, 898, 896, 896, 896, 896, 898, 895,
+    899, 15,  14,  897, 899, 15,  14,  896, 13,  15,  14,  898, 13,  16,  897,
+    9,   10,  901, 8,   11,  902, 900, 902, 9,   10,  8,   903, 901, 903, 900,
+    904, 9,   10,  902, 904, 901, 903, 903, 903, 903, 905, 90,  89,  91,  902,
+    90,  89,  906, 904, 91,  88,  905, 907, 90,  89,  91,  908, 906, 908, 909,
+    907, 907, 907, 907, 909, 906, 908, 908, 908, 908, 910, 109, 110, 108, 907,
+    109, 110, 909, 911, 108, 111, 910, 912, 109, 110, 108, 911, 911, 913, 914,
+    912, 912, 912, 912, 914, 913, 913, 913, 913, 913, 915, 190, 189, 191, 912,
+    190, 189, 916, 914, 191, 188, 915, 917, 190, 189, 191, 918, 916, 918, 919,
+    917, 917, 917, 917, 919, 916, 918, 918, 918, 918, 920, 209, 210, 208, 917,
+    209, 210, 919, 921, 208, 211, 920, 922, 209, 210, 208, 921, 921, 923, 924,
+    922, 922, 922, 922, 924, 923, 923, 923, 923, 923, 925, 290, 289, 291, 922,
+    290, 289, 926, 924, 291, 288, 925, 927, 290, 289, 291, 928, 926, 928, 929,
+    927, 927, 927, 927, 929, 926, 928, 928, 928, 928, 930, 309, 310, 308, 927,
+    309, 310, 929, 931, 308, 311, 930, 932, 309, 310, 308, 931, 931, 933, 934,
+    932, 932, 932, 932, 934, 933, 933, 933, 933, 933, 935, 390, 389, 391, 932,
+    390, 389, 936, 934, 391, 388, 935, 937, 390, 389, 391, 938, 936, 938, 939,
+    937, 937, 937, 937, 939, 936, 938, 938, 938, 938, 940, 409, 410, 408, 937,
+    409, 410, 939, 941, 408, 411, 940, 942, 409, 410, 408, 941, 941, 943, 944,
+    942, 942, 942, 942, 944, 943, 943, 943, 943, 943, 945, 490, 489, 491, 942,
+    490, 489, 946, 944, 491, 488, 945, 947, 490, 489, 491, 948, 946, 948, 949,
+    947, 947, 947, 947, 949, 946, 509, 510, 508, 948, 509, 510, 508, 947, 511,
+    951, 504, 505, 952, 503, 506, 950, 952, 953, 504, 505, 951, 951, 953, 950,
+    952, 952, 952, 952, 954, 494, 495, 951, 493, 494, 495, 953, 955, 493, 496,
+    956, 954, 494, 495, 957, 493, 955, 957, 958, 956, 956, 956, 956, 958, 955,
+    957, 957, 957, 957, 959, 404, 405, 956, 960, 404, 405, 958, 960, 403, 406,
+    959, 961, 404, 405, 958, 962, 960, 962, 963, 961, 961, 961, 961, 963, 960,
+    962, 962, 962, 962, 964, 394, 395, 961, 393, 394, 395, 963, 965, 393, 396,
+    966, 964, 394, 395, 967, 393, 965, 967, 968, 966, 966, 966, 966, 968, 965,
+    967, 967, 967, 967, 969, 304, 305, 966, 970, 304, 305, 968, 970, 303, 306,
+    969, 971, 304, 305, 968, 972, 970, 972, 973, 971, 971, 971, 971, 973, 970,
+    972, 972, 972, 972, 974, 294, 295, 971, 293, 294, 295, 973, 975, 293, 296,
+    976, 974, 294, 295, 977, 293, 975, 977, 978, 976, 976, 976, 976, 978, 975,
+    977, 977, 977, 977, 979, 204, 205, 976, 980, 204, 205, 978, 980, 203, 206,
+    979, 981, 204, 205, 978, 982, 980, 982, 983, 981, 981, 981, 981, 983, 980,
+    982, 982, 982, 982, 984, 194, 195, 981, 193, 194, 195, 983, 985, 193, 196,
+    986, 984, 194, 195, 987, 193, 985, 987, 988, 986, 986, 986, 986, 988, 985,
+    987, 987, 987, 987, 989, 104, 105, 986, 990, 104, 105, 988, 990, 103, 106,
+    989, 991, 104, 105, 988, 992, 990, 992, 993, 991, 991, 991, 991, 993, 990,
+    992, 992, 992, 992, 994, 94,  95,  991, 93,  94,  95,  993, 995, 93,  96,
+    996, 994, 94,  95,  997, 93,  995, 997, 998, 996, 996, 996, 996, 998, 995,
+    999, 4,   5,   997, 999, 4,   5,   996, 3,   4,   5,   998, 3,   6,   997,
+};
+
+constexpr int kNumSegments = 1;
+constexpr std::array<LEDSegment, kNumSegments> kSegments = {{
+    {.first_led = 0, .num_leds = 1000, .pin = 5},
+}};
+
+constexpr LEDWallVariant kVariant = {
+    .name = "actual_wall",
+    .mapping =
+        {
+            .num_leds = kNumLeds,
+            .x = kX.data(),
+            .y = kY.data(),
+            .angle = kAngle.data(),
+            .radius = kRadius.data(),
+            .origin_x = 130,
+            .origin_y = 130,
+            .num_radius_buckets = kNumRadiusBuckets,
+            .unique_radii = kUniqueRadii.data(),
+            .radius_bucket_starts = kRadiusBucketStarts.data(),
+            .radius_bucket_leds = kRadiusBucketLeds.data(),
+            .grid_cell_starts = kGridCellStarts.data(),
+            .grid_cell_leds = kGridCellLeds.data(),
+            .neighbors = kNeighbors.data(),
+        },
+    .segments = {.num_segments = kNumSegments, .segments = kSegments.data()},
+    .chipset = LEDChipset::kWS2811BRG,
+};
+
+}  // namespace actual_wall
+
+// LED Mapper data for the actual 8' wall, flipped.
+namespace actual_wall_flipped {
+
+constexpr int kNumLeds = 1000;
+constexpr int kNumRadiusBuckets = 177;
+
+constexpr std::array<uint8_t, kNumLeds> kX = {
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+    0,   0,   0,   0,   0,   26,  26,  26,  26,  26,  26,  26,  26,  26,  26,
+    26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,
+    26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  26,
+    26,  26,  26,  26,  26,  26,  26,  26,  26,  26,  51,  51,  51,  51,  51,
+    51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,
+    51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,
+    51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,
+    77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,
+    77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,
+    77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,  77,
+    77,  77,  77,  77,  77,  102, 102, 102, 102, 102, 102, 102, 102, 102, 102,
+    102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102,
+    102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 102,
+    102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153,
+    153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153,
+    153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153, 153,
+    153, 153, 153, 153, 153, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179,
+    179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179,
+    179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 179,
+    179, 179, 179, 179, 179, 179, 179, 179, 179, 179, 204, 204, 204, 204, 204,
+    204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204,
+    204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204,
+    204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204,
+    230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230,
+    230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230,
+    230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230, 230,
+    230, 230, 230, 230, 230, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 250, 245, 240, 235, 230,
+    224, 219, 214, 209, 204, 199, 194, 189, 184, 179, 173, 168, 163, 158, 153,
+    148, 143, 138, 133, 128, 122, 117, 112, 107, 102, 97,  92,  87,  82,  77,
+    71,  66,  61,  56,  51,  46,  41,  36,  31,  26,  20,  15,  10,  5,   0,
+    0,   5,   10,  15,  20,  26,  31,  36,  41,  46,  51,  56,  61,  66,  71,
+    77,  82,  87,  92,  97,  102, 107, 112, 117, 122, 128, 133, 138, 143, 148,
+    153, 158, 163, 168, 173, 179, 184, 189, 194, 199, 204, 209, 214, 219, 224,
+    230, 235, 240, 245, 250, 250, 245, 240, 235, 230, 224, 219, 214, 209, 204,
+    199, 194, 189, 184, 179, 173, 168, 163, 158, 153, 148, 143, 138, 133, 128,
+    122, 117, 112, 107, 102, 97,  92,  87,  82,  77,  71,  66,  61,  56,  51,
+    46,  41,  36,  31,  26,  20,  15,  10,  5,   0,   0,   5,   10,  15,  20,
+    26,  31,  36,  41,  46,  51,  56,  61,  66,  71,  77,  82,  87,  92,  97,
+    102, 107, 112, 117, 122, 128, 133, 138, 143, 148, 153, 158, 163, 168, 173,
+    179, 184, 189, 194, 199, 204, 209, 214, 219, 224, 230, 235, 240, 245, 250,
+    250, 245, 240, 235, 230, 224, 219, 214, 209, 204, 199, 194, 189, 184, 179,
+    173, 168, 163, 158, 153, 148, 143, 138, 133, 128, 122, 117, 112, 107, 102,
+    97,  92,  87,  82,  77,  71,  66,  61,  56,  51,  46,  41,  36,  31,  26,
+    20,  15,  10,  5,   0,   0,   5,   10,  15,  20,  26,  31,  36,  41,  46,
+    51,  56,  61,  66,  71,  77,  82,  87,  92,  97,  102, 107, 112, 117, 122,
+    128, 133, 138, 143, 148, 153, 158, 163, 168, 173, 179, 184, 189, 194, 199,
+    204, 209, 214, 219, 224, 230, 235, 240, 245, 250, 250, 245, 240, 235, 230,
+    224, 219, 214, 209, 204, 199, 194, 189, 184, 179, 173, 168, 163, 158, 153,
+    148, 143, 138, 133, 128, 122, 117, 112, 107, 102, 97,  92,  87,  82,  77,
+    71,  66,  61,  56,  51,  46,  41,  36,  31,  26,  20,  15,  10,  5,   0,
+    0,   5,   10,  15,  20,  26,  31,  36,  41,  46,  51,  56,  61,  66,  71,
+    77,  82,  87,  92,  97,  102, 107, 112, 117, 122, 128, 133, 138, 143, 148,
+    153, 158, 163, 168, 173, 179, 184, 189, 194, 199, 204, 209, 214, 219, 224,
+    230, 235, 240, 245, 250, 250, 245, 240, 235, 230, 224, 219, 214, 209, 204,
+    199, 194, 189, 184, 179, 173, 168, 163, 158, 153, 148, 143, 138, 133, 128,
+    122, 117, 112, 107, 102, 97,  92,  87,  82,  77,  71,  66,  61,  56,  51,
+    46,  41,  36,  31,  26,  20,  15,  10,  5,   0,
+};
+
+constexpr std::array<uint8_t, kNumLeds> kY = {
+    255, 251, 246, 242, 237, 229, 224, 220, 215, 211, 202, 198, 193, 189, 185,
+    176, 171, 167, 163, 158, 149, 145, 141, 136, 132, 123, 119, 114, 110, 106,
+    97,  92,  88,  84,  79,  70,  66,  62,  57,  53,  44,  40,  35,  31,  26,
+    18,  13,  9,   4,   0,   0,   4,   9,   13,  18,  26,  31,  35,  40,  44,
+    53,  57,  62,  66,  70,  79,  84,  88,  92,  97,  106, 110, 114, 119, 123,
+    132, 136, 141, 145, 149, 158, 163, 167, 171, 176, 185, 189, 193, 198, 202,
+    211, 215, 220, 224, 229, 237, 242, 246, 251, 255, 255, 251, 246, 242, 237,
+    229, 224, 220, 215, 211, 202, 198, 193, 189, 185, 176, 171, 167, 163, 158,
+    149, 145, 141, 136, 132, 123, 119, 114, 110, 106, 97,  92,  88,  84,  79,
+    70,  66,  62,  57,  53,  44,  40,  35,  31,  26,  18,  13,  9,   4,   0,
+    0,   4,   9,   13,  18,  26,  31,  35,  40,  44,  53,  57,  62,  66,  70,
+    79,  84,  88,  92,  97,  106, 110, 114, 119, 123, 132, 136, 141, 145, 149,
+    158, 163, 167, 171, 176, 185, 189, 193, 198, 202, 211, 215, 220, 224, 229,
+    237, 242, 246, 251, 255, 255, 251, 246, 242, 237, 229, 224, 220, 215, 211,
+    202, 198, 193, 189, 185, 176, 171, 167, 163, 158, 149, 145, 141, 136, 132,
+    123, 119, 114, 110, 106, 97,  92,  88,  84,  79,  70,  66,  62,  57,  53,
+    44,  40,  35,  31,  26,  18,  13,  9,   4,   0,   0,   4,   9,   13,  18,
+    26,  31,  35,  40,  44,  53,  57,  62,  66,  70,  79,  84,  88,  92,  97,
+    106, 110, 114, 119, 123, 132, 136, 141, 145, 149, 158, 163, 167, 171, 176,
+    185, 189, 193, 198, 202, 211, 215, 220, 224, 229, 237, 242, 246, 251, 255,
+    255, 251, 246, 242, 237, 229, 224, 220, 215, 211, 202, 198, 193, 189, 185,
+    176, 171, 167, 163, 158, 149, 145, 141, 136, 132, 123, 119, 114, 110, 106,
+    97,  92,  88,  84,  79,  70,  66,  62,  57,  53,  44,  40,  35,  31,  26,
+    18,  13,  9,   4,   0,   0,   4,   9,   13,  18,  26,  31,  35,  40,  44,
+    53,  57,  62,  66,  70,  79,  84,  88,  92,  97,  106, 110, 114, 119, 123,
+    132, 136, 141, 145, 149, 158, 163, 167, 171, 176, 185, 189, 193, 198, 202,
+    211, 215, 220, 224, 229, 237, 242, 246, 251, 255, 255, 251, 246, 242, 237,
+    229, 224, 220, 215, 211, 202, 198, 193, 189, 185, 176, 171, 167, 163, 158,
+    149, 145, 141, 136, 132, 123, 119, 114, 110, 106, 97,  92,  88,  84,  79,
+    70,  66,  62,  57,  53,  44,  40,  35,  31,  26,  18,  13,  9,   4,   0,
+    0,   4,   9,   13,  18,  26,  31,  35,  40,  44,  53,  57,  62,  66,  70,
+    79,  84,  88,  92,  97,  106, 110, 114, 119, 123, 132, 136, 141, 145, 149,
+    158, 163, 167, 171, 176, 185, 189, 193, 198, 202, 211, 215, 220, 224, 229,
+    237, 242, 246, 251, 255, 255, 251, 246, 242, 237, 229, 224, 220, 215, 211,
+    202, 198, 193, 189, 185, 176, 171, 167, 163, 158, 149, 145, 141, 136, 132,
+    123, 119, 114, 110, 106, 97,  92,  88,  84,  79,  70,  66,  62,  57,  53,
+    44,  40,  35,  31,  26,  18,  13,  9,   4,   0,   22,  22,  22,  22,  22,
+    22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,
+    22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,
+    22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,  22,
+    48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,
+    48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,
+    48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,  48,
+    48,  48,  48,  48,  48,  75,  75,  75,  75,  75,  75,  75,  75,  75,  75,
+    75,  75,  75,  75,  75,  75,  75,  75,  75,  75,  75,  75,  75,  75,  75,
+    75,  75,  75,  75,  75,  75,  75,  75,  75,  75,  75,  75,  75,  75,  75,
+    75,  75,  75,  75,  75,  75,  75,  75,  75,  75,  101, 101, 101, 101, 101,
+    101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101,
+    101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101,
+    101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101, 101,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128, 128,
+    128, 128, 128, 128, 128, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154,
+    154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154,
+    154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 154,
+    154, 154, 154, 154, 154, 154, 154, 154, 154, 154, 180, 180, 180, 180, 180,
+    180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180,
+    180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180,
+    180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180, 180,
+    207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207,
+    207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207,
+    207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207, 207,
+    207, 207, 207, 207, 207, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233,
+    233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233,
+    233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233, 233,
+    233, 233, 233, 233, 233, 233, 233, 233, 233, 233,
+};
 
-#endif  // FLIP_WALL
-#else
+constexpr std::array<uint8_t, kNumLeds> kAngle = {
+    221, 222, 222, 223, 224, 226, 227, 228, 229, 230, 232, 233, 234, 235, 237,
+    239, 241, 242, 243, 245, 248, 249, 251, 253, 254, 2,   4,   6,   7,   9,
+    12,  13,  14,  16,  17,  20,  21,  22,  23,  24,  26,  27,  28,  29,  30,
+    32,  33,  33,  34,  35,  39,  38,  38,  37,  36,  35,  34,  33,  32,  31,
+    29,  28,  26,  25,  24,  21,  19,  18,  16,  14,  11,  9,   7,   5,   3,
+    254, 252, 250, 248, 246, 243, 241, 239, 237, 236, 233, 231, 230, 229, 227,
+    225, 224, 223, 222, 221, 220, 219, 218, 217, 217, 211, 212, 213, 213, 214,
+    216, 217, 218, 219, 220, 222, 223, 224, 226, 227, 231, 233, 235, 237, 239,
+    244, 246, 249, 251, 254, 4,   6,   9,   11,  14,  18,  20,  22,  24,  26,
+    29,  31,  32,  33,  34,  36,  37,  38,  39,  40,  42,  42,  43,  44,  44,
+    50,  49,  49,  48,  48,  47,  46,  45,  45,  44,  42,  41,  40,  38,  37,
+    34,  32,  30,  28,  25,  20,  16,  13,  9,   6,   253, 249, 246, 242, 239,
+    233, 230, 227, 225, 223, 220, 218, 217, 215, 214, 212, 211, 210, 210, 209,
+    208, 207, 207, 206, 206, 199, 199, 200, 200, 200, 201, 201, 202, 202, 203,
+    204, 205, 206, 207, 208, 211, 213, 215, 217, 220, 227, 232, 238, 244, 251,
+    11,  17,  23,  28,  32,  38,  40,  42,  44,  46,  48,  49,  50,  51,  51,
+    53,  53,  54,  54,  54,  55,  55,  56,  56,  56,  63,  63,  63,  63,  63,
+    63,  63,  63,  63,  63,  63,  63,  62,  62,  62,  62,  62,  62,  61,  61,
+    60,  59,  58,  56,  51,  223, 204, 199, 197, 196, 194, 194, 194, 193, 193,
+    193, 193, 193, 193, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192, 192,
+    185, 185, 184, 184, 184, 183, 183, 182, 182, 182, 180, 180, 179, 178, 177,
+    175, 173, 171, 169, 167, 159, 154, 148, 141, 132, 114, 107, 101, 96,  92,
+    86,  84,  82,  80,  79,  77,  76,  75,  75,  74,  73,  73,  72,  72,  71,
+    71,  71,  70,  70,  70,  76,  77,  77,  78,  78,  79,  80,  81,  81,  82,
+    84,  85,  86,  87,  89,  92,  94,  96,  98,  100, 106, 110, 113, 117, 121,
+    130, 134, 138, 142, 145, 152, 155, 157, 159, 161, 165, 166, 168, 169, 170,
+    172, 173, 174, 174, 175, 176, 177, 177, 178, 178, 172, 172, 171, 170, 170,
+    168, 167, 166, 165, 164, 162, 161, 159, 158, 156, 153, 151, 149, 147, 145,
+    140, 137, 134, 132, 129, 123, 121, 118, 115, 113, 108, 106, 104, 102, 100,
+    97,  96,  94,  93,  92,  90,  89,  88,  87,  86,  85,  84,  83,  83,  82,
+    87,  88,  89,  89,  90,  92,  93,  94,  95,  96,  98,  99,  100, 102, 103,
+    106, 107, 109, 111, 113, 116, 118, 120, 122, 124, 129, 131, 133, 135, 137,
+    141, 142, 144, 146, 148, 151, 152, 153, 155, 156, 158, 159, 160, 161, 162,
+    164, 165, 166, 166, 167, 162, 162, 161, 160, 159, 158, 157, 156, 155, 154,
+    152, 150, 149, 148, 147, 144, 143, 141, 140, 138, 135, 133, 132, 130, 128,
+    125, 123, 122, 120, 119, 115, 114, 112, 111, 110, 107, 106, 105, 103, 102,
+    100, 99,  98,  97,  96,  95,  94,  93,  93,  92,  95,  94,  93,  92,  91,
+    90,  89,  88,  87,  85,  84,  83,  82,  80,  79,  77,  76,  74,  73,  71,
+    70,  68,  66,  65,  63,  61,  60,  58,  56,  55,  53,  52,  50,  49,  47,
+    46,  45,  43,  42,  41,  40,  39,  38,  36,  35,  35,  34,  33,  32,  31,
+    25,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35,  37,  38,  40,  41,
+    43,  44,  46,  48,  50,  52,  54,  56,  58,  60,  63,  65,  67,  69,  71,
+    73,  75,  77,  79,  81,  83,  85,  86,  88,  89,  91,  92,  93,  94,  96,
+    97,  98,  99,  100, 100, 108, 107, 106, 105, 104, 103, 102, 101, 100, 99,
+    97,  96,  94,  92,  90,  88,  86,  83,  81,  78,  75,  72,  69,  65,  62,
+    59,  56,  53,  50,  47,  44,  42,  40,  37,  35,  34,  32,  30,  29,  28,
+    26,  25,  24,  23,  22,  21,  21,  20,  19,  18,  10,  11,  11,  11,  12,
+    12,  13,  14,  14,  15,  16,  17,  18,  19,  21,  22,  24,  26,  29,  32,
+    35,  39,  44,  49,  55,  61,  67,  73,  79,  84,  88,  92,  96,  99,  101,
+    103, 105, 107, 108, 109, 110, 111, 112, 113, 114, 114, 115, 116, 116, 117,
+    127, 127, 127, 127, 126, 126, 126, 126, 126, 126, 126, 126, 126, 126, 125,
+    125, 125, 124, 124, 123, 122, 119, 114, 96,  32,  13,  8,   6,   4,   4,
+    3,   3,   2,   2,   2,   2,   2,   2,   1,   1,   1,   1,   1,   1,   1,
+    1,   1,   1,   1,   1,   246, 246, 246, 245, 245, 244, 244, 243, 243, 242,
+    241, 240, 239, 238, 237, 235, 234, 232, 229, 226, 223, 219, 214, 209, 202,
+    195, 188, 180, 174, 168, 163, 159, 156, 153, 151, 149, 147, 146, 144, 143,
+    142, 141, 141, 140, 139, 139, 138, 138, 137, 137, 146, 147, 147, 148, 149,
+    150, 151, 152, 153, 155, 156, 158, 159, 161, 163, 165, 168, 170, 173, 176,
+    179, 183, 186, 189, 193, 197, 200, 203, 206, 209, 212, 215, 217, 219, 221,
+    223, 225, 226, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 237, 238,
+    231, 230, 229, 228, 227, 226, 225, 224, 223, 222, 221, 219, 218, 216, 215,
+    213, 211, 210, 208, 206, 204, 201, 199, 197, 195, 192, 190, 188, 185, 183,
+    181, 179, 177, 175, 173, 171, 169, 168, 166, 165, 163, 162, 161, 159, 158,
+    157, 156, 155, 154, 153, 159, 160, 161, 162, 163, 164, 165, 166, 168, 169,
+    170, 171, 173, 174, 176, 177, 179, 180, 182, 184, 185, 187, 189, 190, 192,
+    194, 196, 197, 199, 201, 202, 204, 205, 207, 208, 210, 211, 212, 214, 215,
+    216, 217, 218, 219, 220, 221, 222, 223, 224, 225,
+};
+
+constexpr std::array<uint8_t, kNumLeds> kRadius = {
+    250, 245, 241, 236, 231, 222, 218, 214, 210, 206, 199, 195, 192, 189, 186,
+    180, 178, 176, 174, 172, 169, 168, 168, 167, 167, 167, 168, 168, 169, 171,
+    174, 176, 178, 180, 183, 189, 192, 195, 199, 202, 210, 214, 218, 222, 227,
+    236, 241, 245, 250, 255, 235, 230, 224, 219, 214, 204, 199, 194, 190, 185,
+    176, 172, 168, 164, 161, 154, 151, 148, 145, 143, 139, 137, 136, 135, 134,
+    134, 134, 135, 136, 137, 141, 143, 145, 148, 151, 157, 161, 164, 168, 172,
+    181, 185, 190, 194, 199, 209, 214, 219, 224, 230, 212, 206, 201, 195, 190,
+    179, 173, 168, 163, 158, 148, 143, 139, 134, 130, 122, 119, 116, 113, 110,
+    106, 104, 103, 102, 101, 102, 103, 104, 106, 108, 113, 116, 119, 122, 126,
+    134, 139, 143, 148, 153, 163, 168, 173, 179, 184, 195, 201, 206, 212, 218,
+    205, 199, 193, 186, 180, 168, 162, 156, 151, 145, 133, 128, 122, 117, 112,
+    102, 97,  93,  88,  84,  78,  75,  72,  71,  69,  69,  69,  71,  72,  75,
+    81,  84,  88,  93,  97,  107, 112, 117, 122, 128, 139, 145, 151, 156, 162,
+    174, 180, 186, 193, 199, 190, 183, 177, 171, 164, 151, 145, 139, 132, 126,
+    114, 108, 101, 95,  89,  78,  72,  66,  61,  56,  46,  43,  40,  37,  36,
+    37,  40,  43,  46,  51,  61,  66,  72,  78,  83,  95,  101, 108, 114, 120,
+    132, 139, 145, 151, 158, 171, 177, 183, 190, 196, 193, 186, 180, 173, 167,
+    154, 147, 141, 134, 128, 114, 108, 101, 95,  88,  75,  69,  62,  56,  49,
+    36,  30,  23,  17,  10,  5,   10,  17,  23,  30,  43,  49,  56,  62,  69,
+    82,  88,  95,  101, 108, 121, 128, 134, 141, 147, 160, 167, 173, 180, 186,
+    189, 182, 176, 169, 163, 150, 144, 137, 131, 125, 112, 106, 99,  93,  87,
+    75,  69,  63,  57,  52,  42,  37,  34,  31,  30,  31,  34,  37,  42,  46,
+    57,  63,  69,  75,  81,  93,  99,  106, 112, 118, 131, 137, 144, 150, 156,
+    169, 176, 182, 189, 195, 203, 196, 190, 184, 178, 166, 160, 154, 148, 142,
+    130, 125, 119, 113, 108, 98,  93,  88,  83,  79,  72,  69,  66,  64,  63,
+    62,  63,  64,  66,  69,  75,  79,  83,  88,  93,  103, 108, 113, 119, 125,
+    136, 142, 148, 154, 160, 172, 178, 184, 190, 196, 209, 203, 198, 192, 186,
+    175, 170, 164, 159, 154, 144, 139, 134, 130, 125, 117, 113, 110, 107, 104,
+    99,  98,  96,  95,  95,  95,  96,  98,  99,  101, 107, 110, 113, 117, 121,
+    130, 134, 139, 144, 149, 159, 164, 170, 175, 181, 192, 198, 203, 209, 215,
+    231, 226, 220, 215, 210, 200, 195, 190, 185, 180, 171, 167, 163, 159, 155,
+    148, 145, 142, 139, 137, 132, 131, 130, 129, 128, 128, 128, 129, 130, 131,
+    134, 137, 139, 142, 145, 151, 155, 159, 163, 167, 176, 180, 185, 190, 195,
+    205, 210, 215, 220, 226, 246, 241, 236, 231, 227, 218, 213, 209, 205, 201,
+    193, 190, 186, 183, 180, 174, 172, 170, 168, 166, 163, 162, 161, 161, 160,
+    161, 161, 162, 163, 164, 168, 170, 172, 174, 177, 183, 186, 190, 193, 197,
+    205, 209, 213, 218, 222, 231, 236, 241, 246, 251, 222, 218, 213, 209, 205,
+    201, 197, 193, 190, 186, 183, 180, 177, 174, 172, 170, 168, 166, 164, 163,
+    162, 161, 161, 160, 160, 161, 161, 162, 163, 164, 166, 168, 170, 172, 174,
+    177, 180, 183, 186, 190, 193, 197, 201, 205, 209, 213, 218, 222, 227, 231,
+    206, 201, 196, 190, 185, 181, 176, 171, 167, 162, 158, 154, 150, 146, 142,
+    139, 136, 133, 131, 128, 126, 125, 123, 122, 121, 121, 121, 121, 122, 123,
+    125, 126, 128, 131, 133, 136, 139, 142, 146, 150, 154, 158, 162, 167, 171,
+    176, 181, 185, 190, 196, 174, 168, 163, 157, 151, 146, 141, 135, 130, 125,
+    120, 116, 111, 107, 103, 99,  95,  92,  89,  87,  85,  83,  82,  82,  82,
+    82,  83,  85,  87,  89,  92,  95,  99,  103, 107, 111, 116, 120, 125, 130,
+    135, 141, 146, 151, 157, 163, 168, 174, 180, 186, 172, 166, 159, 153, 147,
+    141, 134, 128, 122, 116, 110, 104, 98,  92,  86,  81,  75,  70,  65,  60,
+    56,  52,  48,  46,  44,  43,  43,  44,  46,  48,  52,  56,  60,  65,  70,
+    75,  81,  86,  92,  98,  104, 110, 116, 122, 128, 134, 141, 147, 153, 159,
+    154, 147, 141, 134, 128, 121, 114, 108, 101, 95,  88,  82,  75,  69,  62,
+    56,  49,  43,  36,  30,  23,  17,  10,  5,   5,   10,  17,  23,  30,  36,
+    43,  49,  56,  62,  69,  75,  82,  88,  95,  101, 108, 114, 121, 128, 134,
+    141, 147, 154, 160, 167, 171, 164, 158, 151, 145, 139, 132, 126, 120, 114,
+    108, 101, 95,  89,  83,  78,  72,  66,  61,  56,  51,  46,  43,  40,  37,
+    36,  36,  37,  40,  43,  46,  51,  56,  61,  66,  72,  78,  83,  89,  95,
+    101, 108, 114, 120, 126, 132, 139, 145, 151, 158, 171, 165, 159, 154, 148,
+    142, 137, 132, 126, 121, 116, 111, 106, 102, 98,  94,  90,  86,  83,  81,
+    79,  77,  76,  75,  75,  76,  77,  79,  81,  83,  86,  90,  94,  98,  102,
+    106, 111, 116, 121, 126, 132, 137, 142, 148, 154, 159, 165, 171, 177, 183,
+    202, 197, 192, 186, 181, 176, 171, 167, 162, 157, 153, 149, 145, 141, 137,
+    133, 130, 127, 125, 122, 120, 118, 117, 116, 115, 114, 114, 115, 116, 117,
+    118, 120, 122, 125, 127, 130, 133, 137, 141, 145, 149, 153, 157, 162, 167,
+    171, 176, 181, 186, 192, 217, 213, 208, 204, 200, 196, 192, 188, 184, 181,
+    177, 174, 171, 168, 166, 163, 161, 159, 158, 156, 155, 155, 154, 154, 154,
+    154, 155, 155, 156, 158, 159, 161, 163, 166, 168, 171, 174, 177, 181, 184,
+    188, 192, 196, 200, 204, 208, 213, 217, 222, 227,
+};
+
+constexpr std::array<uint8_t, kNumRadiusBuckets> kUniqueRadii = {
+    5,   10,  17,  23,  30,  31,  34,  36,  37,  40,  42,  43,  44,  46,  48,
+    49,  51,  52,  56,  57,  60,  61,  62,  63,  64,  65,  66,  69,  70,  71,
+    72,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  86,  87,  88,  89,
+    90,  92,  93,  94,  95,  96,  97,  98,  99,  101, 102, 103, 104, 106, 107,
+    108, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119, 120, 121, 122, 123,
+    125, 126, 127, 128, 129, 130, 131, 132, 133, 134, 135, 136, 137, 139, 141,
+    142, 143, 144, 145, 146, 147, 148, 149, 150, 151, 153, 154, 155, 156, 157,
+    158, 159, 160, 161, 162, 163, 164, 165, 166, 167, 168, 169, 170, 171, 172,
+    173, 174, 175, 176, 177, 178, 179, 180, 181, 182, 183, 184, 185, 186, 188,
+    189, 190, 192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 202, 203, 204,
+    205, 206, 208, 209, 210, 212, 213, 214, 215, 217, 218, 219, 220, 222, 224,
+    226, 227, 230, 231, 235, 236, 241, 245, 246, 250, 251, 255,
+};
+
+constexpr std::array<uint16_t, kNumRadiusBuckets + 1> kRadiusBucketStarts = {
+    0,    3,    7,    11,   15,   20,   22,   24,   30,   36,   40,   42,
+    51,   53,   60,   62,   66,   69,   72,   81,   83,   85,   89,   94,
+    98,   100,  102,  108,  119,  121,  123,  130,  142,  144,  146,  151,
+    155,  161,  168,  177,  179,  181,  185,  188,  196,  201,  203,  207,
+    213,  215,  228,  230,  232,  239,  245,  255,  260,  265,  270,  276,
+    281,  292,  297,  301,  305,  311,  320,  322,  332,  338,  341,  345,
+    352,  362,  372,  374,  384,  392,  394,  407,  409,  419,  425,  432,
+    437,  451,  455,  460,  470,  484,  495,  503,  507,  511,  523,  527,
+    533,  542,  545,  549,  560,  565,  580,  586,  591,  596,  604,  614,
+    621,  633,  643,  656,  665,  667,  674,  686,  703,  707,  713,  726,
+    735,  739,  750,  752,  762,  770,  774,  776,  788,  796,  798,  806,
+    811,  817,  830,  832,  836,  851,  859,  866,  868,  875,  882,  886,
+    888,  894,  897,  903,  905,  908,  911,  917,  921,  923,  930,  934,
+    936,  942,  946,  949,  951,  958,  960,  962,  968,  970,  972,  976,
+    978,  983,  984,  988,  992,  994,  996,  998,  999,  1000,
+};
+
+constexpr std::array<uint16_t, kNumLeds> kRadiusBucketLeds = {
+    275, 773, 774, 274, 276, 772, 775, 273, 277, 771, 776, 272, 278, 770, 777,
+    271, 279, 324, 769, 778, 323, 325, 322, 326, 224, 270, 768, 779, 825, 826,
+    223, 225, 321, 327, 824, 827, 222, 226, 823, 828, 320, 328, 221, 227, 280,
+    725, 726, 767, 780, 822, 829, 724, 727, 220, 228, 329, 723, 728, 821, 830,
+    722, 729, 269, 281, 766, 781, 229, 820, 831, 319, 721, 730, 219, 268, 282,
+    720, 731, 765, 782, 819, 832, 318, 330, 719, 732, 218, 230, 818, 833, 267,
+    283, 375, 764, 783, 317, 331, 374, 376, 373, 377, 718, 733, 217, 231, 372,
+    378, 817, 834, 174, 175, 176, 266, 284, 316, 332, 371, 379, 763, 784, 717,
+    734, 173, 177, 172, 178, 216, 232, 370, 816, 835, 171, 179, 265, 315, 333,
+    380, 716, 735, 762, 785, 873, 874, 872, 875, 871, 876, 170, 215, 233, 815,
+    836, 369, 381, 870, 877, 180, 334, 715, 736, 869, 878, 285, 672, 673, 674,
+    675, 761, 786, 234, 368, 382, 671, 676, 814, 837, 868, 879, 169, 181, 670,
+    677, 714, 737, 867, 880, 314, 669, 678, 168, 182, 264, 286, 367, 383, 760,
+    787, 214, 668, 679, 813, 838, 866, 881, 667, 680, 713, 738, 167, 183, 313,
+    335, 366, 384, 865, 882, 213, 235, 263, 287, 423, 424, 425, 666, 681, 759,
+    788, 812, 839, 422, 426, 166, 184, 365, 421, 427, 712, 739, 864, 883, 312,
+    336, 420, 428, 665, 682, 124, 212, 236, 262, 288, 429, 758, 789, 811, 840,
+    123, 125, 165, 863, 884, 122, 126, 385, 664, 683, 121, 127, 419, 711, 740,
+    120, 128, 311, 337, 862, 885, 185, 418, 430, 663, 684, 129, 211, 237, 261,
+    289, 364, 386, 757, 790, 810, 841, 119, 417, 431, 710, 741, 662, 685, 861,
+    886, 164, 186, 310, 338, 118, 130, 363, 387, 416, 432, 210, 238, 260, 756,
+    791, 809, 842, 925, 926, 924, 927, 117, 131, 661, 686, 709, 742, 860, 887,
+    923, 928, 163, 187, 415, 433, 922, 929, 339, 921, 930, 116, 132, 362, 388,
+    239, 660, 687, 808, 843, 920, 931, 290, 434, 624, 625, 626, 627, 755, 792,
+    859, 888, 115, 133, 162, 188, 623, 628, 708, 743, 919, 932, 622, 629, 309,
+    361, 389, 414, 621, 630, 659, 688, 918, 933, 134, 209, 620, 631, 807, 844,
+    858, 889, 917, 934, 161, 189, 259, 291, 474, 475, 476, 619, 632, 707, 744,
+    754, 793, 473, 477, 114, 360, 413, 435, 472, 478, 658, 689, 916, 935, 308,
+    340, 471, 479, 618, 633, 208, 240, 470, 806, 845, 857, 890, 160, 617, 634,
+    915, 936, 74,  75,  76,  113, 135, 258, 292, 412, 436, 480, 706, 745, 753,
+    794, 73,  77,  657, 690, 72,  78,  390, 616, 635, 71,  79,  307, 341, 469,
+    481, 856, 891, 914, 937, 70,  112, 136, 190, 207, 241, 411, 437, 468, 482,
+    615, 636, 805, 846, 80,  257, 293, 656, 691, 705, 746, 752, 795, 913, 938,
+    359, 391, 467, 483, 614, 637, 855, 892, 69,  81,  111, 137, 306, 342, 410,
+    438, 68,  82,  159, 191, 206, 242, 466, 484, 804, 847, 912, 939, 613, 638,
+    655, 692, 256, 294, 704, 747, 751, 796, 67,  83,  110, 138, 358, 392, 465,
+    854, 893, 439, 911, 940, 305, 343, 612, 639, 66,  84,  158, 192, 205, 243,
+    485, 654, 693, 803, 848, 139, 703, 748, 910, 941, 65,  255, 357, 393, 409,
+    611, 640, 750, 797, 853, 894, 972, 973, 974, 975, 464, 486, 970, 971, 976,
+    977, 157, 193, 344, 969, 978, 85,  653, 694, 909, 942, 109, 244, 610, 641,
+    802, 849, 968, 979, 408, 440, 463, 487, 702, 749, 852, 895, 967, 980, 295,
+    356, 394, 524, 573, 574, 798, 64,  86,  522, 523, 525, 526, 571, 572, 575,
+    576, 966, 981, 156, 194, 521, 527, 570, 577, 609, 642, 908, 943, 108, 140,
+    304, 462, 488, 520, 528, 569, 578, 652, 695, 965, 982, 63,  87,  204, 407,
+    441, 529, 568, 579, 801, 851, 896, 355, 519, 567, 580, 701, 964, 983, 23,
+    24,  25,  254, 296, 461, 489, 608, 643, 799, 907, 944, 21,  22,  26,  27,
+    62,  88,  107, 141, 155, 518, 530, 566, 581, 651, 696, 963, 984, 20,  28,
+    303, 345, 406, 442, 517, 531, 565, 582, 29,  203, 245, 460, 607, 644, 800,
+    850, 897, 906, 945, 962, 985, 19,  61,  89,  395, 516, 532, 564, 583, 700,
+    106, 142, 253, 297, 18,  30,  195, 515, 533, 563, 584, 650, 697, 961, 986,
+    405, 443, 17,  31,  60,  302, 346, 490, 606, 645, 905, 946, 202, 246, 534,
+    562, 585, 898, 960, 987, 16,  32,  354, 396, 105, 143, 15,  33,  154, 196,
+    252, 298, 459, 491, 514, 561, 586, 698, 90,  444, 605, 646, 904, 947, 959,
+    988, 301, 347, 34,  201, 247, 513, 535, 560, 587, 899, 144, 353, 397, 958,
+    989, 59,  91,  458, 492, 604, 647, 14,  153, 197, 251, 299, 404, 512, 536,
+    559, 588, 699, 903, 948, 957, 990, 13,  35,  300, 348, 58,  92,  104, 200,
+    248, 352, 398, 457, 493, 511, 537, 558, 589, 603, 648, 12,  36,  403, 445,
+    902, 949, 956, 991, 152, 198, 250, 510, 538, 557, 590, 57,  93,  11,  37,
+    103, 145, 349, 456, 494, 249, 351, 399, 602, 649, 955, 992, 539, 556, 591,
+    901, 402, 446, 10,  38,  56,  94,  151, 199, 455, 954, 993, 102, 146, 509,
+    555, 592, 601, 39,  900, 350, 401, 447, 55,  953, 994, 150, 495, 508, 540,
+    554, 593, 9,   101, 147, 600, 952, 995, 95,  400, 448, 507, 541, 553, 594,
+    8,   40,  454, 496, 100, 148, 506, 542, 552, 595, 951, 996, 7,   41,  54,
+    96,  449, 453, 497, 950, 997, 6,   42,  149, 505, 543, 551, 596, 53,  97,
+    452, 498, 5,   43,  544, 550, 597, 998, 52,  98,  451, 499, 44,  504, 598,
+    999, 51,  99,  4,   450, 503, 545, 599, 50,  3,   45,  502, 546, 2,   46,
+    501, 547, 1,   47,  500, 548, 0,   48,  549, 49,
+};
+
+constexpr std::array<uint16_t, LEDMapping::kNumGridCells + 1>
+    kGridCellStarts = {
+    0,    4,    8,    8,    12,   16,   16,   20,   20,   24,   28,   28,
+    32,   36,   36,   40,   44,   51,   57,   60,   66,   72,   75,   81,
+    84,   91,   97,   100,  106,  112,  115,  121,  127,  130,  133,  133,
+    136,  139,  139,  142,  142,  145,  148,  148,  151,  154,  154,  157,
+    160,  167,  173,  176,  182,  188,  191,  197,  200,  207,  213,  216,
+    222,  228,  231,  237,  243,  250,  256,  259,  265,  271,  274,  280,
+    283,  290,  296,  299,  305,  311,  314,  320,  326,  329,  332,  332,
+    335,  338,  338,  341,  341,  344,  347,  347,  350,  353,  353,  356,
+    359,  366,  372,  375,  381,  387,  390,  396,  399,  406,  412,  415,
+    421,  427,  430,  436,  442,  445,  448,  448,  451,  454,  454,  457,
+    457,  460,  463,  463,  466,  469,  469,  472,  475,  482,  488,  491,
+    497,  503,  506,  512,  515,  522,  528,  531,  537,  543,  546,  552,
+    558,  565,  571,  574,  580,  586,  589,  595,  598,  605,  611,  614,
+    620,  626,  629,  635,  641,  644,  647,  647,  650,  653,  653,  656,
+    656,  659,  662,  662,  665,  668,  668,  671,  674,  681,  687,  690,
+    696,  702,  705,  711,  714,  721,  727,  730,  736,  742,  745,  751,
+    757,  764,  770,  773,  779,  785,  788,  794,  797,  804,  810,  813,
+    819,  825,  828,  834,  840,  843,  846,  846,  849,  852,  852,  855,
+    855,  858,  861,  861,  864,  867,  867,  870,  873,  880,  886,  889,
+    895,  901,  904,  910,  913,  920,  926,  929,  935,  941,  944,  950,
+    956,  960,  964,  964,  968,  972,  972,  976,  976,  980,  984,  984,
+    988,  992,  992,  996,  1000,
+};
+
+constexpr std::array<uint16_t, kNumLeds> kGridCellLeds = {
+    46,  47,  48,  49,  50,  51,  52,  53,  146, 147, 148, 149, 150, 151, 152,
+    153, 246, 247, 248, 249, 250, 251, 252, 253, 346, 347, 348, 349, 350, 351,
+    352, 353, 446, 447, 448, 449, 450, 451, 452, 453, 546, 547, 548, 549, 43,
+    44,  45,  596, 597, 598, 599, 54,  55,  56,  593, 594, 595, 590, 591, 592,
+    143, 144, 145, 587, 588, 589, 154, 155, 156, 584, 585, 586, 581, 582, 583,
+    243, 244, 245, 578, 579, 580, 575, 576, 577, 254, 255, 256, 571, 572, 573,
+    574, 343, 344, 345, 568, 569, 570, 565, 566, 567, 354, 355, 356, 562, 563,
+    564, 443, 444, 445, 559, 560, 561, 556, 557, 558, 454, 455, 456, 553, 554,
+    555, 543, 544, 545, 550, 551, 552, 40,  41,  42,  57,  58,  59,  140, 141,
+    142, 157, 158, 159, 240, 241, 242, 257, 258, 259, 340, 341, 342, 357, 358,
+    359, 440, 441, 442, 457, 458, 459, 540, 541, 542, 37,  38,  39,  600, 601,
+    602, 603, 60,  61,  62,  604, 605, 606, 607, 608, 609, 137, 138, 139, 610,
+    611, 612, 160, 161, 162, 613, 614, 615, 616, 617, 618, 237, 238, 239, 619,
+    620, 621, 622, 623, 624, 260, 261, 262, 625, 626, 627, 628, 337, 338, 339,
+    629, 630, 631, 632, 633, 634, 360, 361, 362, 635, 636, 637, 437, 438, 439,
+    638, 639, 640, 641, 642, 643, 460, 461, 462, 644, 645, 646, 537, 538, 539,
+    647, 648, 649, 34,  35,  36,  696, 697, 698, 699, 63,  64,  65,  693, 694,
+    695, 690, 691, 692, 134, 135, 136, 687, 688, 689, 163, 164, 165, 684, 685,
+    686, 681, 682, 683, 234, 235, 236, 678, 679, 680, 675, 676, 677, 263, 264,
+    265, 671, 672, 673, 674, 334, 335, 336, 668, 669, 670, 665, 666, 667, 363,
+    364, 365, 662, 663, 664, 434, 435, 436, 659, 660, 661, 656, 657, 658, 463,
+    464, 465, 653, 654, 655, 534, 535, 536, 650, 651, 652, 31,  32,  33,  66,
+    67,  68,  131, 132, 133, 166, 167, 168, 231, 232, 233, 266, 267, 268, 331,
+    332, 333, 366, 367, 368, 431, 432, 433, 466, 467, 468, 531, 532, 533, 28,
+    29,  30,  700, 701, 702, 703, 69,  70,  71,  704, 705, 706, 707, 708, 709,
+    128, 129, 130, 710, 711, 712, 169, 170, 171, 713, 714, 715, 716, 717, 718,
+    228, 229, 230, 719, 720, 721, 722, 723, 724, 269, 270, 271, 725, 726, 727,
+    728, 328, 329, 330, 729, 730, 731, 732, 733, 734, 369, 370, 371, 735, 736,
+    737, 428, 429, 430, 738, 739, 740, 741, 742, 743, 469, 470, 471, 744, 745,
+    746, 528, 529, 530, 747, 748, 749, 25,  26,  27,  72,  73,  74,  125, 126,
+    127, 172, 173, 174, 225, 226, 227, 272, 273, 274, 325, 326, 327, 372, 373,
+    374, 425, 426, 427, 472, 473, 474, 525, 526, 527, 22,  23,  24,  796, 797,
+    798, 799, 75,  76,  77,  793, 794, 795, 790, 791, 792, 122, 123, 124, 787,
+    788, 789, 175, 176, 177, 784, 785, 786, 781, 782, 783, 222, 223, 224, 778,
+    779, 780, 775, 776, 777, 275, 276, 277, 771, 772, 773, 774, 322, 323, 324,
+    768, 769, 770, 765, 766, 767, 375, 376, 377, 762, 763, 764, 422, 423, 424,
+    759, 760, 761, 756, 757, 758, 475, 476, 477, 753, 754, 755, 522, 523, 524,
+    750, 751, 752, 19,  20,  21,  800, 801, 802, 803, 78,  79,  80,  804, 805,
+    806, 807, 808, 809, 119, 120, 121, 810, 811, 812, 178, 179, 180, 813, 814,
+    815, 816, 817, 818, 219, 220, 221, 819, 820, 821, 822, 823, 824, 278, 279,
+    280, 825, 826, 827, 828, 319, 320, 321, 829, 830, 831, 832, 833, 834, 378,
+    379, 380, 835, 836, 837, 419, 420, 421, 838, 839, 840, 841, 842, 843, 478,
+    479, 480, 844, 845, 846, 519, 520, 521, 847, 848, 849, 16,  17,  18,  81,
+    82,  83,  116, 117, 118, 181, 182, 183, 216, 217, 218, 281, 282, 283, 316,
+    317, 318, 381, 382, 383, 416, 417, 418, 481, 482, 483, 516, 517, 518, 13,
+    14,  15,  896, 897, 898, 899, 84,  85,  86,  893, 894, 895, 890, 891, 892,
+    113, 114, 115, 887, 888, 889, 184, 185, 186, 884, 885, 886, 881, 882, 883,
+    213, 214, 215, 878, 879, 880, 875, 876, 877, 284, 285, 286, 871, 872, 873,
+    874, 313, 314, 315, 868, 869, 870, 865, 866, 867, 384, 385, 386, 862, 863,
+    864, 413, 414, 415, 859, 860, 861, 856, 857, 858, 484, 485, 486, 853, 854,
+    855, 513, 514, 515, 850, 851, 852, 10,  11,  12,  900, 901, 902, 903, 87,
+    88,  89,  904, 905, 906, 907, 908, 909, 110, 111, 112, 910, 911, 912, 187,
+    188, 189, 913, 914, 915, 916, 917, 918, 210, 211, 212, 919, 920, 921, 922,
+    923, 924, 287, 288, 289, 925, 926, 927, 928, 310, 311, 312, 929, 930, 931,
+    932, 933, 934, 387, 388, 389, 935, 936, 937, 410, 411, 412, 938, 939, 940,
+    941, 942, 943, 487, 488, 489, 944, 945, 946, 510, 511, 512, 947, 948, 949,
+    7,   8,   9,   90,  91,  92,  107, 108, 109, 190, 191, 192, 207, 208, 209,
+    290, 291, 292, 307, 308, 309, 390, 391, 392, 407, 408, 409, 490, 491, 492,
+    507, 508, 509, 4,   5,   6,   996, 997, 998, 999, 93,  94,  95,  993, 994,
+    995, 990, 991, 992, 104, 105, 106, 987, 988, 989, 193, 194, 195, 984, 985,
+    986, 981, 982, 983, 204, 205, 206, 978, 979, 980, 975, 976, 977, 293, 294,
+    295, 971, 972, 973, 974, 304, 305, 306, 968, 969, 970, 965, 966, 967, 393,
+    394, 395, 962, 963, 964, 404, 405, 406, 959, 960, 961, 956, 957, 958, 493,
+    494, 495, 953, 954, 955, 504, 505, 506, 950, 951, 952, 0,   1,   2,   3,
+    96,  97,  98,  99,  100, 101, 102, 103, 196, 197, 198, 199, 200, 201, 202,
+    203, 296, 297, 298, 299, 300, 301, 302, 303, 396, 397, 398, 399, 400, 401,
+    402, 403, 496, 497, 498, 499, 500, 501, 502, 503,
+};
+
+constexpr std::array<uint16_t, kNumLeds * LEDMapping::kNumNeighbors>
+    kNeighbors = {
+    1,   2,   3,   0,   0,   0,   0,   2,   3,   1,   1,   1,   3,   1,   0,
+    4,   2,   2,   2,   4,   1,   999, 998, 0,   999, 3,   998, 5,   2,   997,
+    999, 6,   998, 4,   7,   997, 7,   5,   8,   999, 6,   6,   6,   8,   5,
+    9,   7,   7,   9,   7,   900, 6,   901, 8,   8,   900, 901, 7,   10,  902,
+    11,  900, 901, 9,   12,  902, 10,  12,  13,  900, 11,  11,  13,  11,  14,
+    10,  12,  12,  12,  14,  11,  899, 898, 13,  13,  899, 898, 12,  15,  897,
+    899, 16,  898, 14,  17,  897, 17,  15,  18,  899, 16,  16,  16,  18,  15,
+    19,  17,  17,  17,  19,  16,  800, 801, 18,  800, 18,  801, 17,  20,  802,
+    21,  800, 801, 22,  19,  802, 20,  22,  23,  800, 21,  21,  21,  23,  20,
+    24,  22,  22,  24,  22,  799, 21,  798, 23,  23,  799, 798, 22,  25,  797,
+    26,  799, 798, 24,  27,  797, 25,  27,  28,  799, 26,  26,  28,  26,  29,
+    25,  27,  27,  27,  29,  26,  700, 701, 28,  28,  700, 701, 27,  30,  702,
+    700, 31,  701, 29,  32,  702, 32,  30,  33,  700, 31,  31,  31,  33,  30,
+    34,  32,  32,  32,  34,  31,  699, 698, 33,  699, 33,  698, 32,  35,  697,
+    36,  699, 698, 37,  34,  697, 35,  37,  38,  699, 36,  36,  36,  38,  35,
+    39,  37,  37,  39,  37,  36,  600, 38,  38,  38,  600, 601, 37,  40,  602,
+    41,  600, 601, 39,  42,  602, 40,  42,  600, 43,  601, 41,  43,  41,  40,
+    44,  42,  42,  42,  44,  41,  599, 598, 43,  599, 43,  598, 45,  42,  597,
+    599, 46,  598, 44,  47,  597, 47,  45,  48,  599, 46,  46,  46,  48,  45,
+    49,  47,  47,  49,  47,  46,  48,  48,  48,  48,  47,  49,  49,  49,  49,
+    51,  52,  50,  50,  50,  50,  50,  52,  53,  51,  51,  51,  53,  51,  50,
+    54,  52,  52,  52,  54,  51,  594, 593, 595, 594, 53,  593, 595, 55,  52,
+    594, 56,  593, 595, 54,  57,  57,  55,  58,  594, 56,  56,  56,  58,  55,
+    59,  57,  57,  59,  57,  605, 56,  606, 604, 58,  605, 606, 604, 57,  60,
+    61,  605, 606, 604, 59,  62,  60,  62,  63,  605, 61,  61,  63,  61,  64,
+    60,  62,  62,  62,  64,  61,  694, 693, 695, 63,  694, 693, 695, 62,  65,
+    694, 66,  693, 695, 64,  67,  67,  65,  68,  694, 66,  66,  66,  68,  65,
+    69,  67,  67,  67,  69,  66,  705, 706, 704, 705, 68,  706, 704, 67,  70,
+    71,  705, 706, 704, 72,  69,  70,  72,  73,  705, 71,  71,  71,  73,  70,
+    74,  72,  72,  74,  72,  71,  794, 73,  73,  73,  794, 793, 795, 72,  75,
+    76,  794, 793, 795, 74,  77,  75,  77,  794, 78,  793, 795, 78,  76,  79,
+    75,  77,  77,  77,  79,  76,  805, 806, 804, 78,  805, 806, 804, 77,  80,
+    805, 81,  806, 804, 79,  82,  82,  80,  83,  805, 81,  81,  81,  83,  80,
+    84,  82,  82,  82,  84,  81,  894, 893, 895, 894, 83,  893, 895, 82,  85,
+    86,  894, 893, 895, 87,  84,  85,  87,  88,  894, 86,  86,  86,  88,  85,
+    89,  87,  87,  89,  87,  86,  905, 88,  88,  88,  905, 906, 904, 87,  90,
+    91,  905, 906, 904, 89,  92,  90,  92,  905, 93,  906, 904, 93,  91,  90,
+    94,  92,  92,  92,  94,  91,  994, 993, 995, 994, 93,  993, 995, 95,  92,
+    994, 96,  993, 995, 94,  97,  97,  95,  98,  994, 96,  96,  96,  98,  95,
+    99,  97,  97,  99,  97,  96,  98,  98,  98,  98,  97,  99,  99,  99,  99,
+    101, 102, 100, 100, 100, 100, 100, 102, 103, 101, 101, 101, 103, 101, 100,
+    104, 102, 102, 102, 104, 101, 989, 103, 103, 989, 103, 988, 990, 105, 102,
+    989, 106, 988, 990, 104, 107, 107, 105, 108, 989, 106, 106, 106, 108, 105,
+    109, 107, 107, 109, 107, 910, 106, 909, 911, 108, 910, 909, 911, 107, 110,
+    111, 910, 909, 911, 109, 112, 110, 112, 113, 910, 111, 111, 113, 111, 114,
+    110, 112, 112, 112, 114, 111, 889, 113, 113, 113, 889, 888, 890, 112, 115,
+    889, 116, 888, 890, 114, 117, 117, 115, 118, 889, 116, 116, 116, 118, 115,
+    119, 117, 117, 117, 119, 116, 810, 118, 118, 810, 118, 809, 811, 117, 120,
+    121, 810, 809, 811, 122, 119, 120, 122, 123, 810, 121, 121, 121, 123, 120,
+    124, 122, 122, 124, 122, 789, 121, 788, 790, 123, 789, 788, 790, 122, 125,
+    126, 789, 788, 790, 124, 127, 125, 127, 128, 789, 126, 126, 128, 126, 129,
+    125, 127, 127, 127, 129, 126, 710, 128, 128, 128, 710, 709, 711, 127, 130,
+    710, 131, 709, 711, 129, 132, 132, 130, 133, 710, 131, 131, 131, 133, 130,
+    134, 132, 132, 132, 134, 131, 689, 133, 133, 689, 133, 688, 690, 132, 135,
+    136, 689, 688, 690, 137, 134, 135, 137, 138, 689, 136, 136, 136, 138, 135,
+    139, 137, 137, 139, 137, 136, 610, 138, 138, 138, 610, 609, 611, 137, 140,
+    141, 610, 609, 611, 139, 142, 140, 142, 610, 143, 609, 611, 143, 141, 140,
+    144, 142, 142, 142, 144, 141, 589, 143, 143, 589, 143, 588, 590, 145, 142,
+    589, 146, 588, 590, 144, 147, 147, 145, 148, 589, 146, 146, 146, 148, 145,
+    149, 147, 147, 149, 147, 146, 148, 148, 148, 148, 147, 149, 149, 149, 149,
+    151, 152, 150, 150, 150, 150, 150, 152, 153, 151, 151, 151, 153, 151, 150,
+    154, 152, 152, 152, 154, 151, 584, 583, 585, 584, 153, 583, 585, 155, 152,
+    584, 156, 583, 585, 154, 157, 157, 155, 158, 584, 156, 156, 156, 158, 155,
+    159, 157, 157, 159, 157, 615, 156, 616, 614, 158, 615, 616, 614, 157, 160,
+    161, 615, 616, 614, 159, 162, 160, 162, 163, 615, 161, 161, 163, 161, 164,
+    160, 162, 162, 162, 164, 161, 684, 683, 685, 163, 684, 683, 685, 162, 165,
+    684, 166, 683, 685, 164, 167, 167, 165, 168, 684, 166, 166, 166, 168, 165,
+    169, 167, 167, 167, 169, 166, 715, 716, 714, 715, 168, 716, 714, 167, 170,
+    171, 715, 716, 714, 172, 169, 170, 172, 173, 715, 171, 171, 171, 173, 170,
+    174, 172, 172, 174, 172, 171, 784, 173, 173, 173, 784, 783, 785, 172, 175,
+    176, 784, 783, 785, 174, 177, 175, 177, 784, 178, 783, 785, 178, 176, 179,
+    175, 177, 177, 177, 179, 176, 815, 816, 814, 178, 815, 816, 814, 177, 180,
+    815, 181, 816, 814, 179, 182, 182, 180, 183, 815, 181, 181, 181, 183, 180,
+    184, 182, 182, 182, 184, 181, 884, 883, 885, 884, 183, 883, 885, 182, 185,
+    186, 884, 883, 885, 187, 184, 185, 187, 188, 884, 186, 186, 186, 188, 185,
+    189, 187, 187, 189, 187, 186, 915, 188, 188, 188, 915, 916, 914, 187, 190,
+    191, 915, 916, 914, 189, 192, 190, 192, 915, 193, 916, 914, 193, 191, 190,
+    194, 192, 192, 192, 194, 191, 984, 983, 985, 984, 193, 983, 985, 195, 192,
+    984, 196, 983, 985, 194, 197, 197, 195, 198, 984, 196, 196, 196, 198, 195,
+    199, 197, 197, 199, 197, 196, 198, 198, 198, 198, 197, 199, 199, 199, 199,
+    201, 202, 200, 200, 200, 200, 200, 202, 203, 201, 201, 201, 203, 201, 200,
+    204, 202, 202, 202, 204, 201, 979, 203, 203, 979, 203, 978, 980, 205, 202,
+    979, 206, 978, 980, 204, 207, 207, 205, 208, 979, 206, 206, 206, 208, 205,
+    209, 207, 207, 209, 207, 920, 206, 919, 921, 208, 920, 919, 921, 207, 210,
+    211, 920, 919, 921, 209, 212, 210, 212, 213, 920, 211, 211, 213, 211, 214,
+    210, 212, 212, 212, 214, 211, 879, 213, 213, 213, 879, 878, 880, 212, 215,
+    879, 216, 878, 880, 214, 217, 217, 215, 218, 879, 216, 216, 216, 218, 215,
+    219, 217, 217, 217, 219, 216, 820, 218, 218, 820, 218, 819, 821, 217, 220,
+    221, 820, 819, 821, 222, 219, 220, 222, 223, 820, 221, 221, 221, 223, 220,
+    224, 222, 222, 224, 222, 779, 221, 778, 780, 223, 779, 778, 780, 222, 225,
+    226, 779, 778, 780, 224, 227, 225, 227, 228, 779, 226, 226, 228, 226, 229,
+    225, 227, 227, 227, 229, 226, 720, 228, 228, 228, 720, 719, 721, 227, 230,
+    720, 231, 719, 721, 229, 232, 232, 230, 233, 720, 231, 231, 231, 233, 230,
+    234, 232, 232, 232, 234, 231, 679, 233, 233, 679, 233, 678, 680, 232, 235,
+    236, 679, 678, 680, 237, 234, 235, 237, 238, 679, 236, 236, 236, 238, 235,
+    239, 237, 237, 239, 237, 236, 620, 238, 238, 238, 620, 619, 621, 237, 240,
+    241, 620, 619, 621, 239, 242, 240, 242, 620, 243, 619, 621, 243, 241, 240,
+    244, 242, 242, 242, 244, 241, 579, 243, 243, 579, 243, 578, 580, 245, 242,
+    579, 246, 578, 580, 244, 247, 247, 245, 248, 579, 246, 246, 246, 248, 245,
+    249, 247, 247, 249, 247, 246, 248, 248, 248, 248, 247, 249, 249, 249, 249,
+    251, 252, 250, 250, 250, 250, 250, 252, 253, 251, 251, 251, 253, 251, 250,
+    254, 252, 252, 252, 254, 251, 574, 573, 575, 574, 253, 573, 575, 255, 252,
+    574, 256, 573, 575, 254, 257, 257, 255, 258, 574, 256, 256, 256, 258, 255,
+    259, 257, 257, 259, 257, 625, 256, 626, 624, 258, 625, 626, 624, 257, 260,
+    261, 625, 626, 624, 259, 262, 260, 262, 263, 625, 261, 261, 263, 261, 264,
+    260, 262, 262, 262, 264, 261, 674, 673, 675, 263, 674, 673, 675, 262, 265,
+    674, 266, 673, 675, 264, 267, 267, 265, 268, 674, 266, 266, 266, 268, 265,
+    269, 267, 267, 267, 269, 266, 725, 726, 724, 725, 268, 726, 724, 267, 270,
+    271, 725, 726, 724, 272, 269, 270, 272, 273, 725, 271, 271, 271, 273, 270,
+    274, 272, 272, 274, 272, 271, 774, 273, 273, 273, 774, 773, 775, 272, 275,
+    276, 774, 773, 775, 274, 277, 275, 277, 774, 278, 773, 775, 278, 276, 279,
+    275, 277, 277, 277, 279, 276, 825, 826, 824, 278, 825, 826, 824, 277, 280,
+    825, 281, 826, 824, 279, 282, 282, 280, 283, 825, 281, 281, 281, 283, 280,
+    284, 282, 282, 282, 284, 281, 874, 873, 875, 874, 283, 873, 875, 282, 285,
+    286, 874, 873, 875, 287, 284, 285, 287, 288, 874, 286, 286, 286, 288, 285,
+    289, 287, 287, 289, 287, 286, 925, 288, 288, 288, 925, 926, 924, 287, 290,
+    291, 925, 926, 924, 289, 292, 290, 292, 925, 293, 926, 924, 293, 291, 290,
+    294, 292, 292, 292, 294, 291, 974, 973, 975, 974, 293, 973, 975, 295, 292,
+    974, 296, 973, 975, 294, 297, 297, 295, 298, 974, 296, 296, 296, 298, 295,
+    299, 297, 297, 299, 297, 296, 298, 298, 298, 298, 297, 299, 299, 299, 299,
+    301, 302, 300, 300, 300, 300, 300, 302, 303, 301, 301, 301, 303, 301, 300,
+    304, 302, 302, 302, 304, 301, 969, 303, 303, 969, 303, 968, 970, 305, 302,
+    969, 306, 968, 970, 304, 307, 307, 305, 308, 969, 306, 306, 306, 308, 305,
+    309, 307, 307, 309, 307, 930, 306, 929, 931, 308, 930, 929, 931, 307, 310,
+    311, 930, 929, 931, 309, 312, 310, 312, 313, 930, 311, 311, 313, 311, 314,
+    310, 312, 312, 312, 314, 311, 869, 313, 313, 313, 869, 868, 870, 312, 315,
+    869, 316, 868, 870, 314, 317, 317, 315, 318, 869, 316, 316, 316, 318, 315,
+    319, 317, 317, 317, 319, 316, 830, 318, 318, 830, 318, 829, 831, 317, 320,
+    321, 830, 829, 831, 322, 319, 320, 322, 323, 830, 321, 321, 321, 323, 320,
+    324, 322, 322, 324, 322, 769, 321, 768, 770, 323, 769, 768, 770, 322, 325,
+    326, 769, 768, 770, 324, 327, 325, 327, 328, 769, 326, 326, 328, 326, 329,
+    325, 327, 327, 327, 329, 326, 730, 328, 328, 328, 730, 729, 731, 327, 330,
+    730, 331, 729, 731, 329, 332, 332, 330, 333, 730, 331, 331, 331, 333, 330,
+    334, 332, 332, 332, 334, 331, 669, 333, 333, 669, 333, 668, 670, 332, 335,
+    336, 669, 668, 670, 337, 334, 335, 337, 338, 669, 336, 336, 336, 338, 335,
+    339, 337, 337, 339, 337, 336, 630, 338, 338, 338, 630, 629, 631, 337, 340,
+    341, 630, 629, 631, 339, 342, 340, 342, 630, 343, 629, 631, 343, 341, 340,
+    344, 342, 342, 342, 344, 341, 569, 343, 343, 569, 343, 568, 570, 345, 342,
+    569, 346, 568, 570, 344, 347, 347, 345, 348, 569, 346, 346, 346, 348, 345,
+    349, 347, 347, 349, 347, 346, 348, 348, 348, 348, 347, 349, 349, 349, 349,
+    351, 352, 350, 350, 350, 350, 350, 352, 353, 351, 351, 351, 353, 351, 350,
+    354, 352, 352, 352, 354, 351, 564, 563, 565, 564, 353, 563, 565, 355, 352,
+    564, 356, 563, 565, 354, 357, 357, 355, 358, 564, 356, 356, 356, 358, 355,
+    359, 357, 357, 359, 357, 635, 356, 636, 634, 358, 635, 636, 634, 357, 360,
+    361, 635, 636, 634, 359, 362, 360, 362, 363, 635, 361, 361, 363, 361, 364,
+    360, 362, 362, 362, 364, 361, 664, 663, 665, 363, 664, 663, 665, 362, 365,
+    664, 366, 663, 665, 364, 367, 367, 365, 368, 664, 366, 366, 366, 368, 365,
+    369, 367, 367, 367, 369, 366, 735, 736, 734, 735, 368, 736, 734, 367, 370,
+    371, 735, 736, 734, 372, 369, 370, 372, 373, 735, 371, 371, 371, 373, 370,
+    374, 372, 372, 374, 372, 371, 764, 373, 373, 373, 764, 763, 765, 372, 375,
+    376, 764, 763, 765, 374, 377, 375, 377, 764, 378, 763, 765, 378, 376, 379,
+    375, 377, 377, 377, 379, 376, 835, 836, 834, 378, 835, 836, 834, 377, 380,
+    835, 381, 836, 834, 379, 382, 382, 380, 383, 835, 381, 381, 381, 383, 380,
+    384, 382, 382, 382, 384, 381, 864, 863, 865, 864, 383, 863, 865, 382, 385,
+    386, 864, 863, 865, 387, 384, 385, 387, 388, 864, 386, 386, 386, 388, 385,
+    389, 387, 387, 389, 387, 386, 935, 388, 388, 388, 935, 936, 934, 387, 390,
+    391, 935, 936, 934, 389, 392, 390, 392, 935, 393, 936, 934, 393, 391, 390,
+    394, 392, 392, 392, 394, 391, 964, 963, 965, 964, 393, 963, 965, 395, 392,
+    964, 396, 963, 965, 394, 397, 397, 395, 398, 964, 396, 396, 396, 398, 395,
+    399, 397, 397, 399, 397, 396, 398, 398, 398, 398, 397, 399, 399, 399, 399,
+    401, 402, 400, 400, 400, 400, 400, 402, 403, 401, 401, 401, 403, 401, 400,
+    404, 402, 402, 402, 404, 401, 959, 403, 403, 959, 403, 958, 960, 405, 402,
+    959, 406, 958, 960, 404, 407, 407, 405, 408, 959, 406, 406, 406, 408, 405,
+    409, 407, 407, 409, 407, 940, 406, 939, 941, 408, 940, 939, 941, 407, 410,
+    411, 940, 939, 941, 409, 412, 410, 412, 413, 940, 411, 411, 413, 411, 414,
+    410, 412, 412, 412, 414, 411, 859, 413, 413, 413, 859, 858, 860, 412, 415,
+    859, 416, 858, 860, 414, 417, 417, 415, 418, 859, 416, 416, 416, 418, 415,
+    419, 417, 417, 417, 419, 416, 840, 418, 418, 840, 418, 839, 841, 417, 420,
+    421, 840, 839, 841, 422, 419, 420, 422, 423, 840, 421, 421, 421, 423, 420,
+    424, 422, 422, 424, 422, 759, 421, 758, 760, 423, 759, 758, 760, 422, 425,
+    426, 759, 758, 760, 424, 427, 425, 427, 428, 759, 426, 426, 428, 426, 429,
+    425, 427, 427, 427, 429, 426, 740, 428, 428, 428, 740, 739, 741, 427, 430,
+    740, 431, 739, 741, 429, 432, 432, 430, 433, 740, 431, 431, 431, 433, 430,
+    434, 432, 432, 432, 434, 431, 659, 433, 433, 659, 433, 658, 660, 432, 435,
+    436, 659, 658, 660, 437, 434, 435, 437, 438, 659, 436, 436, 436, 438, 435,
+    439, 437, 437, 439, 437, 436, 640, 438, 438, 438, 640, 639, 641, 437, 440,
+    441, 640, 639, 641, 439, 442, 440, 442, 640, 443, 639, 641, 443, 441, 440,
+    444, 442, 442, 442, 444, 441, 559, 443, 443, 559, 443, 558, 560, 445, 442,
+    559, 446, 558, 560, 444, 447, 447, 445, 448, 559, 446, 446, 446, 448, 445,
+    449, 447, 447, 449, 447, 446, 448, 448, 448, 448, 447, 449, 449, 449, 449,
+    451, 452, 450, 450, 450, 450, 450, 452, 453, 451, 451, 451, 453, 451, 450,
+    454, 452, 452, 452, 454, 451, 554, 553, 555, 554, 453, 553, 555, 455, 452,
+    554, 456, 553, 555, 454, 457, 457, 455, 458, 554, 456, 456, 456, 458, 455,
+    459, 457, 457, 459, 457, 645, 456, 646, 644, 458, 645, 646, 644, 457, 460,
+    461, 645, 646, 644, 459, 462, 460, 462, 463, 645, 461, 461, 463, 461, 464,
+    460, 462, 462, 462, 464, 461, 654, 653, 655, 463, 654, 653, 655, 462, 465,
+    654, 466, 653, 655, 464, 467, 467, 465, 468, 654, 466, 466, 466, 468, 465,
+    469, 467, 467, 467, 469, 466, 745, 746, 744, 745, 468, 746, 744, 467, 470,
+    471, 745, 746, 744, 472, 469, 470, 472, 473, 745, 471, 471, 471, 473, 470,
+    474, 472, 472, 474, 472, 471, 754, 473, 473, 473, 754, 753, 755, 472, 475,
+    476, 754, 753, 755, 474, 477, 475, 477, 754, 478, 753, 755, 478, 476, 479,
+    475, 477, 477, 477, 479, 476, 845, 846, 844, 478, 845, 846, 844, 477, 480,
+    845, 481, 846, 844, 479, 482, 482, 480, 483, 845, 481, 481, 481, 483, 480,
+    484, 482, 482, 482, 484, 481, 854, 853, 855, 854, 483, 853, 855, 482, 485,
+    486, 854, 853, 855, 487, 484, 485, 487, 488, 854, 486, 486, 486, 488, 485,
+    489, 487, 487, 489, 487, 486, 945, 488, 488, 488, 945, 946, 944, 487, 490,
+    491, 945, 946, 944, 489, 492, 490, 492, 945, 493, 946, 944, 493, 491, 490,
+    494, 492, 492, 492, 494, 491, 954, 953, 955, 954, 493, 953, 955, 495, 492,
+    954, 496, 953, 955, 494, 497, 497, 495, 498, 954, 496, 496, 496, 498, 495,
+    499, 497, 497, 499, 497, 496, 498, 498, 498, 498, 497, 499, 499, 499, 499,
+    501, 502, 503, 500, 500, 500, 500, 502, 503, 501, 501, 501, 503, 501, 500,
+    504, 502, 502, 502, 504, 501, 950, 500, 505, 503, 950, 505, 502, 951, 506,
+    506, 950, 504, 507, 951, 503, 507, 505, 508, 950, 504, 509, 506, 508, 505,
+    509, 507, 507, 509, 507, 506, 949, 948, 510, 508, 949, 507, 510, 948, 506,
+    511, 949, 509, 512, 948, 508, 510, 512, 513, 949, 514, 511, 513, 511, 514,
+    510, 512, 512, 512, 514, 511, 850, 515, 513, 513, 850, 512, 515, 851, 511,
+    516, 850, 514, 517, 851, 513, 517, 515, 518, 850, 519, 516, 516, 518, 515,
+    519, 517, 517, 517, 519, 516, 849, 848, 518, 518, 849, 517, 520, 848, 516,
+    521, 849, 522, 519, 848, 523, 520, 522, 523, 849, 524, 521, 521, 523, 520,
+    524, 522, 522, 524, 522, 521, 750, 751, 520, 523, 750, 522, 525, 751, 521,
+    526, 750, 524, 527, 751, 525, 525, 527, 528, 750, 529, 526, 528, 526, 529,
+    525, 527, 527, 527, 529, 526, 749, 530, 528, 528, 749, 527, 530, 748, 526,
+    531, 749, 529, 532, 748, 528, 532, 530, 533, 749, 534, 531, 531, 533, 530,
+    534, 532, 532, 532, 534, 531, 650, 651, 533, 533, 650, 532, 535, 651, 531,
+    536, 650, 537, 534, 651, 538, 535, 537, 538, 650, 539, 536, 536, 538, 535,
+    539, 537, 537, 539, 537, 536, 649, 535, 540, 538, 649, 537, 540, 648, 536,
+    541, 649, 539, 542, 648, 538, 540, 542, 543, 649, 648, 541, 543, 541, 540,
+    544, 542, 542, 542, 544, 541, 550, 545, 543, 543, 550, 545, 542, 551, 546,
+    546, 550, 544, 547, 551, 543, 547, 545, 548, 550, 544, 549, 546, 548, 545,
+    549, 547, 547, 549, 547, 546, 548, 548, 548, 548, 547, 546, 549, 549, 549,
+    551, 544, 545, 552, 543, 546, 550, 552, 553, 544, 545, 551, 551, 553, 550,
+    552, 552, 552, 552, 554, 454, 455, 551, 453, 454, 455, 553, 555, 453, 456,
+    556, 554, 454, 455, 557, 453, 555, 557, 558, 556, 556, 556, 556, 558, 555,
+    557, 557, 557, 557, 559, 444, 445, 556, 560, 444, 445, 558, 560, 443, 446,
+    559, 561, 444, 445, 558, 562, 560, 562, 563, 561, 561, 561, 561, 563, 560,
+    562, 562, 562, 562, 564, 354, 355, 561, 353, 354, 355, 563, 565, 353, 356,
+    566, 564, 354, 355, 567, 353, 565, 567, 568, 566, 566, 566, 566, 568, 565,
+    567, 567, 567, 567, 569, 344, 345, 566, 570, 344, 345, 568, 570, 343, 346,
+    569, 571, 344, 345, 568, 572, 570, 572, 573, 571, 571, 571, 571, 573, 570,
+    572, 572, 572, 572, 574, 254, 255, 571, 253, 254, 255, 573, 575, 253, 256,
+    576, 574, 254, 255, 577, 253, 575, 577, 578, 576, 576, 576, 576, 578, 575,
+    577, 577, 577, 577, 579, 244, 245, 576, 580, 244, 245, 578, 580, 243, 246,
+    579, 581, 244, 245, 578, 582, 580, 582, 583, 581, 581, 581, 581, 583, 580,
+    582, 582, 582, 582, 584, 154, 155, 581, 153, 154, 155, 583, 585, 153, 156,
+    586, 584, 154, 155, 587, 153, 585, 587, 588, 586, 586, 586, 586, 588, 585,
+    587, 587, 587, 587, 589, 144, 145, 586, 590, 144, 145, 588, 590, 143, 146,
+    589, 591, 144, 145, 588, 592, 590, 592, 593, 591, 591, 591, 591, 593, 590,
+    592, 592, 592, 592, 594, 54,  55,  591, 53,  54,  55,  593, 595, 53,  56,
+    596, 594, 54,  55,  597, 53,  595, 597, 598, 596, 596, 596, 596, 598, 595,
+    599, 44,  45,  597, 599, 44,  45,  596, 43,  44,  45,  598, 43,  46,  597,
+    40,  39,  601, 41,  38,  602, 600, 602, 40,  39,  41,  603, 601, 603, 600,
+    604, 40,  39,  602, 604, 601, 603, 603, 603, 603, 605, 59,  60,  58,  602,
+    59,  60,  606, 604, 58,  61,  605, 607, 59,  60,  58,  608, 606, 608, 609,
+    607, 607, 607, 607, 609, 606, 608, 608, 608, 608, 610, 140, 139, 141, 607,
+    140, 139, 609, 611, 141, 138, 610, 612, 140, 139, 141, 611, 611, 613, 614,
+    612, 612, 612, 612, 614, 613, 613, 613, 613, 613, 615, 159, 160, 158, 612,
+    159, 160, 616, 614, 158, 161, 615, 617, 159, 160, 158, 618, 616, 618, 619,
+    617, 617, 617, 617, 619, 616, 618, 618, 618, 618, 620, 240, 239, 241, 617,
+    240, 239, 619, 621, 241, 238, 620, 622, 240, 239, 241, 621, 621, 623, 624,
+    622, 622, 622, 622, 624, 623, 623, 623, 623, 623, 625, 259, 260, 258, 622,
+    259, 260, 626, 624, 258, 261, 625, 627, 259, 260, 258, 628, 626, 628, 629,
+    627, 627, 627, 627, 629, 626, 628, 628, 628, 628, 630, 340, 339, 341, 627,
+    340, 339, 629, 631, 341, 338, 630, 632, 340, 339, 341, 631, 631, 633, 634,
+    632, 632, 632, 632, 634, 633, 633, 633, 633, 633, 635, 359, 360, 358, 632,
+    359, 360, 636, 634, 358, 361, 635, 637, 359, 360, 358, 638, 636, 638, 639,
+    637, 637, 637, 637, 639, 636, 638, 638, 638, 638, 640, 440, 439, 441, 637,
+    440, 439, 639, 641, 441, 438, 640, 642, 440, 439, 441, 641, 641, 643, 644,
+    642, 642, 642, 642, 644, 643, 643, 643, 643, 643, 645, 459, 460, 458, 642,
+    459, 460, 646, 644, 458, 461, 645, 647, 459, 460, 458, 648, 646, 648, 649,
+    647, 647, 647, 647, 649, 646, 540, 539, 541, 648, 540, 539, 541, 647, 538,
+    651, 534, 535, 652, 533, 536, 650, 652, 653, 534, 535, 533, 651, 653, 650,
+    652, 652, 652, 652, 654, 465, 464, 651, 463, 465, 464, 653, 655, 463, 466,
+    656, 654, 465, 464, 657, 463, 655, 657, 658, 656, 656, 656, 656, 658, 655,
+    657, 657, 657, 657, 659, 434, 435, 656, 660, 434, 435, 658, 660, 433, 436,
+    659, 661, 434, 435, 658, 662, 660, 662, 663, 661, 661, 661, 661, 663, 660,
+    662, 662, 662, 662, 664, 365, 364, 661, 363, 365, 364, 663, 665, 363, 366,
+    666, 664, 365, 364, 667, 363, 665, 667, 668, 666, 666, 666, 666, 668, 665,
+    667, 667, 667, 667, 669, 334, 335, 666, 670, 334, 335, 668, 670, 333, 336,
+    669, 671, 334, 335, 668, 672, 670, 672, 673, 671, 671, 671, 671, 673, 670,
+    672, 672, 672, 672, 674, 265, 264, 671, 263, 265, 264, 673, 675, 263, 266,
+    676, 674, 265, 264, 677, 263, 675, 677, 678, 676, 676, 676, 676, 678, 675,
+    677, 677, 677, 677, 679, 234, 235, 676, 680, 234, 235, 678, 680, 233, 236,
+    679, 681, 234, 235, 678, 682, 680, 682, 683, 681, 681, 681, 681, 683, 680,
+    682, 682, 682, 682, 684, 165, 164, 681, 163, 165, 164, 683, 685, 163, 166,
+    686, 684, 165, 164, 687, 163, 685, 687, 688, 686, 686, 686, 686, 688, 685,
+    687, 687, 687, 687, 689, 134, 135, 686, 690, 134, 135, 688, 690, 133, 136,
+    689, 691, 134, 135, 688, 692, 690, 692, 693, 691, 691, 691, 691, 693, 690,
+    692, 692, 692, 692, 694, 65,  64,  691, 63,  65,  64,  693, 695, 63,  66,
+    696, 694, 65,  64,  697, 63,  695, 697, 698, 696, 696, 696, 696, 698, 695,
+    699, 34,  35,  697, 699, 34,  35,  696, 33,  34,  35,  698, 33,  36,  697,
+    30,  29,  701, 28,  31,  702, 700, 702, 30,  29,  703, 28,  701, 703, 700,
+    704, 30,  29,  702, 704, 701, 703, 703, 703, 703, 705, 69,  70,  702, 68,
+    69,  70,  706, 704, 68,  71,  705, 707, 69,  70,  708, 68,  706, 708, 709,
+    707, 707, 707, 707, 709, 706, 708, 708, 708, 708, 710, 130, 129, 707, 711,
+    130, 129, 709, 711, 128, 131, 710, 712, 130, 129, 709, 713, 711, 713, 714,
+    712, 712, 712, 712, 714, 711, 713, 713, 713, 713, 715, 169, 170, 712, 168,
+    169, 170, 716, 714, 168, 171, 715, 717, 169, 170, 718, 168, 716, 718, 719,
+    717, 717, 717, 717, 719, 716, 718, 718, 718, 718, 720, 230, 229, 717, 721,
+    230, 229, 719, 721, 228, 231, 720, 722, 230, 229, 719, 723, 721, 723, 724,
+    722, 722, 722, 722, 724, 721, 723, 723, 723, 723, 725, 269, 270, 722, 268,
+    269, 270, 726, 724, 268, 271, 725, 727, 269, 270, 728, 268, 726, 728, 729,
+    727, 727, 727, 727, 729, 726, 728, 728, 728, 728, 730, 330, 329, 727, 731,
+    330, 329, 729, 731, 328, 331, 730, 732, 330, 329, 729, 733, 731, 733, 734,
+    732, 732, 732, 732, 734, 731, 733, 733, 733, 733, 735, 369, 370, 732, 368,
+    369, 370, 736, 734, 368, 371, 735, 737, 369, 370, 738, 368, 736, 738, 739,
+    737, 737, 737, 737, 739, 736, 738, 738, 738, 738, 740, 430, 429, 737, 741,
+    430, 429, 739, 741, 428, 431, 740, 742, 430, 429, 739, 743, 741, 743, 744,
+    742, 742, 742, 742, 744, 741, 743, 743, 743, 743, 745, 469, 470, 742, 468,
+    469, 470, 746, 744, 468, 471, 745, 747, 469, 470, 748, 468, 746, 748, 749,
+    747, 747, 747, 747, 749, 746, 530, 529, 748, 748, 530, 529, 747, 528, 531,
+    751, 524, 525, 523, 752, 526, 750, 752, 753, 524, 525, 523, 751, 753, 750,
+    752, 752, 752, 752, 754, 475, 474, 476, 751, 475, 474, 753, 755, 476, 473,
+    756, 754, 475, 474, 476, 757, 755, 757, 758, 756, 756, 756, 756, 758, 755,
+    757, 757, 757, 757, 759, 424, 425, 423, 756, 424, 425, 758, 760, 423, 426,
+    759, 761, 424, 425, 423, 760, 760, 762, 763, 761, 761, 761, 761, 763, 762,
+    762, 762, 762, 762, 764, 375, 374, 376, 761, 375, 374, 763, 765, 376, 373,
+    766, 764, 375, 374, 376, 767, 765, 767, 768, 766, 766, 766, 766, 768, 765,
+    767, 767, 767, 767, 769, 324, 325, 323, 766, 324, 325, 768, 770, 323, 326,
+    769, 771, 324, 325, 323, 770, 770, 772, 773, 771, 771, 771, 771, 773, 772,
+    772, 772, 772, 772, 774, 275, 274, 276, 771, 275, 274, 773, 775, 276, 273,
+    776, 774, 275, 274, 276, 777, 775, 777, 778, 776, 776, 776, 776, 778, 775,
+    777, 777, 777, 777, 779, 224, 225, 223, 776, 224, 225, 778, 780, 223, 226,
+    779, 781, 224, 225, 223, 780, 780, 782, 783, 781, 781, 781, 781, 783, 782,
+    782, 782, 782, 782, 784, 175, 174, 176, 781, 175, 174, 783, 785, 176, 173,
+    786, 784, 175, 174, 176, 787, 785, 787, 788, 786, 786, 786, 786, 788, 785,
+    787, 787, 787, 787, 789, 124, 125, 123, 786, 124, 125, 788, 790, 123, 126,
+    789, 791, 124, 125, 123, 790, 790, 792, 793, 791, 791, 791, 791, 793, 792,
+    792, 792, 792, 792, 794, 75,  74,  76,  791, 75,  74,  793, 795, 76,  73,
+    796, 794, 75,  74,  76,  797, 795, 797, 798, 796, 796, 796, 796, 798, 795,
+    799, 24,  25,  797, 799, 24,  25,  23,  796, 24,  25,  798, 23,  26,  797,
+    19,  20,  801, 18,  21,  802, 800, 802, 19,  20,  803, 18,  801, 803, 800,
+    804, 19,  20,  802, 804, 801, 803, 803, 803, 803, 805, 80,  79,  802, 78,
+    80,  79,  806, 804, 78,  81,  805, 807, 80,  79,  808, 78,  806, 808, 809,
+    807, 807, 807, 807, 809, 806, 808, 808, 808, 808, 810, 119, 120, 807, 811,
+    119, 120, 809, 811, 118, 121, 810, 812, 119, 120, 809, 813, 811, 813, 814,
+    812, 812, 812, 812, 814, 811, 813, 813, 813, 813, 815, 180, 179, 812, 178,
+    180, 179, 816, 814, 178, 181, 815, 817, 180, 179, 818, 178, 816, 818, 819,
+    817, 817, 817, 817, 819, 816, 818, 818, 818, 818, 820, 219, 220, 817, 821,
+    219, 220, 819, 821, 218, 221, 820, 822, 219, 220, 819, 823, 821, 823, 824,
+    822, 822, 822, 822, 824, 821, 823, 823, 823, 823, 825, 280, 279, 822, 278,
+    280, 279, 826, 824, 278, 281, 825, 827, 280, 279, 828, 278, 826, 828, 829,
+    827, 827, 827, 827, 829, 826, 828, 828, 828, 828, 830, 319, 320, 827, 831,
+    319, 320, 829, 831, 318, 321, 830, 832, 319, 320, 829, 833, 831, 833, 834,
+    832, 832, 832, 832, 834, 831, 833, 833, 833, 833, 835, 380, 379, 832, 378,
+    380, 379, 836, 834, 378, 381, 835, 837, 380, 379, 838, 378, 836, 838, 839,
+    837, 837, 837, 837, 839, 836, 838, 838, 838, 838, 840, 419, 420, 837, 841,
+    419, 420, 839, 841, 418, 421, 840, 842, 419, 420, 839, 843, 841, 843, 844,
+    842, 842, 842, 842, 844, 841, 843, 843, 843, 843, 845, 480, 479, 842, 478,
+    480, 479, 846, 844, 478, 481, 845, 847, 480, 479, 848, 478, 846, 848, 849,
+    847, 847, 847, 847, 849, 846, 519, 520, 518, 848, 519, 520, 847, 518, 521,
+    851, 515, 514, 852, 513, 516, 850, 852, 853, 515, 514, 851, 851, 853, 850,
+    852, 852, 852, 852, 854, 484, 485, 851, 483, 484, 485, 853, 855, 483, 486,
+    856, 854, 484, 485, 857, 483, 855, 857, 858, 856, 856, 856, 856, 858, 855,
+    857, 857, 857, 857, 859, 415, 414, 856, 860, 415, 414, 858, 860, 413, 416,
+    859, 861, 415, 414, 858, 862, 860, 862, 863, 861, 861, 861, 861, 863, 860,
+    862, 862, 862, 862, 864, 384, 385, 861, 383, 384, 385, 863, 865, 383, 386,
+    866, 864, 384, 385, 867, 383, 865, 867, 868, 866, 866, 866, 866, 868, 865,
+    867, 867, 867, 867, 869, 315, 314, 866, 870, 315, 314, 868, 870, 313, 316,
+    869, 871, 315, 314, 868, 872, 870, 872, 873, 871, 871, 871, 871, 873, 870,
+    872, 872, 872, 872, 874, 284, 285, 871, 283, 284, 285, 873, 875, 283, 286,
+    876, 874, 284, 285, 877, 283, 875, 877, 878, 876, 876, 876, 876, 878, 875,
+    877, 877, 877, 877, 879, 215, 214, 876, 880, 215, 214, 878, 880, 213, 216,
+    879, 881, 215, 214, 878, 882, 880, 882, 883, 881, 881, 881, 881, 883, 880,
+    882, 882, 882, 882, 884, 184, 185, 881, 183, 184, 185, 883, 885, 183, 186,
+    886, 884, 184, 185, 887, 183, 885, 887, 888, 886, 886, 886, 886, 888, 885,
+    887, 887, 887, 887, 889, 115, 114, 886, 890, 115, 114, 888, 890, 113, 116,
+    889, 891, 115, 114, 888, 892, 890, 892, 893, 891, 891, 891, 891, 893, 890,
+    892, 892, 892, 892, 894, 84,  85,  891, 83,  84,  85,  893, 895, 83,  86,
+    896, 894, 84,  85,  897, 83,  895, 897, 898, 896, 896, 896, 896, 898, 895,
+    899, 15,  14,  897, 899, 15,  14,  896, 13,  15,  14,  898, 13,  16,  897,
+    9,   10,  901, 8,   11,  902, 900, 902, 9,   10,  8,   903, 901, 903, 900,
+    904, 9,   10,  902, 904, 901, 903, 903, 903, 903, 905, 90,  89,  91,  902,
+    90,  89,  906, 904, 91,  88,  905, 907, 90,  89,  91,  908, 906, 908, 909,
+    907, 907, 907, 907, 909, 906, 908, 908, 908, 908, 910, 109, 110, 108, 907,
+    109, 110, 909, 911, 108, 111, 910, 912, 109, 110, 108, 911, 911, 913, 914,
+    912, 912, 912, 912, 914, 913, 913, 913, 913, 913, 915, 190, 189, 191, 912,
+    190, 189, 916, 914, 191, 188, 915, 917, 190, 189, 191, 918, 916, 918, 919,
+    917, 917, 917, 917, 919, 916, 918, 918, 918, 918, 920, 209, 210, 208, 917,
+    209, 210, 919, 921, 208, 211, 920, 922, 209, 210, 208, 921, 921, 923, 924,
+    922, 922, 922, 922, 924, 923, 923, 923, 923, 923, 925, 290, 289, 291, 922,
+    290, 289, 926, 924, 291, 288, 925, 927, 290, 289, 291, 928, 926, 928, 929,
+    927, 927, 927, 927, 929, 926, 928, 928, 928, 928, 930, 309, 310, 308, 927,
+    309, 310, 929, 931, 308, 311, 930, 932, 309, 310, 308, 931, 931, 933, 934,
+    932, 932, 932, 932, 934, 933, 933, 933, 933, 933, 935, 390, 389, 391, 932,
+    390, 389, 936, 934, 391, 388, 935, 937, 390, 389, 391, 938, 936, 938, 939,
+    937, 937, 937, 937, 939, 936, 938, 938, 938, 938, 940, 409, 410, 408, 937,
+    409, 410, 939, 941, 408, 411, 940, 942, 409, 410, 408, 941, 941, 943, 944,
+    942, 942, 942, 942, 944, 943, 943, 943, 943, 943, 945, 490, 489, 491, 942,
+    490, 489, 946, 944, 491, 488, 945, 947, 490, 489, 491, 948, 946, 948, 949,
+    947, 947, 947, 947, 949, 946, 509, 510, 508, 948, 509, 510, 508, 947, 511,
+    951, 504, 505, 952, 503, 506, 950, 952, 953, 504, 505, 951, 951, 953, 950,
+    952, 952, 952, 952, 954, 494, 495, 951, 493, 494, 495, 953, 955, 493, 496,
+    956, 954, 494, 495, 957, 493, 955, 957, 958, 956, 956, 956, 956, 958, 955,
+    957, 957, 957, 957, 959, 404, 405, 956, 960, 404, 405, 958, 960, 403, 406,
+    959, 961, 404, 405, 958, 962, 960, 962, 963, 961, 961, 961, 961, 963, 960,
+    962, 962, 962, 962, 964, 394, 395, 961, 393, 394, 395, 963, 965, 393, 396,
+    966, 964, 394, 395, 967, 393, 965, 967, 968, 966, 966, 966, 966, 968, 965,
+    967, 967, 967, 967, 969, 304, 305, 966, 970, 304, 305, 968, 970, 303, 306,
+    969, 971, 304, 305, 968, 972, 970, 972, 973, 971, 971, 971, 971, 973, 970,
+    972, 972, 972, 972, 974, 294, 295, 971, 293, 294, 295, 973, 975, 293, 296,
+    976, 974, 294, 295, 977, 293, 975, 977, 978, 976, 976, 976, 976, 978, 975,
+    977, 977, 977, 977, 979, 204, 205, 976, 980, 204, 205, 978, 980, 203, 206,
+    979, 981, 204, 205, 978, 982, 980, 982, 983, 981, 981, 981, 981, 983, 980,
+    982, 982, 982, 982, 984, 194, 195, 981, 193, 194, 195, 983, 985, 193, 196,
+    986, 984, 194, 195, 987, 193, 985, 987, 988, 986, 986, 986, 986, 988, 985,
+    987, 987, 987, 987, 989, 104, 105, 986, 990, 104, 105, 988, 990, 103, 106,
+    989, 991, 104, 105, 988, 992, 990, 992, 993, 991, 991, 991, 991, 993, 990,
+    992, 992, 992, 992, 994, 94,  95,  991, 93,  94,  95,  993, 995, 93,  96,
+    996, 994, 94,  95,  997, 93,  995, 997, 998, 996, 996, 996, 996, 998, 995,
+    999, 4,   5,   997, 999, 4,   5,   996, 3,   4,   5,   998, 3,   6,   997,
+};
+
+constexpr int kNumSegments = 1;
+constexpr std::array<LEDSegment, kNumSegments> kSegments = {{
+    {.first_led = 0, .num_leds = 1000, .pin = 5},
+}};
+
+constexpr LEDWallVariant kVariant = {
+    .name = "actual_wall_flipped",
+    .mapping =
+        {
+            .num_leds = kNumLeds,
+            .x = kX.data(),
+            .y = kY.data(),
+            .angle = kAngle.data(),
+            .radius = kRadius.data(),
+            .origin_x = 130,
+            .origin_y = 130,
+            .num_radius_buckets = kNumRadiusBuckets,
+            .unique_radii = kUniqueRadii.data(),
+            .radius_bucket_starts = kRadiusBucketStarts.data(),
+            .radius_bucket_leds = kRadiusBucketLeds.data(),
+            .grid_cell_starts = kGridCellStarts.data(),
+            .grid_cell_leds = kGridCellLeds.data(),
+            .neighbors = kNeighbors.data(),
+        },
+    .segments = {.num_segments = kNumSegments, .segments = kSegments.data()},
+    .chipset = LEDChipset::kWS2811BRG,
+};
+
+}  // namespace actual_wall_flipped
 
 // Data for the test LED matrix.
+namespace test_wall {
+
 constexpr int kNumLeds = 256;
-#ifdef FLIP_WALL
+constexpr int kNumRadiusBuckets = 42;
 
-std::vector<uint8_t> coordsX = {
+constexpr std::array<uint8_t, kNumLeds> kX = {
     0,   17,  34,  51,  68,  85,  102, 119, 136, 153, 170, 187, 204, 221, 238,
     255, 255, 238, 221, 204, 187, 170, 153, 136, 119, 102, 85,  68,  51,  34,
     17,  0,   0,   17,  34,  51,  68,  85,  102, 119, 136, 153, 170, 187, 204,
@@ -589,86 +1873,10 @@ std::vector<uint8_t> coordsX = {
     221, 204, 187, 170, 153, 136, 119, 102, 85,  68,  51,  34,  17,  0,   0,
     17,  34,  51,  68,  85,  102, 119, 136, 153, 170, 187, 204, 221, 238, 255,
     255, 238, 221, 204, 187, 170, 153, 136, 119, 102, 85,  68,  51,  34,  17,
-    0};
-std::vector<uint8_t> coordsY = {
-    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-    255, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238,
-    238, 238, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221,
-    221, 221, 221, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204,
-    204, 204, 204, 204, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187,
-    187, 187, 187, 187, 187, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
-    170, 170, 170, 170, 170, 170, 153, 153, 153, 153, 153, 153, 153, 153, 153,
-    153, 153, 153, 153, 153, 153, 153, 136, 136, 136, 136, 136, 136, 136, 136,
-    136, 136, 136, 136, 136, 136, 136, 136, 119, 119, 119, 119, 119, 119, 119,
-    119, 119, 119, 119, 119, 119, 119, 119, 119, 102, 102, 102, 102, 102, 102,
-    102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 85,  85,  85,  85,  85,
-    85,  85,  85,  85,  85,  85,  85,  85,  85,  85,  85,  68,  68,  68,  68,
-    68,  68,  68,  68,  68,  68,  68,  68,  68,  68,  68,  68,  51,  51,  51,
-    51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  34,  34,
-    34,  34,  34,  34,  34,  34,  34,  34,  34,  34,  34,  34,  34,  34,  17,
-    17,  17,  17,  17,  17,  17,  17,  17,  17,  17,  17,  17,  17,  17,  17,
-    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
-    0};
-std::vector<uint8_t> angles = {
-    226, 223, 220, 216, 212, 208, 203, 197, 191, 185, 180, 175, 170, 166, 162,
-    159, 156, 159, 163, 167, 172, 178, 185, 191, 198, 204, 210, 215, 219, 223,
-    226, 229, 232, 230, 227, 223, 219, 213, 207, 199, 191, 183, 176, 169, 164,
-    159, 156, 153, 149, 151, 155, 159, 165, 172, 181, 191, 201, 210, 217, 223,
-    228, 231, 234, 236, 240, 239, 236, 233, 229, 223, 215, 204, 191, 178, 167,
-    159, 154, 149, 146, 144, 139, 141, 143, 146, 151, 159, 172, 191, 210, 223,
-    231, 236, 240, 242, 244, 245, 250, 249, 248, 247, 245, 242, 236, 223, 191,
-    159, 146, 141, 137, 136, 134, 133, 128, 128, 128, 128, 128, 128, 128, 0,
-    0,   0,   0,   0,   0,   0,   0,   0,   5,   6,   7,   8,   10,  13,  19,
-    32,  64,  96,  109, 114, 118, 119, 121, 122, 116, 114, 112, 109, 104, 96,
-    83,  64,  45,  32,  24,  19,  15,  13,  11,  10,  15,  16,  19,  22,  26,
-    32,  40,  51,  64,  77,  88,  96,  101, 106, 109, 111, 106, 104, 100, 96,
-    90,  83,  74,  64,  54,  45,  38,  32,  27,  24,  21,  19,  23,  25,  28,
-    32,  36,  42,  48,  56,  64,  72,  79,  86,  91,  96,  99,  102, 99,  96,
-    92,  88,  83,  77,  70,  64,  57,  51,  45,  40,  36,  32,  29,  26,  29,
-    32,  35,  39,  43,  47,  52,  58,  64,  70,  75,  80,  85,  89,  93,  96,
-    93,  90,  86,  83,  78,  74,  69,  64,  59,  54,  49,  45,  41,  38,  35,
-    32};
-std::vector<uint8_t> radii = {
-    240, 223, 208, 194, 182, 172, 164, 159, 158, 159, 164, 172, 182, 194, 208,
-    223, 208, 191, 176, 163, 151, 143, 137, 135, 137, 143, 151, 163, 176, 191,
-    208, 225, 213, 194, 176, 159, 144, 131, 121, 115, 113, 115, 121, 131, 144,
-    159, 176, 194, 182, 163, 144, 128, 113, 101, 93,  90,  93,  101, 113, 128,
-    144, 163, 182, 202, 193, 172, 151, 131, 113, 96,  81,  71,  68,  71,  81,
-    96,  113, 131, 151, 172, 164, 143, 121, 101, 81,  64,  50,  45,  50,  64,
-    81,  101, 121, 143, 164, 186, 182, 159, 137, 115, 93,  71,  50,  32,  23,
-    32,  50,  71,  93,  115, 137, 159, 158, 135, 113, 90,  68,  45,  23,  0,
-    23,  45,  68,  90,  113, 135, 158, 180, 182, 159, 137, 115, 93,  71,  50,
-    32,  23,  32,  50,  71,  93,  115, 137, 159, 164, 143, 121, 101, 81,  64,
-    50,  45,  50,  64,  81,  101, 121, 143, 164, 186, 193, 172, 151, 131, 113,
-    96,  81,  71,  68,  71,  81,  96,  113, 131, 151, 172, 182, 163, 144, 128,
-    113, 101, 93,  90,  93,  101, 113, 128, 144, 163, 182, 202, 213, 194, 176,
-    159, 144, 131, 121, 115, 113, 115, 121, 131, 144, 159, 176, 194, 208, 191,
-    176, 163, 151, 143, 137, 135, 137, 143, 151, 163, 176, 191, 208, 225, 240,
-    223, 208, 194, 182, 172, 164, 159, 158, 159, 164, 172, 182, 194, 208, 223,
-    240, 225, 213, 202, 193, 186, 182, 180, 182, 186, 193, 202, 213, 225, 240,
-    255};
-#else
-std::vector<uint8_t> coordsX = {
-    0,   17,  34,  51,  68,  85,  102, 119, 136, 153, 170, 187, 204, 221, 238,
-    255, 255, 238, 221, 204, 187, 170, 153, 136, 119, 102, 85,  68,  51,  34,
-    17,  0,   0,   17,  34,  51,  68,  85,  102, 119, 136, 153, 170, 187, 204,
-    221, 238, 255, 255, 238, 221, 204, 187, 170, 153, 136, 119, 102, 85,  68,
-    51,  34,  17,  0,   0,   17,  34,  51,  68,  85,  102, 119, 136, 153, 170,
-    187, 204, 221, 238, 255, 255, 238, 221, 204, 187, 170, 153, 136, 119, 102,
-    85,  68,  51,  34,  17,  0,   0,   17,  34,  51,  68,  85,  102, 119, 136,
-    153, 170, 187, 204, 221, 238, 255, 255, 238, 221, 204, 187, 170, 153, 136,
-    119, 102, 85,  68,  51,  34,  17,  0,   0,   17,  34,  51,  68,  85,  102,
-    119, 136, 153, 170, 187, 204, 221, 238, 255, 255, 238, 221, 204, 187, 170,
-    153, 136, 119, 102, 85,  68,  51,  34,  17,  0,   0,   17,  34,  51,  68,
-    85,  102, 119, 136, 153, 170, 187, 204, 221, 238, 255, 255, 238, 221, 204,
-    187, 170, 153, 136, 119, 102, 85,  68,  51,  34,  17,  0,   0,   17,  34,
-    51,  68,  85,  102, 119, 136, 153, 170, 187, 204, 221, 238, 255, 255, 238,
-    221, 204, 187, 170, 153, 136, 119, 102, 85,  68,  51,  34,  17,  0,   0,
-    17,  34,  51,  68,  85,  102, 119, 136, 153, 170, 187, 204, 221, 238, 255,
-    255, 238, 221, 204, 187, 170, 153, 136, 119, 102, 85,  68,  51,  34,  17,
-    0};
+    0,
+};
 
-std::vector<uint8_t> coordsY = {
+constexpr std::array<uint8_t, kNumLeds> kY = {
     0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
     0,   17,  17,  17,  17,  17,  17,  17,  17,  17,  17,  17,  17,  17,  17,
     17,  17,  34,  34,  34,  34,  34,  34,  34,  34,  34,  34,  34,  34,  34,
@@ -686,9 +1894,10 @@ std::vector<uint8_t> coordsY = {
     221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 238,
     238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238,
     255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
-    255};
+    255,
+};
 
-std::vector<uint8_t> angles = {
+constexpr std::array<uint8_t, kNumLeds> kAngle = {
     32,  35,  38,  41,  45,  49,  54,  59,  64,  69,  74,  78,  83,  86,  90,
     93,  96,  93,  89,  85,  80,  75,  70,  64,  58,  52,  47,  43,  39,  35,
     32,  29,  26,  29,  32,  36,  40,  45,  51,  57,  64,  70,  77,  83,  88,
@@ -706,9 +1915,10 @@ std::vector<uint8_t> angles = {
     159, 164, 169, 176, 183, 191, 199, 207, 213, 219, 223, 227, 230, 232, 229,
     226, 223, 219, 215, 210, 204, 198, 191, 185, 178, 172, 167, 163, 159, 156,
     159, 162, 166, 170, 175, 180, 185, 191, 197, 203, 208, 212, 216, 220, 223,
-    226};
+    226,
+};
 
-std::vector<uint8_t> radii = {
+constexpr std::array<uint8_t, kNumLeds> kRadius = {
     255, 240, 225, 213, 202, 193, 186, 182, 180, 182, 186, 193, 202, 213, 225,
     240, 223, 208, 194, 182, 172, 164, 159, 158, 159, 164, 172, 182, 194, 208,
     223, 240, 225, 208, 191, 176, 163, 151, 143, 137, 135, 137, 143, 151, 163,
@@ -726,6 +1936,537 @@ std::vector<uint8_t> radii = {
     159, 144, 131, 121, 115, 113, 115, 121, 131, 144, 159, 176, 194, 213, 225,
     208, 191, 176, 163, 151, 143, 137, 135, 137, 143, 151, 163, 176, 191, 208,
     223, 208, 194, 182, 172, 164, 159, 158, 159, 164, 172, 182, 194, 208, 223,
-    240};
-#endif  // FLIP_WALL
-#endif  // ACTUAL_WALL
+    240,
+};
+
+constexpr std::array<uint8_t, kNumRadiusBuckets> kUniqueRadii = {
+    0,   23,  32,  45,  50,  64,  68,  71,  81,  90,  93,  96,  101, 113, 115,
+    121, 128, 131, 135, 137, 143, 144, 151, 158, 159, 163, 164, 172, 176, 180,
+    182, 186, 191, 193, 194, 202, 208, 213, 223, 225, 240, 255,
+};
+
+constexpr std::array<uint16_t, kNumRadiusBuckets + 1> kRadiusBucketStarts = {
+    0,   1,   5,   9,   13,  21,  25,  29,  37,  45,  49,  57,  61,  69,  81,
+    89,  97,  101, 109, 113, 121, 129, 137, 145, 149, 161, 169, 177, 185, 193,
+    195, 207, 211, 215, 219, 227, 231, 239, 243, 247, 251, 255, 256,
+};
+
+constexpr std::array<uint16_t, kNumLeds> kRadiusBucketLeds = {
+    136, 119, 135, 137, 151, 118, 120, 150, 152, 104, 134, 138, 168, 103, 105,
+    117, 121, 149, 153, 167, 169, 102, 106, 166, 170, 87,  133, 139, 183, 86,
+    88,  116, 122, 148, 154, 182, 184, 85,  89,  101, 107, 165, 171, 181, 185,
+    72,  132, 140, 200, 71,  73,  115, 123, 147, 155, 199, 201, 84,  90,  180,
+    186, 70,  74,  100, 108, 164, 172, 198, 202, 55,  69,  75,  83,  91,  131,
+    141, 179, 187, 197, 203, 215, 54,  56,  114, 124, 146, 156, 214, 216, 53,
+    57,  99,  109, 163, 173, 213, 217, 68,  76,  196, 204, 52,  58,  82,  92,
+    178, 188, 212, 218, 40,  130, 142, 232, 39,  41,  113, 125, 145, 157, 231,
+    233, 38,  42,  98,  110, 162, 174, 230, 234, 51,  59,  67,  77,  195, 205,
+    211, 219, 37,  43,  81,  93,  177, 189, 229, 235, 23,  129, 143, 247, 22,
+    24,  50,  60,  112, 126, 144, 158, 210, 220, 246, 248, 36,  44,  66,  78,
+    194, 206, 228, 236, 21,  25,  97,  111, 161, 175, 245, 249, 20,  26,  80,
+    94,  176, 190, 244, 250, 35,  45,  49,  61,  209, 221, 227, 237, 8,   128,
+    7,   9,   19,  27,  65,  79,  127, 159, 193, 207, 243, 251, 6,   10,  96,
+    160, 34,  46,  226, 238, 5,   11,  95,  191, 18,  28,  48,  62,  208, 222,
+    242, 252, 4,   12,  64,  192, 17,  29,  33,  47,  225, 239, 241, 253, 3,
+    13,  63,  223, 16,  30,  240, 254, 2,   14,  32,  224, 1,   15,  31,  255,
+    0,
+};
+
+constexpr std::array<uint16_t, LEDMapping::kNumGridCells + 1>
+    kGridCellStarts = {
+    0,   1,   2,   3,   4,   5,   6,   7,   8,   9,   10,  11,  12,  13,  14,
+    15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25,  26,  27,  28,  29,
+    30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,
+    45,  46,  47,  48,  49,  50,  51,  52,  53,  54,  55,  56,  57,  58,  59,
+    60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,  72,  73,  74,
+    75,  76,  77,  78,  79,  80,  81,  82,  83,  84,  85,  86,  87,  88,  89,
+    90,  91,  92,  93,  94,  95,  96,  97,  98,  99,  100, 101, 102, 103, 104,
+    105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119,
+    120, 121, 122, 123, 124, 125, 126, 127, 128, 129, 130, 131, 132, 133, 134,
+    135, 136, 137, 138, 139, 140, 141, 142, 143, 144, 145, 146, 147, 148, 149,
+    150, 151, 152, 153, 154, 155, 156, 157, 158, 159, 160, 161, 162, 163, 164,
+    165, 166, 167, 168, 169, 170, 171, 172, 173, 174, 175, 176, 177, 178, 179,
+    180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191, 192, 193, 194,
+    195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207, 208, 209,
+    210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220, 221, 222, 223, 224,
+    225, 226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 238, 239,
+    240, 241, 242, 243, 244, 245, 246, 247, 248, 249, 250, 251, 252, 253, 254,
+    255, 256,
+};
+
+constexpr std::array<uint16_t, kNumLeds> kGridCellLeds = {
+    0,   1,   2,   3,   4,   5,   6,   7,   8,   9,   10,  11,  12,  13,  14,
+    15,  31,  30,  29,  28,  27,  26,  25,  24,  23,  22,  21,  20,  19,  18,
+    17,  16,  32,  33,  34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,
+    45,  46,  47,  63,  62,  61,  60,  59,  58,  57,  56,  55,  54,  53,  52,
+    51,  50,  49,  48,  64,  65,  66,  67,  68,  69,  70,  71,  72,  73,  74,
+    75,  76,  77,  78,  79,  95,  94,  93,  92,  91,  90,  89,  88,  87,  86,
+    85,  84,  83,  82,  81,  80,  96,  97,  98,  99,  100, 101, 102, 103, 104,
+    105, 106, 107, 108, 109, 110, 111, 127, 126, 125, 124, 123, 122, 121, 120,
+    119, 118, 117, 116, 115, 114, 113, 112, 128, 129, 130, 131, 132, 133, 134,
+    135, 136, 137, 138, 139, 140, 141, 142, 143, 159, 158, 157, 156, 155, 154,
+    153, 152, 151, 150, 149, 148, 147, 146, 145, 144, 160, 161, 162, 163, 164,
+    165, 166, 167, 168, 169, 170, 171, 172, 173, 174, 175, 191, 190, 189, 188,
+    187, 186, 185, 184, 183, 182, 181, 180, 179, 178, 177, 176, 192, 193, 194,
+    195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207, 223, 222,
+    221, 220, 219, 218, 217, 216, 215, 214, 213, 212, 211, 210, 209, 208, 224,
+    225, 226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 238, 239,
+    255, 254, 253, 252, 251, 250, 249, 248, 247, 246, 245, 244, 243, 242, 241,
+    240,
+};
+
+constexpr std::array<uint16_t, kNumLeds * LEDMapping::kNumNeighbors>
+    kNeighbors = {
+    1,   31,  30,  2,   32,  0,   0,   2,   30,  29,  31,  3,   1,   3,   29,
+    28,  30,  0,   2,   4,   28,  27,  29,  1,   3,   5,   27,  26,  28,  4,
+    4,   6,   26,  25,  27,  5,   5,   7,   25,  24,  26,  6,   6,   8,   24,
+    23,  25,  7,   7,   9,   23,  22,  24,  8,   8,   10,  22,  21,  23,  9,
+    9,   11,  21,  20,  22,  10,  10,  12,  20,  19,  21,  11,  11,  13,  19,
+    18,  20,  12,  12,  14,  18,  17,  19,  13,  13,  15,  17,  16,  18,  14,
+    14,  16,  17,  47,  15,  15,  15,  17,  47,  14,  46,  16,  14,  16,  18,
+    46,  13,  15,  13,  17,  19,  45,  12,  14,  12,  18,  20,  44,  11,  13,
+    11,  19,  21,  43,  10,  12,  10,  20,  22,  42,  9,   11,  9,   21,  23,
+    41,  8,   10,  8,   22,  24,  40,  7,   9,   7,   23,  25,  39,  6,   8,
+    6,   24,  26,  38,  5,   7,   5,   25,  27,  37,  4,   6,   4,   26,  28,
+    36,  3,   5,   3,   27,  29,  35,  2,   4,   2,   28,  30,  34,  1,   3,
+    1,   29,  31,  33,  0,   2,   0,   30,  32,  1,   33,  31,  31,  33,  63,
+    62,  0,   32,  30,  32,  34,  62,  31,  33,  29,  33,  35,  61,  34,  34,
+    28,  34,  36,  60,  35,  35,  27,  35,  37,  59,  36,  36,  26,  36,  38,
+    58,  37,  37,  25,  37,  39,  57,  38,  38,  24,  38,  40,  56,  39,  39,
+    23,  39,  41,  55,  40,  40,  22,  40,  42,  54,  41,  41,  21,  41,  43,
+    53,  42,  42,  20,  42,  44,  52,  43,  43,  19,  43,  45,  51,  44,  44,
+    18,  44,  46,  50,  45,  45,  17,  45,  47,  49,  16,  46,  16,  46,  48,
+    49,  15,  47,  47,  49,  79,  78,  48,  48,  46,  48,  50,  78,  47,  49,
+    45,  49,  51,  77,  50,  50,  44,  50,  52,  76,  51,  51,  43,  51,  53,
+    75,  52,  52,  42,  52,  54,  74,  53,  53,  41,  53,  55,  73,  54,  54,
+    40,  54,  56,  72,  55,  55,  39,  55,  57,  71,  56,  56,  38,  56,  58,
+    70,  57,  57,  37,  57,  59,  69,  58,  58,  36,  58,  60,  68,  59,  59,
+    35,  59,  61,  67,  60,  60,  34,  60,  62,  66,  61,  61,  33,  61,  63,
+    65,  32,  62,  32,  62,  64,  65,  63,  63,  63,  65,  95,  94,  64,  64,
+    62,  64,  66,  94,  63,  65,  61,  65,  67,  93,  66,  66,  60,  66,  68,
+    92,  67,  67,  59,  67,  69,  91,  68,  68,  58,  68,  70,  90,  69,  69,
+    57,  69,  71,  89,  70,  70,  56,  70,  72,  88,  71,  71,  55,  71,  73,
+    87,  72,  72,  54,  72,  74,  86,  73,  73,  53,  73,  75,  85,  74,  74,
+    52,  74,  76,  84,  75,  75,  51,  75,  77,  83,  76,  76,  50,  76,  78,
+    82,  77,  77,  49,  77,  79,  81,  48,  78,  48,  78,  80,  81,  79,  79,
+    79,  81,  111, 110, 80,  80,  78,  80,  82,  110, 79,  81,  77,  81,  83,
+    109, 82,  82,  76,  82,  84,  108, 83,  83,  75,  83,  85,  107, 84,  84,
+    74,  84,  86,  106, 85,  85,  73,  85,  87,  105, 86,  86,  72,  86,  88,
+    104, 87,  87,  71,  87,  89,  103, 88,  88,  70,  88,  90,  102, 89,  89,
+    69,  89,  91,  101, 90,  90,  68,  90,  92,  100, 91,  91,  67,  91,  93,
+    99,  92,  92,  66,  92,  94,  98,  93,  93,  65,  93,  95,  97,  64,  94,
+    64,  94,  96,  97,  95,  95,  95,  97,  127, 126, 96,  96,  94,  96,  98,
+    126, 95,  97,  93,  97,  99,  125, 98,  98,  92,  98,  100, 124, 99,  99,
+    91,  99,  101, 123, 100, 100, 90,  100, 102, 122, 101, 101, 89,  101, 103,
+    121, 102, 102, 88,  102, 104, 120, 103, 103, 87,  103, 105, 119, 104, 104,
+    86,  104, 106, 118, 105, 105, 85,  105, 107, 117, 106, 106, 84,  106, 108,
+    116, 107, 107, 83,  107, 109, 115, 108, 108, 82,  108, 110, 114, 109, 109,
+    81,  109, 111, 113, 80,  110, 80,  110, 112, 113, 111, 111, 111, 113, 143,
+    142, 112, 112, 110, 112, 114, 142, 111, 113, 109, 113, 115, 141, 114, 114,
+    108, 114, 116, 140, 115, 115, 107, 115, 117, 139, 116, 116, 106, 116, 118,
+    138, 117, 117, 105, 117, 119, 137, 118, 118, 104, 118, 120, 136, 119, 119,
+    103, 119, 121, 135, 120, 120, 102, 120, 122, 134, 121, 121, 101, 121, 123,
+    133, 122, 122, 100, 122, 124, 132, 123, 123, 99,  123, 125, 131, 124, 124,
+    98,  124, 126, 130, 125, 125, 97,  125, 127, 129, 96,  126, 96,  126, 128,
+    129, 127, 127, 127, 129, 159, 158, 128, 128, 126, 128, 130, 158, 127, 129,
+    125, 129, 131, 157, 130, 130, 124, 130, 132, 156, 131, 131, 123, 131, 133,
+    155, 132, 132, 122, 132, 134, 154, 133, 133, 121, 133, 135, 153, 134, 134,
+    120, 134, 136, 152, 135, 135, 119, 135, 137, 151, 136, 136, 118, 136, 138,
+    150, 137, 137, 117, 137, 139, 149, 138, 138, 116, 138, 140, 148, 139, 139,
+    115, 139, 141, 147, 140, 140, 114, 140, 142, 146, 141, 141, 113, 141, 143,
+    145, 112, 142, 112, 142, 144, 145, 143, 143, 143, 145, 175, 174, 144, 144,
+    142, 144, 146, 174, 143, 145, 141, 145, 147, 173, 146, 146, 140, 146, 148,
+    172, 147, 147, 139, 147, 149, 171, 148, 148, 138, 148, 150, 170, 149, 149,
+    137, 149, 151, 169, 150, 150, 136, 150, 152, 168, 151, 151, 135, 151, 153,
+    167, 152, 152, 134, 152, 154, 166, 153, 153, 133, 153, 155, 165, 154, 154,
+    132, 154, 156, 164, 155, 155, 131, 155, 157, 163, 156, 156, 130, 156, 158,
+    162, 157, 157, 129, 157, 159, 161, 128, 158, 128, 158, 160, 161, 159, 159,
+    159, 161, 191, 190, 160, 160, 158, 160, 162, 190, 159, 161, 157, 161, 163,
+    189, 162, 162, 156, 162, 164, 188, 163, 163, 155, 163, 165, 187, 164, 164,
+    154, 164, 166, 186, 165, 165, 153, 165, 167, 185, 166, 166, 152, 166, 168,
+    184, 167, 167, 151, 167, 169, 183, 168, 168, 150, 168, 170, 182, 169, 169,
+    149, 169, 171, 181, 170, 170, 148, 170, 172, 180, 171, 171, 147, 171, 173,
+    179, 172, 172, 146, 172, 174, 178, 173, 173, 145, 173, 175, 177, 144, 174,
+    144, 174, 176, 177, 175, 175, 175, 177, 207, 206, 176, 176, 174, 176, 178,
+    206, 175, 177, 173, 177, 179, 205, 178, 178, 172, 178, 180, 204, 179, 179,
+    171, 179, 181, 203, 180, 180, 170, 180, 182, 202, 181, 181, 169, 181, 183,
+    201, 182, 182, 168, 182, 184, 200, 183, 183, 167, 183, 185, 199, 184, 184,
+    166, 184, 186, 198, 185, 185, 165, 185, 187, 197, 186, 186, 164, 186, 188,
+    196, 187, 187, 163, 187, 189, 195, 188, 188, 162, 188, 190, 194, 189, 189,
+    161, 189, 191, 193, 160, 190, 160, 190, 192, 193, 191, 191, 191, 193, 223,
+    222, 192, 192, 190, 192, 194, 222, 191, 193, 189, 193, 195, 221, 194, 194,
+    188, 194, 196, 220, 195, 195, 187, 195, 197, 219, 196, 196, 186, 196, 198,
+    218, 197, 197, 185, 197, 199, 217, 198, 198, 184, 198, 200, 216, 199, 199,
+    183, 199, 201, 215, 200, 200, 182, 200, 202, 214, 201, 201, 181, 201, 203,
+    213, 202, 202, 180, 202, 204, 212, 203, 203, 179, 203, 205, 211, 204, 204,
+    178, 204, 206, 210, 205, 205, 177, 205, 207, 209, 176, 206, 176, 206, 208,
+    209, 207, 207, 207, 209, 239, 238, 208, 208, 206, 208, 210, 238, 207, 209,
+    205, 209, 211, 237, 210, 210, 204, 210, 212, 236, 211, 211, 203, 211, 213,
+    235, 212, 212, 202, 212, 214, 234, 213, 213, 201, 213, 215, 233, 214, 214,
+    200, 214, 216, 232, 215, 215, 199, 215, 217, 231, 216, 216, 198, 216, 218,
+    230, 217, 217, 197, 217, 219, 229, 218, 218, 196, 218, 220, 228, 219, 219,
+    195, 219, 221, 227, 220, 220, 194, 220, 222, 226, 221, 221, 193, 221, 223,
+    225, 192, 222, 192, 222, 224, 225, 223, 223, 223, 225, 255, 254, 224, 224,
+    222, 224, 226, 254, 223, 225, 221, 225, 227, 253, 226, 226, 220, 226, 228,
+    252, 227, 227, 219, 227, 229, 251, 228, 228, 218, 228, 230, 250, 229, 229,
+    217, 229, 231, 249, 230, 230, 216, 230, 232, 248, 231, 231, 215, 231, 233,
+    247, 232, 232, 214, 232, 234, 246, 233, 233, 213, 233, 235, 245, 234, 234,
+    212, 234, 236, 244, 235, 235, 211, 235, 237, 243, 236, 236, 210, 236, 238,
+    242, 237, 237, 209, 237, 239, 241, 208, 238, 208, 238, 240, 241, 239, 239,
+    239, 241, 240, 240, 240, 240, 238, 240, 242, 239, 241, 241, 237, 241, 243,
+    242, 242, 242, 236, 242, 244, 243, 243, 243, 235, 243, 245, 244, 244, 244,
+    234, 244, 246, 245, 245, 245, 233, 245, 247, 246, 246, 246, 232, 246, 248,
+    247, 247, 247, 231, 247, 249, 248, 248, 248, 230, 248, 250, 249, 249, 249,
+    229, 249, 251, 250, 250, 250, 228, 250, 252, 251, 251, 251, 227, 251, 253,
+    252, 252, 252, 226, 252, 254, 253, 253, 253, 225, 253, 255, 224, 254, 254,
+    224, 254, 255, 255, 255, 255,
+};
+
+constexpr int kNumSegments = 1;
+constexpr std::array<LEDSegment, kNumSegments> kSegments = {{
+    {.first_led = 0, .num_leds = 256, .pin = 5},
+}};
+
+constexpr LEDWallVariant kVariant = {
+    .name = "test_wall",
+    .mapping =
+        {
+            .num_leds = kNumLeds,
+            .x = kX.data(),
+            .y = kY.data(),
+            .angle = kAngle.data(),
+            .radius = kRadius.data(),
+            .origin_x = 136,
+            .origin_y = 136,
+            .num_radius_buckets = kNumRadiusBuckets,
+            .unique_radii = kUniqueRadii.data(),
+            .radius_bucket_starts = kRadiusBucketStarts.data(),
+            .radius_bucket_leds = kRadiusBucketLeds.data(),
+            .grid_cell_starts = kGridCellStarts.data(),
+            .grid_cell_leds = kGridCellLeds.data(),
+            .neighbors = kNeighbors.data(),
+        },
+    .segments = {.num_segments = kNumSegments, .segments = kSegments.data()},
+    .chipset = LEDChipset::kWS2812GRB,
+};
+
+}  // namespace test_wall
+
+// Data for the test LED matrix, flipped.
+namespace test_wall_flipped {
+
+constexpr int kNumLeds = 256;
+constexpr int kNumRadiusBuckets = 42;
+
+constexpr std::array<uint8_t, kNumLeds> kX = {
+    0,   17,  34,  51,  68,  85,  102, 119, 136, 153, 170, 187, 204, 221, 238,
+    255, 255, 238, 221, 204, 187, 170, 153, 136, 119, 102, 85,  68,  51,  34,
+    17,  0,   0,   17,  34,  51,  68,  85,  102, 119, 136, 153, 170, 187, 204,
+    221, 238, 255, 255, 238, 221, 204, 187, 170, 153, 136, 119, 102, 85,  68,
+    51,  34,  17,  0,   0,   17,  34,  51,  68,  85,  102, 119, 136, 153, 170,
+    187, 204, 221, 238, 255, 255, 238, 221, 204, 187, 170, 153, 136, 119, 102,
+    85,  68,  51,  34,  17,  0,   0,   17,  34,  51,  68,  85,  102, 119, 136,
+    153, 170, 187, 204, 221, 238, 255, 255, 238, 221, 204, 187, 170, 153, 136,
+    119, 102, 85,  68,  51,  34,  17,  0,   0,   17,  34,  51,  68,  85,  102,
+    119, 136, 153, 170, 187, 204, 221, 238, 255, 255, 238, 221, 204, 187, 170,
+    153, 136, 119, 102, 85,  68,  51,  34,  17,  0,   0,   17,  34,  51,  68,
+    85,  102, 119, 136, 153, 170, 187, 204, 221, 238, 255, 255, 238, 221, 204,
+    187, 170, 153, 136, 119, 102, 85,  68,  51,  34,  17,  0,   0,   17,  34,
+    51,  68,  85,  102, 119, 136, 153, 170, 187, 204, 221, 238, 255, 255, 238,
+    221, 204, 187, 170, 153, 136, 119, 102, 85,  68,  51,  34,  17,  0,   0,
+    17,  34,  51,  68,  85,  102, 119, 136, 153, 170, 187, 204, 221, 238, 255,
+    255, 238, 221, 204, 187, 170, 153, 136, 119, 102, 85,  68,  51,  34,  17,
+    0,
+};
+
+constexpr std::array<uint8_t, kNumLeds> kY = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238, 238,
+    238, 238, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221, 221,
+    221, 221, 221, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204, 204,
+    204, 204, 204, 204, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187, 187,
+    187, 187, 187, 187, 187, 170, 170, 170, 170, 170, 170, 170, 170, 170, 170,
+    170, 170, 170, 170, 170, 170, 153, 153, 153, 153, 153, 153, 153, 153, 153,
+    153, 153, 153, 153, 153, 153, 153, 136, 136, 136, 136, 136, 136, 136, 136,
+    136, 136, 136, 136, 136, 136, 136, 136, 119, 119, 119, 119, 119, 119, 119,
+    119, 119, 119, 119, 119, 119, 119, 119, 119, 102, 102, 102, 102, 102, 102,
+    102, 102, 102, 102, 102, 102, 102, 102, 102, 102, 85,  85,  85,  85,  85,
+    85,  85,  85,  85,  85,  85,  85,  85,  85,  85,  85,  68,  68,  68,  68,
+    68,  68,  68,  68,  68,  68,  68,  68,  68,  68,  68,  68,  51,  51,  51,
+    51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  51,  34,  34,
+    34,  34,  34,  34,  34,  34,  34,  34,  34,  34,  34,  34,  34,  34,  17,
+    17,  17,  17,  17,  17,  17,  17,  17,  17,  17,  17,  17,  17,  17,  17,
+    0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,
+    0,
+};
+
+constexpr std::array<uint8_t, kNumLeds> kAngle = {
+    226, 223, 220, 216, 212, 208, 203, 197, 191, 185, 180, 175, 170, 166, 162,
+    159, 156, 159, 163, 167, 172, 178, 185, 191, 198, 204, 210, 215, 219, 223,
+    226, 229, 232, 230, 227, 223, 219, 213, 207, 199, 191, 183, 176, 169, 164,
+    159, 156, 153, 149, 151, 155, 159, 165, 172, 181, 191, 201, 210, 217, 223,
+    228, 231, 234, 236, 240, 239, 236, 233, 229, 223, 215, 204, 191, 178, 167,
+    159, 154, 149, 146, 144, 139, 141, 143, 146, 151, 159, 172, 191, 210, 223,
+    231, 236, 240, 242, 244, 245, 250, 249, 248, 247, 245, 242, 236, 223, 191,
+    159, 146, 141, 137, 136, 134, 133, 128, 128, 128, 128, 128, 128, 128, 0,
+    0,   0,   0,   0,   0,   0,   0,   0,   5,   6,   7,   8,   10,  13,  19,
+    32,  64,  96,  109, 114, 118, 119, 121, 122, 116, 114, 112, 109, 104, 96,
+    83,  64,  45,  32,  24,  19,  15,  13,  11,  10,  15,  16,  19,  22,  26,
+    32,  40,  51,  64,  77,  88,  96,  101, 106, 109, 111, 106, 104, 100, 96,
+    90,  83,  74,  64,  54,  45,  38,  32,  27,  24,  21,  19,  23,  25,  28,
+    32,  36,  42,  48,  56,  64,  72,  79,  86,  91,  96,  99,  102, 99,  96,
+    92,  88,  83,  77,  70,  64,  57,  51,  45,  40,  36,  32,  29,  26,  29,
+    32,  35,  39,  43,  47,  52,  58,  64,  70,  75,  80,  85,  89,  93,  96,
+    93,  90,  86,  83,  78,  74,  69,  64,  59,  54,  49,  45,  41,  38,  35,
+    32,
+};
+
+constexpr std::array<uint8_t, kNumLeds> kRadius = {
+    240, 223, 208, 194, 182, 172, 164, 159, 158, 159, 164, 172, 182, 194, 208,
+    223, 208, 191, 176, 163, 151, 143, 137, 135, 137, 143, 151, 163, 176, 191,
+    208, 225, 213, 194, 176, 159, 144, 131, 121, 115, 113, 115, 121, 131, 144,
+    159, 176, 194, 182, 163, 144, 128, 113, 101, 93,  90,  93,  101, 113, 128,
+    144, 163, 182, 202, 193, 172, 151, 131, 113, 96,  81,  71,  68,  71,  81,
+    96,  113, 131, 151, 172, 164, 143, 121, 101, 81,  64,  50,  45,  50,  64,
+    81,  101, 121, 143, 164, 186, 182, 159, 137, 115, 93,  71,  50,  32,  23,
+    32,  50,  71,  93,  115, 137, 159, 158, 135, 113, 90,  68,  45,  23,  0,
+    23,  45,  68,  90,  113, 135, 158, 180, 182, 159, 137, 115, 93,  71,  50,
+    32,  23,  32,  50,  71,  93,  115, 137, 159, 164, 143, 121, 101, 81,  64,
+    50,  45,  50,  64,  81,  101, 121, 143, 164, 186, 193, 172, 151, 131, 113,
+    96,  81,  71,  68,  71,  81,  96,  113, 131, 151, 172, 182, 163, 144, 128,
+    113, 101, 93,  90,  93,  101, 113, 128, 144, 163, 182, 202, 213, 194, 176,
+    159, 144, 131, 121, 115, 113, 115, 121, 131, 144, 159, 176, 194, 208, 191,
+    176, 163, 151, 143, 137, 135, 137, 143, 151, 163, 176, 191, 208, 225, 240,
+    223, 208, 194, 182, 172, 164, 159, 158, 159, 164, 172, 182, 194, 208, 223,
+    240, 225, 213, 202, 193, 186, 182, 180, 182, 186, 193, 202, 213, 225, 240,
+    255,
+};
+
+constexpr std::array<uint8_t, kNumRadiusBuckets> kUniqueRadii = {
+    0,   23,  32,  45,  50,  64,  68,  71,  81,  90,  93,  96,  101, 113, 115,
+    121, 128, 131, 135, 137, 143, 144, 151, 158, 159, 163, 164, 172, 176, 180,
+    182, 186, 191, 193, 194, 202, 208, 213, 223, 225, 240, 255,
+};
+
+constexpr std::array<uint16_t, kNumRadiusBuckets + 1> kRadiusBucketStarts = {
+    0,   1,   5,   9,   13,  21,  25,  29,  37,  45,  49,  57,  61,  69,  81,
+    89,  97,  101, 109, 113, 121, 129, 137, 145, 149, 161, 169, 177, 185, 193,
+    195, 207, 211, 215, 219, 227, 231, 239, 243, 247, 251, 255, 256,
+};
+
+constexpr std::array<uint16_t, kNumLeds> kRadiusBucketLeds = {
+    119, 104, 118, 120, 136, 103, 105, 135, 137, 87,  117, 121, 151, 86,  88,
+    102, 106, 134, 138, 150, 152, 85,  89,  149, 153, 72,  116, 122, 168, 71,
+    73,  101, 107, 133, 139, 167, 169, 70,  74,  84,  90,  148, 154, 166, 170,
+    55,  115, 123, 183, 54,  56,  100, 108, 132, 140, 182, 184, 69,  75,  165,
+    171, 53,  57,  83,  91,  147, 155, 181, 185, 40,  52,  58,  68,  76,  114,
+    124, 164, 172, 180, 186, 200, 39,  41,  99,  109, 131, 141, 199, 201, 38,
+    42,  82,  92,  146, 156, 198, 202, 51,  59,  179, 187, 37,  43,  67,  77,
+    163, 173, 197, 203, 23,  113, 125, 215, 22,  24,  98,  110, 130, 142, 214,
+    216, 21,  25,  81,  93,  145, 157, 213, 217, 36,  44,  50,  60,  178, 188,
+    196, 204, 20,  26,  66,  78,  162, 174, 212, 218, 8,   112, 126, 232, 7,
+    9,   35,  45,  97,  111, 129, 143, 195, 205, 231, 233, 19,  27,  49,  61,
+    177, 189, 211, 219, 6,   10,  80,  94,  144, 158, 230, 234, 5,   11,  65,
+    79,  161, 175, 229, 235, 18,  28,  34,  46,  194, 206, 210, 220, 127, 247,
+    4,   12,  48,  62,  96,  128, 176, 190, 228, 236, 246, 248, 95,  159, 245,
+    249, 17,  29,  209, 221, 64,  160, 244, 250, 3,   13,  33,  47,  193, 207,
+    227, 237, 63,  191, 243, 251, 2,   14,  16,  30,  208, 222, 226, 238, 32,
+    192, 242, 252, 1,   15,  225, 239, 31,  223, 241, 253, 0,   224, 240, 254,
+    255,
+};
+
+constexpr std::array<uint16_t, LEDMapping::kNumGridCells + 1>
+    kGridCellStarts = {
+    0,   1,   2,   3,   4,   5,   6,   7,   8,   9,   10,  11,  12,  13,  14,
+    15,  16,  17,  18,  19,  20,  21,  22,  23,  24,  25,  26,  27,  28,  29,
+    30,  31,  32,  33,  34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,
+    45,  46,  47,  48,  49,  50,  51,  52,  53,  54,  55,  56,  57,  58,  59,
+    60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,  72,  73,  74,
+    75,  76,  77,  78,  79,  80,  81,  82,  83,  84,  85,  86,  87,  88,  89,
+    90,  91,  92,  93,  94,  95,  96,  97,  98,  99,  100, 101, 102, 103, 104,
+    105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 115, 116, 117, 118, 119,
+    120, 121, 122, 123, 124, 125, 126, 127, 128, 129, 130, 131, 132, 133, 134,
+    135, 136, 137, 138, 139, 140, 141, 142, 143, 144, 145, 146, 147, 148, 149,
+    150, 151, 152, 153, 154, 155, 156, 157, 158, 159, 160, 161, 162, 163, 164,
+    165, 166, 167, 168, 169, 170, 171, 172, 173, 174, 175, 176, 177, 178, 179,
+    180, 181, 182, 183, 184, 185, 186, 187, 188, 189, 190, 191, 192, 193, 194,
+    195, 196, 197, 198, 199, 200, 201, 202, 203, 204, 205, 206, 207, 208, 209,
+    210, 211, 212, 213, 214, 215, 216, 217, 218, 219, 220, 221, 222, 223, 224,
+    225, 226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237, 238, 239,
+    240, 241, 242, 243, 244, 245, 246, 247, 248, 249, 250, 251, 252, 253, 254,
+    255, 256,
+};
+
+constexpr std::array<uint16_t, kNumLeds> kGridCellLeds = {
+    255, 254, 253, 252, 251, 250, 249, 248, 247, 246, 245, 244, 243, 242, 241,
+    240, 224, 225, 226, 227, 228, 229, 230, 231, 232, 233, 234, 235, 236, 237,
+    238, 239, 223, 222, 221, 220, 219, 218, 217, 216, 215, 214, 213, 212, 211,
+    210, 209, 208, 192, 193, 194, 195, 196, 197, 198, 199, 200, 201, 202, 203,
+    204, 205, 206, 207, 191, 190, 189, 188, 187, 186, 185, 184, 183, 182, 181,
+    180, 179, 178, 177, 176, 160, 161, 162, 163, 164, 165, 166, 167, 168, 169,
+    170, 171, 172, 173, 174, 175, 159, 158, 157, 156, 155, 154, 153, 152, 151,
+    150, 149, 148, 147, 146, 145, 144, 128, 129, 130, 131, 132, 133, 134, 135,
+    136, 137, 138, 139, 140, 141, 142, 143, 127, 126, 125, 124, 123, 122, 121,
+    120, 119, 118, 117, 116, 115, 114, 113, 112, 96,  97,  98,  99,  100, 101,
+    102, 103, 104, 105, 106, 107, 108, 109, 110, 111, 95,  94,  93,  92,  91,
+    90,  89,  88,  87,  86,  85,  84,  83,  82,  81,  80,  64,  65,  66,  67,
+    68,  69,  70,  71,  72,  73,  74,  75,  76,  77,  78,  79,  63,  62,  61,
+    60,  59,  58,  57,  56,  55,  54,  53,  52,  51,  50,  49,  48,  32,  33,
+    34,  35,  36,  37,  38,  39,  40,  41,  42,  43,  44,  45,  46,  47,  31,
+    30,  29,  28,  27,  26,  25,  24,  23,  22,  21,  20,  19,  18,  17,  16,
+    0,   1,   2,   3,   4,   5,   6,   7,   8,   9,   10,  11,  12,  13,  14,
+    15,
+};
+
+constexpr std::array<uint16_t, kNumLeds * LEDMapping::kNumNeighbors>
+    kNeighbors = {
+    1,   31,  30,  2,   32,  0,   0,   2,   30,  29,  31,  3,   1,   3,   29,
+    28,  30,  0,   2,   4,   28,  27,  29,  1,   3,   5,   27,  26,  28,  4,
+    4,   6,   26,  25,  27,  5,   5,   7,   25,  24,  26,  6,   6,   8,   24,
+    23,  25,  7,   7,   9,   23,  22,  24,  8,   8,   10,  22,  21,  23,  9,
+    9,   11,  21,  20,  22,  10,  10,  12,  20,  19,  21,  11,  11,  13,  19,
+    18,  20,  12,  12,  14,  18,  17,  19,  13,  13,  15,  17,  16,  18,  14,
+    14,  16,  17,  47,  15,  15,  15,  17,  47,  14,  46,  16,  14,  16,  18,
+    46,  13,  15,  13,  17,  19,  45,  12,  14,  12,  18,  20,  44,  11,  13,
+    11,  19,  21,  43,  10,  12,  10,  20,  22,  42,  9,   11,  9,   21,  23,
+    41,  8,   10,  8,   22,  24,  40,  7,   9,   7,   23,  25,  39,  6,   8,
+    6,   24,  26,  38,  5,   7,   5,   25,  27,  37,  4,   6,   4,   26,  28,
+    36,  3,   5,   3,   27,  29,  35,  2,   4,   2,   28,  30,  34,  1,   3,
+    1,   29,  31,  33,  0,   2,   0,   30,  32,  1,   33,  31,  31,  33,  63,
+    62,  0,   32,  30,  32,  34,  62,  31,  33,  29,  33,  35,  61,  34,  34,
+    28,  34,  36,  60,  35,  35,  27,  35,  37,  59,  36,  36,  26,  36,  38,
+    58,  37,  37,  25,  37,  39,  57,  38,  38,  24,  38,  40,  56,  39,  39,
+    23,  39,  41,  55,  40,  40,  22,  40,  42,  54,  41,  41,  21,  41,  43,
+    53,  42,  42,  20,  42,  44,  52,  43,  43,  19,  43,  45,  51,  44,  44,
+    18,  44,  46,  50,  45,  45,  17,  45,  47,  49,  16,  46,  16,  46,  48,
+    49,  15,  47,  47,  49,  79,  78,  48,  48,  46,  48,  50,  78,  47,  49,
+    45,  49,  51,  77,  50,  50,  44,  50,  52,  76,  51,  51,  43,  51,  53,
+    75,  52,  52,  42,  52,  54,  74,  53,  53,  41,  53,  55,  73,  54,  54,
+    40,  54,  56,  72,  55,  55,  39,  55,  57,  71,  56,  56,  38,  56,  58,
+    70,  57,  57,  37,  57,  59,  69,  58,  58,  36,  58,  60,  68,  59,  59,
+    35,  59,  61,  67,  60,  60,  34,  60,  62,  66,  61,  61,  33,  61,  63,
+    65,  32,  62,  32,  62,  64,  65,  63,  63,  63,  65,  95,  94,  64,  64,
+    62,  64,  66,  94,  63,  65,  61,  65,  67,  93,  66,  66,  60,  66,  68,
+    92,  67,  67,  59,  67,  69,  91,  68,  68,  58,  68,  70,  90,  69,  69,
+    57,  69,  71,  89,  70,  70,  56,  70,  72,  88,  71,  71,  55,  71,  73,
+    87,  72,  72,  54,  72,  74,  86,  73,  73,  53,  73,  75,  85,  74,  74,
+    52,  74,  76,  84,  75,  75,  51,  75,  77,  83,  76,  76,  50,  76,  78,
+    82,  77,  77,  49,  77,  79,  81,  48,  78,  48,  78,  80,  81,  79,  79,
+    79,  81,  111, 110, 80,  80,  78,  80,  82,  110, 79,  81,  77,  81,  83,
+    109, 82,  82,  76,  82,  84,  108, 83,  83,  75,  83,  85,  107, 84,  84,
+    74,  84,  86,  106, 85,  85,  73,  85,  87,  105, 86,  86,  72,  86,  88,
+    104, 87,  87,  71,  87,  89,  103, 88,  88,  70,  88,  90,  102, 89,  89,
+    69,  89,  91,  101, 90,  90,  68,  90,  92,  100, 91,  91,  67,  91,  93,
+    99,  92,  92,  66,  92,  94,  98,  93,  93,  65,  93,  95,  97,  64,  94,
+    64,  94,  96,  97,  95,  95,  95,  97,  127, 126, 96,  96,  94,  96,  98,
+    126, 95,  97,  93,  97,  99,  125, 98,  98,  92,  98,  100, 124, 99,  99,
+    91,  99,  101, 123, 100, 100, 90,  100, 102, 122, 101, 101, 89,  101, 103,
+    121, 102, 102, 88,  102, 104, 120, 103, 103, 87,  103, 105, 119, 104, 104,
+    86,  104, 106, 118, 105, 105, 85,  105, 107, 117, 106, 106, 84,  106, 108,
+    116, 107, 107, 83,  107, 109, 115, 108, 108, 82,  108, 110, 114, 109, 109,
+    81,  109, 111, 113, 80,  110, 80,  110, 112, 113, 111, 111, 111, 113, 143,
+    142, 112, 112, 110, 112, 114, 142, 111, 113, 109, 113, 115, 141, 114, 114,
+    108, 114, 116, 140, 115, 115, 107, 115, 117, 139, 116, 116, 106, 116, 118,
+    138, 117, 117, 105, 117, 119, 137, 118, 118, 104, 118, 120, 136, 119, 119,
+    103, 119, 121, 135, 120, 120, 102, 120, 122, 134, 121, 121, 101, 121, 123,
+    133, 122, 122, 100, 122, 124, 132, 123, 123, 99,  123, 125, 131, 124, 124,
+    98,  124, 126, 130, 125, 125, 97,  125, 127, 129, 96,  126, 96,  126, 128,
+    129, 127, 127, 127, 129, 159, 158, 128, 128, 126, 128, 130, 158, 127, 129,
+    125, 129, 131, 157, 130, 130, 124, 130, 132, 156, 131, 131, 123, 131, 133,
+    155, 132, 132, 122, 132, 134, 154, 133, 133, 121, 133, 135, 153, 134, 134,
+    120, 134, 136, 152, 135, 135, 119, 135, 137, 151, 136, 136, 118, 136, 138,
+    150, 137, 137, 117, 137, 139, 149, 138, 138, 116, 138, 140, 148, 139, 139,
+    115, 139, 141, 147, 140, 140, 114, 140, 142, 146, 141, 141, 113, 141, 143,
+    145, 112, 142, 112, 142, 144, 145, 143, 143, 143, 145, 175, 174, 144, 144,
+    142, 144, 146, 174, 143, 145, 141, 145, 147, 173, 146, 146, 140, 146, 148,
+    172, 147, 147, 139, 147, 149, 171, 148, 148, 138, 148, 150, 170, 149, 149,
+    137, 149, 151, 169, 150, 150, 136, 150, 152, 168, 151, 151, 135, 151, 153,
+    167, 152, 152, 134, 152, 154, 166, 153, 153, 133, 153, 155, 165, 154, 154,
+    132, 154, 156, 164, 155, 155, 131, 155, 157, 163, 156, 156, 130, 156, 158,
+    162, 157, 157, 129, 157, 159, 161, 128, 158, 128, 158, 160, 161, 159, 159,
+    159, 161, 191, 190, 160, 160, 158, 160, 162, 190, 159, 161, 157, 161, 163,
+    189, 162, 162, 156, 162, 164, 188, 163, 163, 155, 163, 165, 187, 164, 164,
+    154, 164, 166, 186, 165, 165, 153, 165, 167, 185, 166, 166, 152, 166, 168,
+    184, 167, 167, 151, 167, 169, 183, 168, 168, 150, 168, 170, 182, 169, 169,
+    149, 169, 171, 181, 170, 170, 148, 170, 172, 180, 171, 171, 147, 171, 173,
+    179, 172, 172, 146, 172, 174, 178, 173, 173, 145, 173, 175, 177, 144, 174,
+    144, 174, 176, 177, 175, 175, 175, 177, 207, 206, 176, 176, 174, 176, 178,
+    206, 175, 177, 173, 177, 179, 205, 178, 178, 172, 178, 180, 204, 179, 179,
+    171, 179, 181, 203, 180, 180, 170, 180, 182, 202, 181, 181, 169, 181, 183,
+    201, 182, 182, 168, 182, 184, 200, 183, 183, 167, 183, 185, 199, 184, 184,
+    166, 184, 186, 198, 185, 185, 165, 185, 187, 197, 186, 186, 164, 186, 188,
+    196, 187, 187, 163, 187, 189, 195, 188, 188, 162, 188, 190, 194, 189, 189,
+    161, 189, 191, 193, 160, 190, 160, 190, 192, 193, 191, 191, 191, 193, 223,
+    222, 192, 192, 190, 192, 194, 222, 191, 193, 189, 193, 195, 221, 194, 194,
+    188, 194, 196, 220, 195, 195, 187, 195, 197, 219, 196, 196, 186, 196, 198,
+    218, 197, 197, 185, 197, 199, 217, 198, 198, 184, 198, 200, 216, 199, 199,
+    183, 199, 201, 215, 200, 200, 182, 200, 202, 214, 201, 201, 181, 201, 203,
+    213, 202, 202, 180, 202, 204, 212, 203, 203, 179, 203, 205, 211, 204, 204,
+    178, 204, 206, 210, 205, 205, 177, 205, 207, 209, 176, 206, 176, 206, 208,
+    209, 207, 207, 207, 209, 239, 238, 208, 208, 206, 208, 210, 238, 207, 209,
+    205, 209, 211, 237, 210, 210, 204, 210, 212, 236, 211, 211, 203, 211, 213,
+    235, 212, 212, 202, 212, 214, 234, 213, 213, 201, 213, 215, 233, 214, 214,
+    200, 214, 216, 232, 215, 215, 199, 215, 217, 231, 216, 216, 198, 216, 218,
+    230, 217, 217, 197, 217, 219, 229, 218, 218, 196, 218, 220, 228, 219, 219,
+    195, 219, 221, 227, 220, 220, 194, 220, 222, 226, 221, 221, 193, 221, 223,
+    225, 192, 222, 192, 222, 224, 225, 223, 223, 223, 225, 255, 254, 224, 224,
+    222, 224, 226, 254, 223, 225, 221, 225, 227, 253, 226, 226, 220, 226, 228,
+    252, 227, 227, 219, 227, 229, 251, 228, 228, 218, 228, 230, 250, 229, 229,
+    217, 229, 231, 249, 230, 230, 216, 230, 232, 248, 231, 231, 215, 231, 233,
+    247, 232, 232, 214, 232, 234, 246, 233, 233, 213, 233, 235, 245, 234, 234,
+    212, 234, 236, 244, 235, 235, 211, 235, 237, 243, 236, 236, 210, 236, 238,
+    242, 237, 237, 209, 237, 239, 241, 208, 238, 208, 238, 240, 241, 239, 239,
+    239, 241, 240, 240, 240, 240, 238, 240, 242, 239, 241, 241, 237, 241, 243,
+    242, 242, 242, 236, 242, 244, 243, 243, 243, 235, 243, 245, 244, 244, 244,
+    234, 244, 246, 245, 245, 245, 233, 245, 247, 246, 246, 246, 232, 246, 248,
+    247, 247, 247, 231, 247, 249, 248, 248, 248, 230, 248, 250, 249, 249, 249,
+    229, 249, 251, 250, 250, 250, 228, 250, 252, 251, 251, 251, 227, 251, 253,
+    252, 252, 252, 226, 252, 254, 253, 253, 253, 225, 253, 255, 224, 254, 254,
+    224, 254, 255, 255, 255, 255,
+};
+
+constexpr int kNumSegments = 1;
+constexpr std::array<LEDSegment, kNumSegments> kSegments = {{
+    {.first_led = 0, .num_leds = 256, .pin = 5},
+}};
+
+constexpr LEDWallVariant kVariant = {
+    .name = "test_wall_flipped",
+    .mapping =
+        {
+            .num_leds = kNumLeds,
+            .x = kX.data(),
+            .y = kY.data(),
+            .angle = kAngle.data(),
+            .radius = kRadius.data(),
+            .origin_x = 136,
+            .origin_y = 136,
+            .num_radius_buckets = kNumRadiusBuckets,
+            .unique_radii = kUniqueRadii.data(),
+            .radius_bucket_starts = kRadiusBucketStarts.data(),
+            .radius_bucket_leds = kRadiusBucketLeds.data(),
+            .grid_cell_starts = kGridCellStarts.data(),
+            .grid_cell_leds = kGridCellLeds.data(),
+            .neighbors = kNeighbors.data(),
+        },
+    .segments = {.num_segments = kNumSegments, .segments = kSegments.data()},
+    .chipset = LEDChipset::kWS2812GRB,
+};
+
+}  // namespace test_wall_flipped
+
+}  // namespace
+
+constexpr LEDWallVariant kLEDWallVariants[kNumLEDWallVariants] = {
+    actual_wall::kVariant,
+    actual_wall_flipped::kVariant,
+    test_wall::kVariant,
+    test_wall_flipped::kVariant,
+};
+
+const LEDWallVariant* FindLEDWallVariant(const char* name) {
+  for (const LEDWallVariant& variant : kLEDWallVariants) {
+    if (std::strcmp(variant.name, name) == 0) return &variant;
+  }
+  return nullptr;
+}
@@ -0,0 +1,101 @@
+#include "wall/mapping_blob.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+
+namespace {
+
+// Standard CRC-32 (as in zlib), bit by bit: blobs are only checked at boot and
+// after an upload.
+uint32_t Crc32(const uint8_t* data, size_t size) {
+  uint32_t crc = 0xffffffff;
+  for (size_t i = 0; i < size; ++i) {
+    crc ^= data[i];
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+    }
+  }
+  return ~crc;
+}
+
+// Returns whether starts are the offsets of num_buckets buckets of LEDs laid
+// out one after the other in leds, and every LED is in range.
+bool ValidBuckets(const uint16_t* starts, int num_buckets, const uint16_t* leds,
+                  int num_leds) {
+  if (starts[0] != 0 || starts[num_buckets] != num_leds) return false;
+  for (int b = 0; b < num_buckets; ++b) {
+    if (starts[b] > starts[b + 1]) return false;
+  }
+  for (int i = 0; i < num_leds; ++i) {
+    if (leds[i] >= num_leds) return false;
+  }
+  return true;
+}
+
+}  // namespace
+
+size_t MappingBlobSize(const MappingBlobHeader& header) {
+  size_t num_leds = header.num_leds;
+  size_t num_radius_buckets = header.num_radius_buckets;
+  size_t num_indexes = (num_radius_buckets + 1) + num_leds +
+                       (LEDMapping::kNumGridCells + 1) + num_leds +
+                       num_leds * LEDMapping::kNumNeighbors;
+  return sizeof(MappingBlobHeader) + 2 * num_indexes + 4 * num_leds +
+         num_radius_buckets;
+}
+
+std::optional<LEDMapping> ParseMappingBlob(const uint8_t* blob, size_t size) {
+  MappingBlobHeader header;
+  if (size < sizeof(header)) return std::nullopt;
+  std::memcpy(&header, blob, sizeof(header));
+  if (header.magic != MappingBlobHeader::kMagic ||
+      header.version != MappingBlobHeader::kVersion ||
+      header.grid_size != LEDMapping::kGridSize ||
+      header.num_neighbors != LEDMapping::kNumNeighbors ||
+      header.num_leds == 0 || header.num_radius_buckets == 0 ||
+      size != MappingBlobSize(header)) {
+    return std::nullopt;
+  }
+  if (Crc32(blob + sizeof(header), size - sizeof(header)) != header.crc32) {
+    return std::nullopt;
+  }
+
+  int num_leds = header.num_leds;
+  int num_radius_buckets = header.num_radius_buckets;
+  LEDMapping mapping;
+  mapping.num_leds = num_leds;
+  mapping.num_radius_buckets = num_radius_buckets;
+  mapping.origin_x = header.origin_x;
+  mapping.origin_y = header.origin_y;
+  const uint16_t* indexes =
+      reinterpret_cast<const uint16_t*>(blob + sizeof(header));
+  mapping.radius_bucket_starts = indexes;
+  indexes += num_radius_buckets + 1;
+  mapping.radius_bucket_leds = indexes;
+  indexes += num_leds;
+  mapping.grid_cell_starts = indexes;
+  indexes += LEDMapping::kNumGridCells + 1;
+  mapping.grid_cell_leds = indexes;
+  indexes += num_leds;
+  mapping.neighbors = indexes;
+  indexes += num_leds * LEDMapping::kNumNeighbors;
+  const uint8_t* coordinates = reinterpret_cast<const uint8_t*>(indexes);
+  mapping.x = coordinates;
+  mapping.y = coordinates + num_leds;
+  mapping.angle = coordinates + 2 * num_leds;
+  mapping.radius = coordinates + 3 * num_leds;
+  mapping.unique_radii = coordinates + 4 * num_leds;
+
+  if (!ValidBuckets(mapping.radius_bucket_starts, num_radius_buckets,
+                    mapping.radius_bucket_leds, num_leds) ||
+      !ValidBuckets(mapping.grid_cell_starts, LEDMapping::kNumGridCells,
+                    mapping.grid_cell_leds, num_leds)) {
+    return std::nullopt;
+  }
+  for (int i = 0; i < num_leds * LEDMapping::kNumNeighbors; ++i) {
+    if (mapping.neighbors[i] >= num_leds) return std::nullopt;
+  }
+  return mapping;
+}
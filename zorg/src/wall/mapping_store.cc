@@ -0,0 +1,128 @@
+#include "wall/mapping_store.h"
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <esp_partition.h>
+#include <esp_spi_flash.h>
+
+#include <cstdint>
+#include <cstring>
+#include <optional>
+
+#include "wall/led_mapper_data.h"
+#include "wall/mapping_blob.h"
+
+namespace {
+
+constexpr char kPartitionLabel[] = "mapping";
+// Custom partition type, see partitions.csv.
+constexpr esp_partition_type_t kPartitionType =
+    static_cast<esp_partition_type_t>(0x40);
+constexpr char kSlotKey[] = "mapping_slot";
+constexpr int kNumSlots = 2;
+
+}  // namespace
+
+const esp_partition_t* MappingStore::Partition() {
+  const esp_partition_t* partition =
+      esp_partition_find_first(kPartitionType, ESP_PARTITION_SUBTYPE_ANY,
+                               kPartitionLabel);
+  if (partition == nullptr || partition->size < kNumSlots * kSlotSize) {
+    return nullptr;
+  }
+  return partition;
+}
+
+std::optional<LEDMapping> MappingStore::MapSlot(
+    int slot, spi_flash_mmap_handle_t* handle, size_t* size) const {
+  const esp_partition_t* partition = Partition();
+  if (partition == nullptr) return std::nullopt;
+  const void* data;
+  if (esp_partition_mmap(partition, slot * kSlotSize, kSlotSize,
+                         SPI_FLASH_MMAP_DATA, &data, handle) != ESP_OK) {
+    return std::nullopt;
+  }
+  const uint8_t* blob = static_cast<const uint8_t*>(data);
+  MappingBlobHeader header;
+  std::memcpy(&header, blob, sizeof(header));
+  size_t blob_size = MappingBlobSize(header);
+  std::optional<LEDMapping> mapping;
+  if (blob_size <= kSlotSize) mapping = ParseMappingBlob(blob, blob_size);
+  if (!mapping.has_value()) {
+    spi_flash_munmap(*handle);
+  } else if (size != nullptr) {
+    *size = blob_size;
+  }
+  return mapping;
+}
+
+std::optional<LEDMapping> MappingStore::Load() {
+  if (!prefs_->isKey(kSlotKey)) return std::nullopt;
+  int slot = prefs_->getUChar(kSlotKey);
+  if (slot >= kNumSlots) return std::nullopt;
+  // Never unmapped, the mapping is used until the wall restarts.
+  spi_flash_mmap_handle_t handle;
+  std::optional<LEDMapping> mapping = MapSlot(slot, &handle);
+  if (mapping.has_value()) stored_slot_ = slot;
+  return mapping;
+}
+
+MappingStore::ChunkStatus MappingStore::WriteChunk(uint32_t offset,
+                                                   uint32_t total_size,
+                                                   const uint8_t* data,
+                                                   size_t size) {
+  const esp_partition_t* partition = Partition();
+  if (partition == nullptr) return ChunkStatus::kFailed;
+  if (offset == 0) {
+    // An upload too short for a header would be complete before anything was
+    // written, and leave whatever the slot held before.
+    if (total_size < sizeof(MappingBlobHeader) || total_size > kSlotSize) {
+      upload_slot_ = -1;
+      return ChunkStatus::kFailed;
+    }
+    upload_slot_ = stored_slot_ == 0 ? 1 : 0;
+    upload_size_ = total_size;
+    upload_offset_ = 0;
+    erased_size_ = 0;
+  }
+  if (upload_slot_ < 0 || offset != upload_offset_) {
+    return ChunkStatus::kOutOfOrder;
+  }
+  if (offset + size > upload_size_) {
+    upload_slot_ = -1;
+    return ChunkStatus::kFailed;
+  }
+
+  // Sectors are erased as the upload reaches them, so no single chunk blocks
+  // for long.
+  uint32_t slot_offset = upload_slot_ * kSlotSize;
+  while (erased_size_ < offset + size) {
+    if (esp_partition_erase_range(partition, slot_offset + erased_size_,
+                                  SPI_FLASH_SEC_SIZE) != ESP_OK) {
+      upload_slot_ = -1;
+      return ChunkStatus::kFailed;
+    }
+    erased_size_ += SPI_FLASH_SEC_SIZE;
+  }
+  if (esp_partition_write(partition, slot_offset + offset, data, size) !=
+      ESP_OK) {
+    upload_slot_ = -1;
+    return ChunkStatus::kFailed;
+  }
+  upload_offset_ += size;
+  return ChunkStatus::kWritten;
+}
+
+bool MappingStore::FinishUpload() {
+  if (!upload_complete()) return false;
+  int slot = upload_slot_;
+  upload_slot_ = -1;
+  spi_flash_mmap_handle_t handle;
+  size_t size;
+  if (!MapSlot(slot, &handle, &size).has_value()) return false;
+  spi_flash_munmap(handle);
+  // A valid blob of another size was left in the slot by an earlier upload.
+  if (size != upload_size_) return false;
+  prefs_->putUChar(kSlotKey, slot);
+  return true;
+}
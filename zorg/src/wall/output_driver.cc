@@ -0,0 +1,70 @@
+#include "wall/output_driver.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+uint32_t WireTimeModel::FrameMicros(
+    const std::vector<LEDSegment>& segments) const {
+  int longest = 0;
+  for (const LEDSegment& segment : segments) {
+    longest = std::max<int>(longest, segment.num_leds);
+  }
+  return SegmentMicros(longest);
+}
+
+std::vector<LEDSegment> FitSegments(const LEDSegmentLayout& layout,
+                                    int num_leds) {
+  std::vector<LEDSegment> segments;
+  for (int i = 0; i < layout.num_segments; ++i) {
+    LEDSegment segment = layout.segments[i];
+    if (segment.first_led >= num_leds) break;
+    segment.num_leds =
+        std::min<int>(segment.num_leds, num_leds - segment.first_led);
+    segments.push_back(segment);
+  }
+  if (!segments.empty()) {
+    LEDSegment& last = segments.back();
+    last.num_leds = num_leds - last.first_led;
+  }
+  return segments;
+}
+
+std::vector<LEDSegment> SplitSegments(int num_leds,
+                                      const std::vector<uint8_t>& pins) {
+  std::vector<LEDSegment> segments;
+  int num_segments = pins.size();
+  for (int i = 0; i < num_segments; ++i) {
+    int first_led = num_leds * i / num_segments;
+    int end = num_leds * (i + 1) / num_segments;
+    segments.push_back({.first_led = uint16_t(first_led),
+                        .num_leds = uint16_t(end - first_led),
+                        .pin = pins[i]});
+  }
+  return segments;
+}
+
+MockOutputDriver::MockOutputDriver(std::vector<LEDSegment> segments,
+                                   ChannelOrder order, WireTimeModel model)
+    : segments_(std::move(segments)),
+      order_(order),
+      frame_micros_(model.FrameMicros(segments_)),
+      bytes_(segments_.size()) {
+  for (int s = 0; s < int(segments_.size()); ++s) {
+    bytes_[s].resize(3 * segments_[s].num_leds);
+  }
+}
+
+void MockOutputDriver::Show(const CRGB* leds) {
+  for (int s = 0; s < int(segments_.size()); ++s) {
+    const CRGB* segment_leds = leds + segments_[s].first_led;
+    uint8_t* out = bytes_[s].data();
+    for (int i = 0; i < segments_[s].num_leds; ++i) {
+      for (int c = 0; c < 3; ++c) {
+        *out++ = segment_leds[i].raw[order_.channels[c]];
+      }
+    }
+  }
+  ++num_frames_;
+}
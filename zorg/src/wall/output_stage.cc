@@ -0,0 +1,74 @@
+#include "wall/output_stage.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+uint8_t BrightnessEnvelope::At(uint32_t now_millis) const {
+  uint32_t half_period = std::max<uint32_t>(period_millis / 2, 1);
+  uint32_t phase = now_millis % (2 * half_period);
+  // Time since the envelope was last at min_brightness.
+  uint32_t rise = phase < half_period ? phase : 2 * half_period - phase;
+  return min_brightness +
+         (int(max_brightness) - min_brightness) * int(rise) / int(half_period);
+}
+
+void OutputStage::Init(int num_leds, const Options& options) {
+  options_ = options;
+  for (int c = 0; c < 3; ++c) {
+    for (int v = 0; v < 256; ++v) {
+      float value = std::pow(v / 255.0f, options.gamma);
+      tables_[c][v] = std::lround(value * options.white_balance.raw[c]);
+    }
+  }
+  leds_.assign(num_leds, CRGB::Black);
+  full_draw_ = 0;
+  brightness_ = 0;
+  scale_ = 0;
+  draw_milliamps_ = 0;
+}
+
+void OutputStage::Apply(uint32_t now_millis, const CRGB* frame) {
+  uint8_t brightness = options_.envelope.At(now_millis);
+  uint8_t scale = std::min(brightness, LimitScale(full_draw_));
+  uint32_t full_draw = Pass(frame, scale);
+  if (options_.power_budget_milliamps > 0 &&
+      DrawMilliamps(full_draw, scale) > options_.power_budget_milliamps) {
+    // The frame draws more than the last one, lower the limit.
+    scale = std::min(brightness, LimitScale(full_draw));
+    Pass(frame, scale);
+  }
+  full_draw_ = full_draw;
+  brightness_ = brightness;
+  scale_ = scale;
+  draw_milliamps_ = DrawMilliamps(full_draw, scale);
+}
+
+uint32_t OutputStage::Pass(const CRGB* frame, uint8_t scale) {
+  uint32_t sums[3] = {};
+  for (int i = 0; i < num_leds(); ++i) {
+    for (int c = 0; c < 3; ++c) {
+      uint8_t value = tables_[c][frame[i].raw[c]];
+      sums[c] += value;
+      leds_[i].raw[c] = scale8(value, scale);
+    }
+  }
+  const PowerModel& model = options_.power_model;
+  return sums[0] * model.red_milliamps + sums[1] * model.green_milliamps +
+         sums[2] * model.blue_milliamps;
+}
+
+uint8_t OutputStage::LimitScale(uint32_t full_draw) const {
+  uint32_t budget = options_.power_budget_milliamps;
+  if (budget == 0 || full_draw == 0) return 255;
+  uint32_t dark_draw = num_leds() * options_.power_model.dark_milliamps;
+  if (budget <= dark_draw) return 0;
+  // scale8(value, scale) is at most value * (scale + 1) / 256.
+  uint64_t factor = uint64_t(budget - dark_draw) * 256 * 255 / full_draw;
+  return factor == 0 ? 0 : std::min<uint64_t>(factor - 1, 255);
+}
+
+uint32_t OutputStage::DrawMilliamps(uint32_t full_draw, uint8_t scale) const {
+  return uint64_t(full_draw) * (scale + 1) / (256 * 255) +
+         num_leds() * options_.power_model.dark_milliamps;
+}
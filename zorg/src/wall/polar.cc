@@ -0,0 +1,111 @@
+#include "wall/polar.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+namespace {
+
+// A vector (dx, dy) is reduced to the first octant: its longest side
+// max(|dx|, |dy|), and the ratio of its shortest side to its longest side, in
+// 256ths. Both the angle and the length are then looked up by ratio.
+struct PolarTables {
+  PolarTables() {
+    for (int side = 1; side < 256; ++side) {
+      reciprocal[side] = 65536 / side;
+    }
+    for (int ratio = 0; ratio <= 256; ++ratio) {
+      double t = ratio / 256.0;
+      atan[ratio] = std::lround(std::atan(t) * 128 / M_PI);
+      hypot[ratio] = std::lround(std::sqrt(2 * (1 + t * t)) * 256);
+    }
+  }
+
+  // 65536 / side.
+  uint32_t reciprocal[256] = {};
+  // Angle of the ratio, up to 32 (an eighth of a turn).
+  uint8_t atan[257];
+  // Length of the vector with a longest side of 1, times sqrt(2), in 8.8 fixed
+  // point.
+  uint16_t hypot[257];
+};
+
+const PolarTables& Tables() {
+  static const PolarTables tables;
+  return tables;
+}
+
+struct Octant {
+  int longest;
+  int ratio;
+};
+
+inline Octant ReduceToOctant(const PolarTables& tables, int abs_dx,
+                             int abs_dy) {
+  int longest = std::max(abs_dx, abs_dy);
+  int shortest = std::min(abs_dx, abs_dy);
+  return {longest, int((shortest * tables.reciprocal[longest] + 128) >> 8)};
+}
+
+inline uint8_t Angle(const PolarTables& tables, int dx, int dy,
+                     const Octant& octant) {
+  // Each reflection back out of the first octant is applied with a mask that is
+  // -1 for the reflection and 0 otherwise, as (angle ^ mask) - mask negates the
+  // angle when mask is -1. The masks depend on each LED's position, so this
+  // avoids a mispredicted branch per LED.
+  int angle = tables.atan[octant.ratio];
+  int steep = -int(std::abs(dy) > std::abs(dx));
+  angle = ((angle ^ steep) - steep) + (steep & 64);
+  int left = dx >> 31;
+  angle = ((angle ^ left) - left) + (left & 128);
+  int down = dy >> 31;
+  return (angle ^ down) - down;
+}
+
+inline uint8_t Radius(const PolarTables& tables, const Octant& octant) {
+  return std::min((octant.longest * tables.hypot[octant.ratio] + 128) >> 8,
+                  255);
+}
+
+}  // namespace
+
+uint8_t PolarAngle(int dx, int dy) {
+  const PolarTables& tables = Tables();
+  return Angle(tables, dx, dy,
+               ReduceToOctant(tables, std::abs(dx), std::abs(dy)));
+}
+
+uint8_t PolarRadius(int dx, int dy) {
+  const PolarTables& tables = Tables();
+  return Radius(tables, ReduceToOctant(tables, std::abs(dx), std::abs(dy)));
+}
+
+void ComputePolarCoordinates(int num_leds, const uint8_t* x, const uint8_t* y,
+                             uint8_t origin_x, uint8_t origin_y,
+                             uint8_t* angle, uint8_t* radius) {
+  const PolarTables& tables = Tables();
+  for (int i = 0; i < num_leds; ++i) {
+    int dx = origin_x - x[i];
+    int dy = origin_y - y[i];
+    Octant octant = ReduceToOctant(tables, std::abs(dx), std::abs(dy));
+    angle[i] = Angle(tables, dx, dy, octant);
+    radius[i] = Radius(tables, octant);
+  }
+}
+
+void PolarCoordinates::Update(int num_leds, const uint8_t* x, const uint8_t* y,
+                              uint8_t origin_x, uint8_t origin_y) {
+  if (x == x_ && y == y_ && origin_x == origin_x_ && origin_y == origin_y_ &&
+      int(angle_.size()) == num_leds) {
+    return;
+  }
+  angle_.resize(num_leds);
+  radius_.resize(num_leds);
+  ComputePolarCoordinates(num_leds, x, y, origin_x, origin_y, angle_.data(),
+                          radius_.data());
+  x_ = x;
+  y_ = y;
+  origin_x_ = origin_x;
+  origin_y_ = origin_y;
+}
@@ -0,0 +1,209 @@
+#include "wall/program.h"
+
+#include <FastLED.h>
+
+#include <array>
+#include <cstring>
+
+namespace {
+
+using Input = PatternProgram::Input;
+
+// sin8(v) for all 256 values of v.
+const std::array<uint8_t, 256>& SinTable() {
+  static const std::array<uint8_t, 256> table = [] {
+    std::array<uint8_t, 256> table;
+    for (int v = 0; v < 256; ++v) {
+      table[v] = sin8(v);
+    }
+    return table;
+  }();
+  return table;
+}
+
+// Calls fn with a function computing op from its two operands. op can't be
+// kConst.
+template <typename Fn>
+void WithOp(ProgramOp op, Fn fn) {
+  const std::array<uint8_t, 256>& sin_table = SinTable();
+  switch (op) {
+    case ProgramOp::kAdd:
+      return fn([](uint8_t a, uint8_t b) -> uint8_t { return a + b; });
+    case ProgramOp::kSub:
+      return fn([](uint8_t a, uint8_t b) -> uint8_t { return a - b; });
+    case ProgramOp::kMul:
+      return fn([](uint8_t a, uint8_t b) -> uint8_t { return a * b; });
+    case ProgramOp::kScale8:
+      return fn([](uint8_t a, uint8_t b) -> uint8_t { return scale8(a, b); });
+    case ProgramOp::kQadd8:
+      return fn([](uint8_t a, uint8_t b) -> uint8_t { return qadd8(a, b); });
+    case ProgramOp::kQsub8:
+      return fn([](uint8_t a, uint8_t b) -> uint8_t { return qsub8(a, b); });
+    case ProgramOp::kSin8:
+      return fn([&](uint8_t a, uint8_t) -> uint8_t { return sin_table[a]; });
+    case ProgramOp::kCos8:
+      // cos8(a) is sin8(a + 64).
+      return fn([&](uint8_t a, uint8_t) -> uint8_t {
+        return sin_table[uint8_t(a + 64)];
+      });
+    case ProgramOp::kConst:
+    case ProgramOp::kNumOps:
+      break;
+  }
+}
+
+// Sets dst[i] to fn(a[i], b[i]) for all LEDs. Operands that are the same for
+// all LEDs are null, and their value is a_scalar or b_scalar.
+template <typename Fn>
+void Apply(Fn fn, const uint8_t* a, uint8_t a_scalar, const uint8_t* b,
+           uint8_t b_scalar, uint8_t* dst, int num_leds) {
+  if (a != nullptr && b != nullptr) {
+    for (int i = 0; i < num_leds; ++i) dst[i] = fn(a[i], b[i]);
+  } else if (a != nullptr) {
+    for (int i = 0; i < num_leds; ++i) dst[i] = fn(a[i], b_scalar);
+  } else {
+    for (int i = 0; i < num_leds; ++i) dst[i] = fn(a_scalar, b[i]);
+  }
+}
+
+bool IsUnary(ProgramOp op) {
+  return op == ProgramOp::kSin8 || op == ProgramOp::kCos8;
+}
+
+}  // namespace
+
+std::optional<PatternProgram> PatternProgram::Parse(const uint8_t* bytes,
+                                                    size_t size) {
+  if (size < 1 || bytes[0] != kVersion || (size - 1) % 3 != 0) {
+    return std::nullopt;
+  }
+  int num_instructions = (size - 1) / 3;
+  if (num_instructions == 0 || num_instructions > kMaxInstructions) {
+    return std::nullopt;
+  }
+  PatternProgram program;
+  program.bytes_.assign(bytes, bytes + size);
+  for (int i = 0; i < num_instructions; ++i) {
+    const uint8_t* encoded = bytes + 1 + 3 * i;
+    if (encoded[0] >= uint8_t(ProgramOp::kNumOps)) return std::nullopt;
+    Instruction instruction{.op = ProgramOp(encoded[0]),
+                            .a = encoded[1],
+                            .b = encoded[2]};
+    // Operands must already be written.
+    int dst = kNumInputs + i;
+    if (instruction.op == ProgramOp::kConst) {
+      if (instruction.b != 0) return std::nullopt;
+    } else if (instruction.a >= dst || instruction.b >= dst) {
+      return std::nullopt;
+    }
+    program.instructions_.push_back(instruction);
+  }
+  return program;
+}
+
+void ProgramRunner::SetProgram(const PatternProgram& program) {
+  program_ = program;
+  variance_[Input::kX] = kPerLed;
+  variance_[Input::kY] = kPerLed;
+  variance_[Input::kAngle] = kPerLed;
+  variance_[Input::kRadius] = kPerLed;
+  variance_[Input::kT] = kPerFrame;
+  variance_[Input::kSpeed] = kPerFrame;
+  const auto& instructions = program.instructions();
+  int num_instructions = instructions.size();
+  for (int i = 0; i < num_instructions; ++i) {
+    const PatternProgram::Instruction& instruction = instructions[i];
+    uint8_t& variance = variance_[PatternProgram::kNumInputs + i];
+    if (instruction.op == ProgramOp::kConst) {
+      variance = 0;
+    } else if (IsUnary(instruction.op)) {
+      variance = variance_[instruction.a];
+    } else {
+      variance = variance_[instruction.a] | variance_[instruction.b];
+    }
+  }
+  prepared_ = false;
+}
+
+void ProgramRunner::SetLEDs(int num_leds, const uint8_t* x, const uint8_t* y,
+                            const uint8_t* angle, const uint8_t* radius) {
+  num_leds_ = num_leds;
+  leds_[Input::kX] = x;
+  leds_[Input::kY] = y;
+  leds_[Input::kAngle] = angle;
+  leds_[Input::kRadius] = radius;
+  prepared_ = false;
+}
+
+void ProgramRunner::Prepare() {
+  int num_registers = program_->num_registers();
+  int num_per_led = 0;
+  for (int r = PatternProgram::kNumInputs; r < num_registers; ++r) {
+    if (variance_[r] & kPerLed) ++num_per_led;
+  }
+  storage_.resize(num_per_led * num_leds_);
+  uint8_t* next = storage_.data();
+  for (int r = PatternProgram::kNumInputs; r < num_registers; ++r) {
+    if (variance_[r] & kPerLed) {
+      outputs_[r] = next;
+      next += num_leds_;
+    } else {
+      outputs_[r] = nullptr;
+    }
+    leds_[r] = outputs_[r];
+  }
+  int num_instructions = program_->instructions().size();
+  for (int i = 0; i < num_instructions; ++i) {
+    if (!(variance_[PatternProgram::kNumInputs + i] & kPerFrame)) Execute(i);
+  }
+  prepared_ = true;
+}
+
+void ProgramRunner::Execute(int i) {
+  const PatternProgram::Instruction& instruction = program_->instructions()[i];
+  int dst = PatternProgram::kNumInputs + i;
+  if (instruction.op == ProgramOp::kConst) {
+    scalars_[dst] = instruction.a;
+    return;
+  }
+  uint8_t a = instruction.a;
+  // Unary ops ignore b, which could be any register.
+  uint8_t b = IsUnary(instruction.op) ? a : instruction.b;
+  if (!(variance_[dst] & kPerLed)) {
+    WithOp(instruction.op,
+           [&](auto fn) { scalars_[dst] = fn(scalars_[a], scalars_[b]); });
+    return;
+  }
+  WithOp(instruction.op, [&](auto fn) {
+    Apply(fn, (variance_[a] & kPerLed) ? leds_[a] : nullptr, scalars_[a],
+          (variance_[b] & kPerLed) ? leds_[b] : nullptr, scalars_[b],
+          outputs_[dst], num_leds_);
+  });
+}
+
+void ProgramRunner::Run(uint8_t t, uint8_t speed, uint8_t* out) {
+  if (!program_.has_value()) {
+    std::memset(out, 0, num_leds_);
+    return;
+  }
+  if (!prepared_) Prepare();
+  scalars_[Input::kT] = t;
+  scalars_[Input::kSpeed] = speed;
+  // The last register isn't read by any instruction, so when it changes every
+  // frame it is written to out directly.
+  int last = program_->num_registers() - 1;
+  uint8_t* last_storage = outputs_[last];
+  bool write_to_out = variance_[last] == (kPerLed | kPerFrame);
+  if (write_to_out) outputs_[last] = out;
+  int num_instructions = program_->instructions().size();
+  for (int i = 0; i < num_instructions; ++i) {
+    if (variance_[PatternProgram::kNumInputs + i] & kPerFrame) Execute(i);
+  }
+  if (write_to_out) {
+    outputs_[last] = last_storage;
+  } else if (variance_[last] & kPerLed) {
+    std::memcpy(out, leds_[last], num_leds_);
+  } else {
+    std::memset(out, scalars_[last], num_leds_);
+  }
+}
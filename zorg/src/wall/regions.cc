@@ -0,0 +1,103 @@
+#include "wall/regions.h"
+
+#include <cstdint>
+#include <vector>
+
+bool InRegion(Region region, uint8_t x, uint8_t y, uint8_t radius) {
+  switch (region) {
+    case Region::kWall:
+      return true;
+    case Region::kHandZone:
+      return radius < 128;
+    case Region::kOutsideHandZone:
+      return radius >= 128;
+    case Region::kTopBand:
+      return y < 64;
+    case Region::kBottomBand:
+      return y >= 192;
+    case Region::kNumRegions:
+      break;
+  }
+  return false;
+}
+
+void LEDRegion::Init(const LEDMapping& mapping, Region region) {
+  leds_.clear();
+  // Index of each LED of the wall in the region, or -1 if it isn't in it.
+  std::vector<int> region_led(mapping.num_leds, -1);
+  for (int i = 0; i < mapping.num_leds; ++i) {
+    if (InRegion(region, mapping.x[i], mapping.y[i], mapping.radius[i])) {
+      region_led[i] = leds_.size();
+      leds_.push_back(i);
+    }
+  }
+
+  x_.clear();
+  y_.clear();
+  angle_.clear();
+  radius_.clear();
+  neighbors_.clear();
+  for (int i = 0; i < num_leds(); ++i) {
+    int led = leds_[i];
+    x_.push_back(mapping.x[led]);
+    y_.push_back(mapping.y[led]);
+    angle_.push_back(mapping.angle[led]);
+    radius_.push_back(mapping.radius[led]);
+    // Neighbors are kept in order, closest first, and the slots left over are
+    // filled with the LED itself, as in the wall's mapping. The neighbors of
+    // the wall are symmetric, and so are the ones kept.
+    int num_neighbors = 0;
+    for (int k = 0; k < LEDMapping::kNumNeighbors; ++k) {
+      int neighbor = mapping.neighbors[led * LEDMapping::kNumNeighbors + k];
+      if (neighbor != led && region_led[neighbor] >= 0) {
+        neighbors_.push_back(region_led[neighbor]);
+        ++num_neighbors;
+      }
+    }
+    neighbors_.insert(neighbors_.end(),
+                      LEDMapping::kNumNeighbors - num_neighbors, i);
+  }
+
+  // Buckets with no LED in the region are dropped.
+  unique_radii_.clear();
+  radius_bucket_starts_.assign(1, 0);
+  radius_bucket_leds_.clear();
+  for (int b = 0; b < mapping.num_radius_buckets; ++b) {
+    for (int j = mapping.radius_bucket_starts[b];
+         j < mapping.radius_bucket_starts[b + 1]; ++j) {
+      int led = region_led[mapping.radius_bucket_leds[j]];
+      if (led >= 0) radius_bucket_leds_.push_back(led);
+    }
+    if (radius_bucket_leds_.size() > radius_bucket_starts_.back()) {
+      unique_radii_.push_back(mapping.unique_radii[b]);
+      radius_bucket_starts_.push_back(radius_bucket_leds_.size());
+    }
+  }
+
+  grid_cell_starts_.assign(1, 0);
+  grid_cell_leds_.clear();
+  for (int c = 0; c < LEDMapping::kNumGridCells; ++c) {
+    for (int j = mapping.grid_cell_starts[c];
+         j < mapping.grid_cell_starts[c + 1]; ++j) {
+      int led = region_led[mapping.grid_cell_leds[j]];
+      if (led >= 0) grid_cell_leds_.push_back(led);
+    }
+    grid_cell_starts_.push_back(grid_cell_leds_.size());
+  }
+
+  mapping_ = LEDMapping{
+      .num_leds = num_leds(),
+      .x = x_.data(),
+      .y = y_.data(),
+      .angle = angle_.data(),
+      .radius = radius_.data(),
+      .origin_x = mapping.origin_x,
+      .origin_y = mapping.origin_y,
+      .num_radius_buckets = int(unique_radii_.size()),
+      .unique_radii = unique_radii_.data(),
+      .radius_bucket_starts = radius_bucket_starts_.data(),
+      .radius_bucket_leds = radius_bucket_leds_.data(),
+      .grid_cell_starts = grid_cell_starts_.data(),
+      .grid_cell_leds = grid_cell_leds_.data(),
+      .neighbors = neighbors_.data()};
+}
@@ -4,6 +4,19 @@
 // master sends it a message, it will connect to it.
 //
 // The wall controller forwards events about the state of the hand.
+//
+// LED frames are rendered and shown in a pipeline: the render task draws frame
+// N+1 into the back buffer on one core while the output task sends frame N to
+// the LEDs on the other core, then the two buffers are swapped. On its way to
+// the LEDs, each frame goes through the output stage, which sets its
+// brightness and color correction, and keeps the wall within its power budget.
+// The LEDs are wired in segments, one per data pin, sent to in parallel (see
+// LEDWallVariant).
+//
+// The same image runs on every wall: the wall variant, with its mapping, wiring
+// and LED chipset, is kept in the preferences and set from the PC. LED mappings
+// uploaded from the PC are written to flash by the upload task, which answers
+// every chunk so the PC can send lost ones again (see MappingUploadStatus).
 #include <Arduino.h>
 #include <FastLED.h>
 #include <Preferences.h>
@@ -11,12 +24,19 @@
 #include <esp_now.h>
 
 #include <ArduinoJson.hpp>
+#include <algorithm>
 #include <vector>
 
+#include "common/clock.h"
 #include "common/common.h"
 #include "common/messages.h"
 #include "wall/animation.h"
+#include "wall/fastled_output_driver.h"
 #include "wall/led_mapper_data.h"
+#include "wall/mapping_store.h"
+#include "wall/output_driver.h"
+#include "wall/output_stage.h"
+#include "wall/program.h"
 
 // The MAC address of the master controller. Set once the master sends a
 // message.
@@ -27,18 +47,64 @@ constexpr uint8_t kHandPin = T6;
 constexpr char kTouchThresholdKey[] = "touch_threshold";
 constexpr uint16_t kDefaultTouchThreshold = 35;
 uint16_t touch_threshold = kDefaultTouchThreshold;
+// The last uploaded pattern program, kept across restarts.
+constexpr char kProgramKey[] = "program";
 float smoothed_touch_value = 50;
 float kDataSmoothingFactor = 0.95;
 bool hand_pressed = false;
 uint16_t touch_p1 = 0;
 uint16_t touch_p2 = 0;
 uint16_t touch_p3 = 0;
-uint16_t current_brightness = 50;
-uint16_t brightness_delta = 1;
+
+// Times the frames, the output stage and the hand debouncing.
+const Clock& system_clock = DefaultClock();
 
 LEDController controller;
 
+// Most current the LEDs may draw from the power supply, in mA, as estimated by
+// OutputStage's power model.
+constexpr uint32_t kPowerBudgetMilliamps = 20000;
+
+// Holds the frame sent to the LEDs.
+OutputStage output_stage;
+
+// Sends the frames of the output stage to the LED segments.
+FastLEDOutputDriver led_driver;
+
+// Given by the render task when a new front buffer is ready to be shown.
+SemaphoreHandle_t frame_ready;
+// Given by the output task when the front buffer has gone through the output
+// stage, and can become the back buffer.
+SemaphoreHandle_t frame_shown;
+
+// The render task runs on the same core as loop(), the output task runs on the
+// other core alongside WiFi.
+constexpr BaseType_t kRenderCore = 1;
+constexpr BaseType_t kOutputCore = 0;
+constexpr uint32_t kTaskStackSize = 8192;
+
 Preferences prefs;
+// The LED mapping uploaded from the PC, if any. Otherwise the wall uses the
+// mapping of its variant.
+MappingStore mapping_store(&prefs);
+// Chunks of a mapping upload, handed over by the ESP-NOW callback to the upload
+// task: erasing and writing flash blocks for a while, too long for the WiFi
+// task the callback runs on.
+struct MappingChunk {
+  uint32_t offset;
+  uint32_t total_size;
+  uint8_t size;
+  uint8_t data[UploadMappingChunkCommand::kMaxChunkSize];
+};
+constexpr int kUploadQueueLength = 4;
+QueueHandle_t upload_queue;
+// Time for the last status of an upload to reach the master before the wall
+// restarts.
+constexpr uint32_t kUploadRestartDelayMillis = 500;
+// The wall variant, see kLEDWallVariants. Walls that were never given one are
+// taken to be actual walls.
+constexpr char kWallVariantKey[] = "wall_variant";
+constexpr char kDefaultWallVariant[] = "actual_wall";
 
 void OnDataSent(const uint8_t *mac_addr, esp_now_send_status_t status) {
   // Debug outgoing data.
@@ -67,8 +133,59 @@ void OnDataReceived(const uint8_t *mac_addr, const uint8_t *data,
         command.transition_duration_millis);
     controller.SetCurrentPattern(command.pattern_id, command.pattern_speed,
                                  command.transition_duration_millis);
+  } else if (doc[kMethod] == SetPatternParamsCommand::kMethodName) {
+    SetPatternParamsCommand command =
+        SetPatternParamsCommand::FromJsonCommand(doc);
+    Serial.printf("Received pattern parameters, transition=%d\n",
+                  command.transition_duration_millis);
+    controller.SetPatternParams(command);
+  } else if (doc[kMethod] == SetLayerCommand::kMethodName) {
+    SetLayerCommand command = SetLayerCommand::FromJsonCommand(doc);
+    Serial.printf("Received layer %d, id=%d, opacity=%d, blend mode=%d\n",
+                  command.layer, command.pattern_id, command.opacity,
+                  int(command.blend_mode));
+    controller.SetLayer(command);
+  } else if (doc[kMethod] == UploadProgramCommand::kMethodName) {
+    UploadProgramCommand command = UploadProgramCommand::FromJsonCommand(doc);
+    std::optional<PatternProgram> program =
+        PatternProgram::Parse(command.program.data(), command.program.size());
+    if (!program.has_value()) {
+      Serial.println("Received an invalid program, ignoring it.");
+      return;
+    }
+    Serial.printf("Received a program of %u instructions.\n",
+                  unsigned(program->instructions().size()));
+    prefs.putBytes(kProgramKey, command.program.data(),
+                   command.program.size());
+    controller.SetProgram(*program);
+  } else if (doc[kMethod] == UploadMappingChunkCommand::kMethodName) {
+    UploadMappingChunkCommand command =
+        UploadMappingChunkCommand::FromJsonCommand(doc);
+    if (command.data.size() > UploadMappingChunkCommand::kMaxChunkSize) {
+      Serial.printf("Dropped the oversized mapping chunk at offset %u.\n",
+                    command.offset);
+      return;
+    }
+    MappingChunk chunk = {.offset = command.offset,
+                          .total_size = command.total_size,
+                          .size = uint8_t(command.data.size())};
+    std::copy(command.data.begin(), command.data.end(), chunk.data);
+    // The PC sends the chunk again if it doesn't hear back.
+    if (xQueueSend(upload_queue, &chunk, 0) != pdTRUE) {
+      Serial.printf("Upload queue full, dropped the chunk at offset %u.\n",
+                    command.offset);
+    }
   } else if (doc[kMethod] == kRestartMethod) {
     ESP.restart();
+  } else if (doc[kMethod] == kSetWallVariantMethod) {
+    const char *name = doc[kParams][kWallVariantParam];
+    if (name == nullptr || FindLEDWallVariant(name) == nullptr) {
+      Serial.println("Received an unknown wall variant, ignoring it.");
+      return;
+    }
+    Serial.printf("Setting the wall variant to %s, restarting.\n", name);
+    prefs.putString(kWallVariantKey, name);
+    ESP.restart();
   } else if (doc[kMethod] == kSetTouchThresholdMethod) {
     uint16_t new_touch_threshold = doc[kParams][kTouchThresholdParam];
     Serial.printf("Setting new touch threshold: %d\n", new_touch_threshold);
@@ -86,10 +203,10 @@ void OnDataReceived(const uint8_t *mac_addr, const uint8_t *data,
   }
 }
 
-void SendHandEvent(const HandEvent &event) {
+void SendToMaster(const ArduinoJson::JsonDocument &doc) {
   // Skip sending if we are not paired with the master yet.
   if (master_address == EmptyMacAddress()) {
-    Serial.println("Can't send event, no master paired.");
+    Serial.println("Can't send message, no master paired.");
     return;
   }
 
@@ -99,14 +216,6 @@ void SendHandEvent(const HandEvent &event) {
     AddPeer(master_address);
   }
 
-  // Send the event.
-  ArduinoJson::JsonDocument doc;
-  doc[kMethod] = kSetHandStateMethod;
-  if (event.type == HandEventType::kPressed) {
-    doc[kParams][kHandStateParam] = kPressed;
-  } else {
-    doc[kParams][kHandStateParam] = kReleased;
-  }
   std::string out;
   ArduinoJson::serializeJson(doc, out);
   esp_err_t result = esp_now_send(
@@ -117,6 +226,124 @@ void SendHandEvent(const HandEvent &event) {
   }
 }
 
+void SendHandEvent(const HandEvent &event) {
+  ArduinoJson::JsonDocument doc;
+  doc[kMethod] = kSetHandStateMethod;
+  if (event.type == HandEventType::kPressed) {
+    doc[kParams][kHandStateParam] = kPressed;
+  } else {
+    doc[kParams][kHandStateParam] = kReleased;
+  }
+  SendToMaster(doc);
+}
+
+// Statistics about the frames rendered and shown are logged once per period.
+constexpr uint32_t kRenderStatsPeriodMillis = 10 * 1000;
+
+// Time the render task may take per frame, leaving some of the 60 frames per
+// second to spare. Longer frames make the controller render less of the next
+// ones.
+constexpr uint32_t kFrameBudgetMicros = 14000;
+
+// Renders frames into the back buffer, and hands them over to the output task.
+void RenderTask(void *) {
+  controller.set_clock(&system_clock);
+  controller.set_frame_budget_micros(kFrameBudgetMicros);
+  uint64_t stats_start_millis = system_clock.NowMillis();
+  uint32_t render_micros = 0;
+  uint32_t num_frames = 0;
+  for (;;) {
+    uint64_t start_micros = system_clock.NowMicros();
+    controller.Update();
+    render_micros += system_clock.NowMicros() - start_micros;
+    ++num_frames;
+    if (system_clock.NowMillis() - stats_start_millis >=
+        kRenderStatsPeriodMillis) {
+      const FrameGovernor::Stats &stats = controller.governor().stats();
+      Serial.printf(
+          "Rendered %u frames, %u us per frame, at quality %d. Quality "
+          "lowered %u times, raised %u times so far.\n",
+          num_frames, render_micros / num_frames,
+          int(controller.governor().quality()), stats.steps_down,
+          stats.steps_up);
+      stats_start_millis = system_clock.NowMillis();
+      render_micros = 0;
+      num_frames = 0;
+    }
+    // Wait for the output task to be done with the front buffer.
+    xSemaphoreTake(frame_shown, portMAX_DELAY);
+    controller.SwapBuffers();
+    xSemaphoreGive(frame_ready);
+  }
+}
+
+// Sends the front buffer to the LEDs, through the output stage.
+void OutputTask(void *) {
+  uint64_t stats_start_millis = system_clock.NowMillis();
+  uint32_t max_draw_milliamps = 0;
+  uint32_t num_limited_frames = 0;
+  for (;;) {
+    xSemaphoreTake(frame_ready, portMAX_DELAY);
+    output_stage.Apply(system_clock.NowMillis(), controller.front_buffer());
+    // The output stage has its own copy of the frame.
+    xSemaphoreGive(frame_shown);
+    led_driver.Show(output_stage.leds());
+
+    max_draw_milliamps =
+        std::max(max_draw_milliamps, output_stage.draw_milliamps());
+    if (output_stage.power_limited()) ++num_limited_frames;
+    if (system_clock.NowMillis() - stats_start_millis >=
+        kRenderStatsPeriodMillis) {
+      Serial.printf("LEDs drew up to %u mA, %u frames power limited.\n",
+                    max_draw_milliamps, num_limited_frames);
+      stats_start_millis = system_clock.NowMillis();
+      max_draw_milliamps = 0;
+      num_limited_frames = 0;
+    }
+  }
+}
+
+// Writes the chunks of mapping uploads to flash, and tells the master how each
+// went. Restarts the wall once an upload is complete.
+void UploadTask(void *) {
+  MappingChunk chunk;
+  for (;;) {
+    xQueueReceive(upload_queue, &chunk, portMAX_DELAY);
+    MappingUploadStatus status = {.offset = chunk.offset};
+    switch (mapping_store.WriteChunk(chunk.offset, chunk.total_size,
+                                     chunk.data, chunk.size)) {
+      case MappingStore::ChunkStatus::kWritten:
+        status.state = MappingUploadStatus::State::kAccepted;
+        break;
+      case MappingStore::ChunkStatus::kOutOfOrder:
+        status.state = MappingUploadStatus::State::kOutOfOrder;
+        break;
+      case MappingStore::ChunkStatus::kFailed:
+        Serial.printf("Failed to write the mapping chunk at offset %u.\n",
+                      chunk.offset);
+        status.state = MappingUploadStatus::State::kFailed;
+        break;
+    }
+    status.next_offset = mapping_store.next_offset();
+    if (status.state == MappingUploadStatus::State::kAccepted &&
+        mapping_store.upload_complete()) {
+      if (mapping_store.FinishUpload()) {
+        status.state = MappingUploadStatus::State::kComplete;
+      } else {
+        Serial.println("Received an invalid LED mapping, ignoring it.");
+        status.state = MappingUploadStatus::State::kFailed;
+        status.next_offset = 0;
+      }
+    }
+    SendToMaster(status.ToJsonCommand());
+    if (status.state == MappingUploadStatus::State::kComplete) {
+      Serial.println("Received a new LED mapping, restarting.");
+      delay(kUploadRestartDelayMillis);
+      ESP.restart();
+    }
+  }
+}
+
 void setup() {
   pinMode(LED_BUILTIN, OUTPUT);
   pinMode(kHandPin, INPUT);
@@ -127,26 +354,42 @@ void setup() {
   InitEspNow();
   Serial.println("Wall MAC address: " + WiFi.macAddress());
 
+  // Before any chunk can be received.
+  upload_queue = xQueueCreate(kUploadQueueLength, sizeof(MappingChunk));
   esp_now_register_send_cb(&OnDataSent);
   esp_now_register_recv_cb(&OnDataReceived);
 
+  prefs.begin("wall_prefs");
+
   // Initialize FastLED.
-  controller.InitLEDs(kNumLeds, coordsX, coordsY, angles, radii);
-#ifdef ACTUAL_WALL
-  FastLED
-      .addLeds<WS2811, 5, BRG>(controller.led_data().data(),
-                               controller.led_data().size())
-      .setCorrection(TypicalLEDStrip);
-#else
-  FastLED
-      .addLeds<NEOPIXEL, 5>(controller.led_data().data(),
-                            controller.led_data().size())
-      .setCorrection(TypicalLEDStrip);
-#endif
-  FastLED.setBrightness(current_brightness);
+  const LEDWallVariant *variant = FindLEDWallVariant(
+      prefs.getString(kWallVariantKey, kDefaultWallVariant).c_str());
+  if (variant == nullptr) variant = FindLEDWallVariant(kDefaultWallVariant);
+  Serial.printf("Wall variant: %s\n", variant->name);
+  std::optional<LEDMapping> mapping = mapping_store.Load();
+  if (mapping.has_value()) {
+    Serial.printf("Using the uploaded LED mapping, %d LEDs.\n",
+                  mapping->num_leds);
+    controller.InitLEDs(*mapping);
+  } else {
+    controller.InitLEDs(variant->mapping);
+  }
+  // The output stage does FastLED's brightness scaling and color correction,
+  // so FastLED sends its frames as they are.
+  output_stage.Init(controller.num_leds(),
+                    {.white_balance = CRGB(TypicalLEDStrip),
+                     .power_budget_milliamps = kPowerBudgetMilliamps});
+  std::vector<LEDSegment> segments =
+      FitSegments(variant->segments, output_stage.num_leds());
+  if (led_driver.Init(segments, variant->chipset)) {
+    Serial.printf("Sending %d LEDs on %d pins, %u us per frame.\n",
+                  output_stage.num_leds(), int(segments.size()),
+                  WireTimeModel().FrameMicros(segments));
+  } else {
+    Serial.println("Can't drive the LED segments, check their pins.");
+  }
   FastLED.setMaxRefreshRate(60, true);
 
-  prefs.begin("wall_prefs");
   if (prefs.isKey(kTouchThresholdKey)) {
     Serial.printf("Touch threshold already set: %d\n",
                   prefs.getUShort(kTouchThresholdKey));
@@ -155,30 +398,39 @@ void setup() {
                   kDefaultTouchThreshold);
   }
   touch_threshold = prefs.getUShort(kTouchThresholdKey, kDefaultTouchThreshold);
-}
-
-void animate() {
-  controller.Update();
 
-  if (current_brightness == 255) {
-    brightness_delta = -1;
-  } else if (current_brightness == 10) {
-    brightness_delta = 1;
+  std::vector<uint8_t> program_bytes(prefs.getBytesLength(kProgramKey));
+  prefs.getBytes(kProgramKey, program_bytes.data(), program_bytes.size());
+  std::optional<PatternProgram> program =
+      PatternProgram::Parse(program_bytes.data(), program_bytes.size());
+  if (program.has_value()) {
+    Serial.println("Loaded the saved program.");
+    controller.SetProgram(*program);
   }
 
-  current_brightness = current_brightness + brightness_delta;
-
-  FastLED.setBrightness(current_brightness);
-  FastLED.show();
+  // Start the LED pipeline. The front buffer starts out shown, so the render
+  // task can swap as soon as its first frame is ready.
+  frame_ready = xSemaphoreCreateBinary();
+  frame_shown = xSemaphoreCreateBinary();
+  xSemaphoreGive(frame_shown);
+  xTaskCreatePinnedToCore(RenderTask, "render", kTaskStackSize, nullptr, 1,
+                          nullptr, kRenderCore);
+  xTaskCreatePinnedToCore(OutputTask, "output", kTaskStackSize, nullptr, 1,
+                          nullptr, kOutputCore);
+
+  // Writes the chunks queued by OnDataReceived().
+  xTaskCreatePinnedToCore(UploadTask, "upload", kTaskStackSize, nullptr, 1,
+                          nullptr, kOutputCore);
 }
 
+// The touch smoothing and glitch detection are tuned for sampling at the frame
+// rate (60 fps), which is what loop() ran at when it also drew the frames.
+constexpr uint32_t kTouchSamplePeriodMillis = 1000 / 60;
 constexpr uint64_t kDebounceDelayMillis = 50;
 uint64_t last_debounce_time_millis = 0;
 bool last_hand_pressed_state = false;
 
 void loop() {
-  animate();
-
   // Read the touch value
   uint16_t touch_value = touchRead(kHandPin);
   float prev_threshold = smoothed_touch_value;
@@ -223,10 +475,11 @@ void loop() {
   }
 
   if (current_hand_pressed_state != last_hand_pressed_state) {
-    last_debounce_time_millis = millis();
+    last_debounce_time_millis = system_clock.NowMillis();
   }
 
-  if ((millis() - last_debounce_time_millis) > kDebounceDelayMillis) {
+  if ((system_clock.NowMillis() - last_debounce_time_millis) >
+      kDebounceDelayMillis) {
     if (current_hand_pressed_state != hand_pressed) {
       hand_pressed = current_hand_pressed_state;
       if (hand_pressed) {
@@ -240,4 +493,7 @@ void loop() {
   }
 
   last_hand_pressed_state = current_hand_pressed_state;
+
+  // Also lets the render task run, it shares this core.
+  delay(kTouchSamplePeriodMillis);
 }
@@ -0,0 +1,390 @@
+#!/usr/bin/env python3
+"""Generates the LED mappings of the walls from the LED Mapper exports.
+
+Each wall variant has an LED Mapper export in tools/led_mapper (the "FastLED"
+code that LED Mapper generates, with the coordsX, coordsY, angles and radii
+arrays). The generated file has the LED positions of every variant as constexpr
+tables in flash, plus the indexes derived from them and the wiring of the
+wall, see LEDWallVariant in include/wall/led_mapper_data.h.
+
+LED Mapper measures the angles and radii of the export from its own center,
+which is not quite the middle of the coordinates. The generator finds that
+center back, as the origin around which the angles computed like
+include/wall/polar.h best match the exported ones, and stores it with the
+mapping: it is the patterns' default origin on that wall.
+
+Run from the zorg directory after changing an export:
+
+  python3 tools/generate_led_mapping.py
+
+With --blob, it generates the binary mapping of a single export instead (see
+include/wall/mapping_blob.h), to upload to a wall from the web page:
+
+  python3 tools/generate_led_mapping.py --blob tools/led_mapper/actual_wall.txt \
+      actual_wall.bin
+"""
+
+import argparse
+import math
+import os
+import re
+import struct
+import sys
+import zlib
+
+# Must match LEDMapping in include/wall/led_mapper_data.h.
+GRID_SIZE = 16
+NUM_NEIGHBORS = 6
+
+# How far from the LED closest to LED Mapper's center to look for the center.
+ORIGIN_SEARCH_RADIUS = 16
+
+# Must match MappingBlobHeader in include/wall/mapping_blob.h.
+BLOB_MAGIC = 0x4d44454c
+BLOB_VERSION = 2
+BLOB_HEADER = "<IBBBBHHBBxxI"
+
+# How the LEDs of a wall are wired: (number of LEDs, data pin) of each segment,
+# in LED order. See LEDSegmentLayout in include/wall/led_mapper_data.h.
+ACTUAL_WALL_SEGMENTS = [(1000, 5)]
+TEST_WALL_SEGMENTS = [(256, 5)]
+
+# The LED chips of the walls. Must match LEDChipset in
+# include/wall/led_mapper_data.h.
+WS2812_GRB = "LEDChipset::kWS2812GRB"
+WS2811_BRG = "LEDChipset::kWS2811BRG"
+
+# (name, description, segments, chipset) of each wall variant. The export of
+# a variant is tools/led_mapper/<name>.txt.
+VARIANTS = [
+    ("actual_wall", "LED Mapper data for the actual 8' wall.",
+     ACTUAL_WALL_SEGMENTS, WS2811_BRG),
+    ("actual_wall_flipped", "LED Mapper data for the actual 8' wall, flipped.",
+     ACTUAL_WALL_SEGMENTS, WS2811_BRG),
+    ("test_wall", "Data for the test LED matrix.", TEST_WALL_SEGMENTS,
+     WS2812_GRB),
+    ("test_wall_flipped", "Data for the test LED matrix, flipped.",
+     TEST_WALL_SEGMENTS, WS2812_GRB),
+]
+
+EXPORT_ARRAYS = ["coordsX", "coordsY", "angles", "radii"]
+
+
+def parse_export(path):
+  """Returns the arrays of an LED Mapper export, by name."""
+  with open(path) as f:
+    text = f.read()
+  arrays = {}
+  for name, values in re.findall(r"(\w+)\s*\[[^\]]*\]\s*=\s*\{([^}]*)\}",
+                                 text):
+    arrays[name] = [int(v) for v in re.findall(r"-?\d+", values)]
+  for name in EXPORT_ARRAYS:
+    if name not in arrays:
+      sys.exit(f"{path}: missing {name}")
+    if len(arrays[name]) != len(arrays["coordsX"]):
+      sys.exit(f"{path}: {name} doesn't have one value per LED")
+    if any(v < 0 or v > 255 for v in arrays[name]):
+      sys.exit(f"{path}: {name} has values out of 0-255")
+  if len(arrays["coordsX"]) > 0xffff:
+    sys.exit(f"{path}: too many LEDs")
+  return arrays
+
+
+def buckets(keys, num_buckets):
+  """Groups the LEDs by key, returns (starts, leds) in CSR form."""
+  counts = [0] * num_buckets
+  for key in keys:
+    counts[key] += 1
+  starts = [0]
+  for count in counts:
+    starts.append(starts[-1] + count)
+  leds = sorted(range(len(keys)), key=lambda i: (keys[i], i))
+  return starts, leds
+
+
+def radius_buckets(radii):
+  """Returns (unique radii, starts, leds), with the LEDs grouped by radius."""
+  unique = sorted(set(radii))
+  bucket = {r: b for b, r in enumerate(unique)}
+  starts, leds = buckets([bucket[r] for r in radii], len(unique))
+  return unique, starts, leds
+
+
+def grid_cells(xs, ys):
+  """Returns (starts, leds), with the LEDs grouped by grid cell."""
+  cell_size = 256 // GRID_SIZE
+  cells = [(y // cell_size) * GRID_SIZE + x // cell_size
+           for x, y in zip(xs, ys)]
+  return buckets(cells, GRID_SIZE * GRID_SIZE)
+
+
+def neighbors(xs, ys):
+  """Returns the neighbors of every LED, NUM_NEIGHBORS per LED.
+
+  Two LEDs are neighbors when each is among the NUM_NEIGHBORS closest LEDs of
+  the other, so the graph is symmetric. The neighbors of an LED are listed
+  closest first, and the remaining slots hold the LED itself.
+  """
+  num_leds = len(xs)
+  closest = []
+  for i in range(num_leds):
+    others = sorted(
+        (j for j in range(num_leds) if j != i),
+        key=lambda j: ((xs[j] - xs[i])**2 + (ys[j] - ys[i])**2, j))
+    closest.append(others[:NUM_NEIGHBORS])
+  result = []
+  for i in range(num_leds):
+    mutual = [j for j in closest[i] if i in closest[j]]
+    result.extend(mutual + [i] * (NUM_NEIGHBORS - len(mutual)))
+  return result
+
+
+def polar_tables():
+  """Returns the (reciprocal, atan, hypot) tables of src/wall/polar.cc."""
+  reciprocal = [0] + [65536 // side for side in range(1, 256)]
+  # std::lround, the values are positive.
+  atan = [math.floor(math.atan(r / 256) * 128 / math.pi + 0.5)
+          for r in range(257)]
+  hypot = [math.floor(math.sqrt(2 * (1 + (r / 256)**2)) * 256 + 0.5)
+           for r in range(257)]
+  return reciprocal, atan, hypot
+
+
+def polar_coordinates(xs, ys, origin):
+  """Returns (angles, radii) of the LEDs around the origin.
+
+  Gives the same values as ComputePolarCoordinates in src/wall/polar.cc.
+  """
+  reciprocal, atan, hypot = polar_tables()
+  angles, radii = [], []
+  for x, y in zip(xs, ys):
+    dx, dy = origin[0] - x, origin[1] - y
+    longest = max(abs(dx), abs(dy))
+    shortest = min(abs(dx), abs(dy))
+    ratio = (shortest * reciprocal[longest] + 128) >> 8
+    # The reflections out of the first octant, as in Angle().
+    angle = atan[ratio]
+    if abs(dy) > abs(dx):
+      angle = 64 - angle
+    if dx < 0:
+      angle = 128 - angle
+    if dy < 0:
+      angle = -angle
+    angles.append(angle & 0xff)
+    radii.append(min((longest * hypot[ratio] + 128) >> 8, 255))
+  return angles, radii
+
+
+def mapper_origin(arrays):
+  """Returns the center LED Mapper measured the angles of an export from.
+
+  That is the origin around which polar_coordinates() gives angles closest to
+  the exported ones, looked for around the LED of smallest exported radius.
+  """
+  xs, ys, angles = arrays["coordsX"], arrays["coordsY"], arrays["angles"]
+  closest = min(range(len(xs)), key=lambda i: arrays["radii"][i])
+  best_error, best_origin = None, None
+  for ox in range(max(0, xs[closest] - ORIGIN_SEARCH_RADIUS),
+                  min(255, xs[closest] + ORIGIN_SEARCH_RADIUS) + 1):
+    for oy in range(max(0, ys[closest] - ORIGIN_SEARCH_RADIUS),
+                    min(255, ys[closest] + ORIGIN_SEARCH_RADIUS) + 1):
+      computed, _ = polar_coordinates(xs, ys, (ox, oy))
+      # Angles wrap around.
+      error = sum(min((a - b) & 0xff, (b - a) & 0xff)
+                  for a, b in zip(computed, angles))
+      if best_error is None or error < best_error:
+        best_error, best_origin = error, (ox, oy)
+  return best_origin
+
+
+def mapping_tables(arrays):
+  """Returns the tables of LEDMapping, by field name."""
+  xs, ys = arrays["coordsX"], arrays["coordsY"]
+  unique_radii, radius_starts, radius_leds = radius_buckets(arrays["radii"])
+  grid_starts, grid_leds = grid_cells(xs, ys)
+  return {
+      "x": xs,
+      "y": ys,
+      "angle": arrays["angles"],
+      "radius": arrays["radii"],
+      "origin": mapper_origin(arrays),
+      "unique_radii": unique_radii,
+      "radius_bucket_starts": radius_starts,
+      "radius_bucket_leds": radius_leds,
+      "grid_cell_starts": grid_starts,
+      "grid_cell_leds": grid_leds,
+      "neighbors": neighbors(xs, ys),
+  }
+
+
+def format_array(type_name, name, size, values):
+  """Formats a constexpr std::array, wrapped at 80 columns."""
+  width = max(len(str(v)) for v in values) + 1
+  per_line = max(1, 76 // (width + 1))
+  declaration = f"constexpr std::array<{type_name}, {size}>"
+  if len(f"{declaration} {name} = {{") <= 80:
+    lines = [f"{declaration} {name} = {{"]
+  else:
+    lines = [declaration, f"    {name} = {{"]
+  for start in range(0, len(values), per_line):
+    chunk = values[start:start + per_line]
+    lines.append("    " +
+                 " ".join(f"{str(v) + ',':<{width}}" for v in chunk).rstrip())
+  lines.append("};")
+  return "\n".join(lines)
+
+
+def format_segments(path, segments, num_leds):
+  """Formats the segments of a variant as a constexpr std::array."""
+  if sum(count for count, _ in segments) != num_leds:
+    sys.exit(f"{path}: the segments don't cover the {num_leds} LEDs")
+  lines = [
+      "constexpr std::array<LEDSegment, kNumSegments> kSegments = {{",
+  ]
+  first_led = 0
+  for count, pin in segments:
+    lines.append(f"    {{.first_led = {first_led}, .num_leds = {count}, "
+                 f".pin = {pin}}},")
+    first_led += count
+  lines.append("}};")
+  return "\n".join(lines)
+
+
+def generate_variant(path, name, description, arrays, segments, chipset):
+  """Formats the tables of a variant, in a namespace named after it."""
+  tables = mapping_tables(arrays)
+  parts = [
+      f"// {description}\n"
+      f"namespace {name} {{",
+      f"constexpr int kNumLeds = {len(tables['x'])};\n"
+      f"constexpr int kNumRadiusBuckets = {len(tables['unique_radii'])};",
+      format_array("uint8_t", "kX", "kNumLeds", tables["x"]),
+      format_array("uint8_t", "kY", "kNumLeds", tables["y"]),
+      format_array("uint8_t", "kAngle", "kNumLeds", tables["angle"]),
+      format_array("uint8_t", "kRadius", "kNumLeds", tables["radius"]),
+      format_array("uint8_t", "kUniqueRadii", "kNumRadiusBuckets",
+                   tables["unique_radii"]),
+      format_array("uint16_t", "kRadiusBucketStarts", "kNumRadiusBuckets + 1",
+                   tables["radius_bucket_starts"]),
+      format_array("uint16_t", "kRadiusBucketLeds", "kNumLeds",
+                   tables["radius_bucket_leds"]),
+      format_array("uint16_t", "kGridCellStarts",
+                   "LEDMapping::kNumGridCells + 1", tables["grid_cell_starts"]),
+      format_array("uint16_t", "kGridCellLeds", "kNumLeds",
+                   tables["grid_cell_leds"]),
+      format_array("uint16_t", "kNeighbors",
+                   "kNumLeds * LEDMapping::kNumNeighbors", tables["neighbors"]),
+      f"constexpr int kNumSegments = {len(segments)};\n" +
+      format_segments(path, segments, len(tables["x"])),
+      VARIANT_FOOTER.format(name=name, origin_x=tables["origin"][0],
+                            origin_y=tables["origin"][1], chipset=chipset),
+  ]
+  return "\n\n".join(parts)
+
+
+def generate_blob(arrays):
+  """Returns the binary mapping of an export."""
+  tables = mapping_tables(arrays)
+  payload = b"".join(
+      struct.pack(f"<{len(tables[name])}H", *tables[name])
+      for name in ["radius_bucket_starts", "radius_bucket_leds",
+                   "grid_cell_starts", "grid_cell_leds", "neighbors"])
+  payload += bytes(tables["x"] + tables["y"] + tables["angle"] +
+                   tables["radius"] + tables["unique_radii"])
+  header = struct.pack(BLOB_HEADER, BLOB_MAGIC, BLOB_VERSION, GRID_SIZE,
+                       NUM_NEIGHBORS, 0, len(tables["x"]),
+                       len(tables["unique_radii"]), *tables["origin"],
+                       zlib.crc32(payload))
+  return header + payload
+
+
+HEADER = """\
+// Generated by tools/generate_led_mapping.py from the LED Mapper exports in
+// tools/led_mapper. Do not edit, edit the exports and run the generator again.
+//
+// Every variant is compiled in, so one image runs on all the walls. The tables
+// are constexpr, so they stay in flash.
+#include "wall/led_mapper_data.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace {
+"""
+
+VARIANT_FOOTER = """\
+constexpr LEDWallVariant kVariant = {{
+    .name = "{name}",
+    .mapping =
+        {{
+            .num_leds = kNumLeds,
+            .x = kX.data(),
+            .y = kY.data(),
+            .angle = kAngle.data(),
+            .radius = kRadius.data(),
+            .origin_x = {origin_x},
+            .origin_y = {origin_y},
+            .num_radius_buckets = kNumRadiusBuckets,
+            .unique_radii = kUniqueRadii.data(),
+            .radius_bucket_starts = kRadiusBucketStarts.data(),
+            .radius_bucket_leds = kRadiusBucketLeds.data(),
+            .grid_cell_starts = kGridCellStarts.data(),
+            .grid_cell_leds = kGridCellLeds.data(),
+            .neighbors = kNeighbors.data(),
+        }},
+    .segments = {{.num_segments = kNumSegments, .segments = kSegments.data()}},
+    .chipset = {chipset},
+}};
+
+}}  // namespace {name}"""
+
+FOOTER = """\
+}}  // namespace
+
+constexpr LEDWallVariant kLEDWallVariants[kNumLEDWallVariants] = {{
+{variants}
+}};
+
+const LEDWallVariant* FindLEDWallVariant(const char* name) {{
+  for (const LEDWallVariant& variant : kLEDWallVariants) {{
+    if (std::strcmp(variant.name, name) == 0) return &variant;
+  }}
+  return nullptr;
+}}
+"""
+
+
+def main():
+  root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+  parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+  parser.add_argument("--exports",
+                      default=os.path.join(root, "tools", "led_mapper"),
+                      help="directory of the LED Mapper exports")
+  parser.add_argument("--output",
+                      default=os.path.join(root, "src", "wall",
+                                           "led_mapper_data.cc"),
+                      help="file to generate")
+  parser.add_argument("--blob", nargs=2, metavar=("EXPORT", "OUTPUT"),
+                      help="generate the binary mapping of one export")
+  args = parser.parse_args()
+
+  if args.blob:
+    export, output = args.blob
+    with open(output, "wb") as f:
+      f.write(generate_blob(parse_export(export)))
+    return
+
+  out = [HEADER]
+  for name, description, segments, chipset in VARIANTS:
+    path = os.path.join(args.exports, f"{name}.txt")
+    out.append(generate_variant(path, name, description, parse_export(path),
+                                segments, chipset) + "\n")
+  out.append(FOOTER.format(variants="\n".join(
+      f"    {name}::kVariant," for name, _, _, _ in VARIANTS)))
+  with open(args.output, "w") as f:
+    f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+  main()